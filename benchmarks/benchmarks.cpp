@@ -0,0 +1,55 @@
+/**
+ * Micro benchmarks of the numerical kernels, build with -DMATH_BENCHMARKS=1 (make benchmark).
+ *
+ * Timings are the best of several repetitions and printed as table.
+ */
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <math/numerics/lin_alg/gemm.h>
+
+/**
+ * @param fun benchmarked function
+ * @param repetitions number of runs
+ * @returns best run time in seconds
+ */
+double bestOf(const std::function<void()>& fun, size_t repetitions) {
+  double best = 1e300;
+  for(size_t r = 0; r < repetitions; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    fun();
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+/**
+ * Crossover of the blocked kernel and a single Strassen-Winograd level, the smallest size for which
+ * Strassen wins is a good choice for strassenCutoff().
+ */
+void benchmarkStrassen() {
+  std::cout << "gemm vs. strassen (seconds)" << std::endl;
+  std::cout << std::setw(8) << "n" << std::setw(14) << "gemm" << std::setw(14) << "strassen" << std::setw(10)
+            << "speedup" << std::endl;
+  size_t crossover = 0;
+  for(size_t n : { 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048 }) {
+    auto A           = Matrix<double>::Random(n, n);
+    auto B           = Matrix<double>::Random(n, n);
+    size_t reps      = n <= 512 ? 5 : 2;
+    double blocked   = bestOf([&]() { gemm(A, B); }, reps);
+    double recursive = bestOf([&]() { strassen(A, B, n); }, reps);
+    double speedup   = blocked / recursive;
+    if(speedup > 1 && crossover == 0) crossover = n;
+    if(speedup <= 1) crossover = 0;
+    std::cout << std::setw(8) << n << std::setw(14) << blocked << std::setw(14) << recursive << std::setw(10)
+              << speedup << std::endl;
+  }
+  std::cout << "suggested strassenCutoff(): " << (crossover ? crossover : strassenCutoff()) << " (current "
+            << strassenCutoff() << ")" << std::endl;
+}
+
+int main() {
+  benchmarkStrassen();
+  return 0;
+}
@@ -78,7 +78,7 @@ test_command() {
   eval "${COMMAND}"
 }
 
-BUILD_OPTIONS_extension="-DCMAKE_BUILD_TYPE=${BUILD_TYPE} -DMATH_SILENCE_WARNING=1 -DMATH_TESTS=${WITH_TESTS} -DMATH_COVERAGE=${WITH_COVERAGE}"
+BUILD_OPTIONS_extension="-DCMAKE_BUILD_TYPE=${BUILD_TYPE} -DMATH_SILENCE_WARNING=1 -DMATH_TESTS=${WITH_TESTS} -DMATH_COVERAGE=${WITH_COVERAGE} -DMATH_BENCHMARKS=${WITH_BENCHMARKS}"
 
 BUILD_OPTIONS="${BUILD_OPTIONS} ${BUILD_OPTIONS_extension}"
 
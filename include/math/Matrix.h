@@ -123,16 +123,16 @@ public:
   /**
    * Conversion constructor to convert Matrix into other type V
    *
+   * Both matrices share the memory layout, the conversion is a single flat (vectorizable) loop.
+   *
    * @param other the matrix to use
    * @returns given matrix casted to type V
    */
   template<typename V>
   Matrix(const Matrix<V>& other) {
     Resize(other.rows(), other.columns(), other.elements());
-    auto index_factor = _columns * _element_size;
-    for(size_t i = 0; i < (_rows * _columns * _element_size); ++i) {
-      _data[i] = static_cast<T>(other(i / (index_factor), i % (index_factor), i % _element_size));
-    }
+    const V* source = other._data;
+    for(size_t i = 0; i < _dataSize; ++i) { _data[i] = static_cast<T>(source[i]); }
 
     this->needsFree = true;
   }
@@ -707,6 +707,10 @@ private:
   size_t _dataSize = 0;
   //!
   bool needsFree = false;
+
+  //! conversion between value types accesses the raw data
+  template<typename V>
+  friend class Matrix;
 };
 
 /**
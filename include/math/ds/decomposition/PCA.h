@@ -1,24 +1,112 @@
 #pragma once
 
+#include "../../numerics/lin_alg/lanczos.h"
 #include "../../numerics/lin_alg/svd.h"
 #include "../Predictor.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+/**
+ * Backend used to compute the principal components
+ */
+enum PCABackend {
+  //! dense (truncated) singular value decomposition, see svd()
+  SVD_BACKEND = 0,
+  //! matrix-free Lanczos on the implicit Gram operator $$X^T X$$, see lanczos()
+  LANCZOS_BACKEND = 1
+};
 
 class PCA : public Transformer
 {
 public:
+  //! principal axes stored column wise, n_features x k
   Matrix<double> PCs;
+  //! principal axes stored row wise (`PCs` transposed), k x n_features
   Matrix<double> right;
+  //! singular values of the fitted data in descending order, k x 1
+  Matrix<double> singular_values;
   int keep_components;
+  PCABackend backend;
 
 public:
-  PCA(int k_components = 0)
+  PCA(int k_components = 0, PCABackend _backend = SVD_BACKEND)
     : Transformer()
-    , keep_components(k_components) { }
+    , keep_components(k_components)
+    , backend(_backend) { }
 
-  void fit(const Matrix<double>& X, const Matrix<double>& y) override {
-    auto res = svd(X, keep_components);
-    PCs      = res[0] * res[1];
-    right    = res[2];
+  void fit(const Matrix<double>& X, [[maybe_unused]] const Matrix<double>& y) override {
+    if(backend == LANCZOS_BACKEND) {
+      fitLanczos(X);
+      return;
+    }
+    fitSVD(X);
   }
+  /**
+   * Projects the data onto the principal axes
+   * @param in data with shape n_samples x n_features
+   * @returns projected data with shape n_samples x k
+   */
   Matrix<double> transform(const Matrix<double>& in) override { return in * PCs; }
+
+private:
+  //! number of components to keep, at most the rank bound min(n_samples, n_features)
+  size_t components(const Matrix<double>& X) const {
+    size_t bound = std::min(X.rows(), X.columns());
+    return keep_components > 0 ? std::min((size_t)keep_components, bound) : bound;
+  }
+
+  /**
+   * Computes the leading right singular vectors of X with a dense decomposition.
+   *
+   * Tall data uses svd(), which works on $$X^T X$$. Otherwise the left singular vectors are
+   * the eigenvectors of the smaller $$X X^T$$ and $$v_i = X^T u_i / \sigma_i$$.
+   *
+   * Sets the same members with the same shapes as fitLanczos().
+   * @param X data with shape n_samples x n_features
+   */
+  void fitSVD(const Matrix<double>& X) {
+    size_t k = components(X);
+    if(X.rows() > X.columns()) {
+      auto res        = svd(X, k);
+      right           = res[2].GetSlice(0, k - 1, 0, X.columns() - 1);
+      singular_values = res[1].GetSlice(0, k - 1, 0, 0);
+      PCs             = right.Transpose();
+      return;
+    }
+
+    auto eig = jacobiEigen(X * X.Transpose());
+    std::vector<size_t> order(X.rows());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return eig.first(a, 0) > eig.first(b, 0); });
+
+    PCs             = Matrix<double>(0.0, X.columns(), k);
+    singular_values = Matrix<double>(0.0, k, 1);
+    auto XT         = X.Transpose();
+    for(size_t i = 0; i < k; ++i) {
+      double sigma          = eig.first(order[i], 0) > 0 ? sqrt(eig.first(order[i], 0)) : 0.0;
+      singular_values(i, 0) = sigma;
+      if(sigma == 0.0) continue;
+      auto v = XT * eig.second.GetSlice(0, X.rows() - 1, order[i], order[i]);
+      for(size_t j = 0; j < X.columns(); ++j) { PCs(j, i) = v(j, 0) / sigma; }
+    }
+    right = PCs.Transpose();
+  }
+
+  /**
+   * Computes the leading right singular vectors of X as eigenvectors of the implicit
+   * operator $$X^T X$$, requires O(n_features * k) memory.
+   *
+   * Sets `PCs` to the principal axes (n_features x k), `right` to their transposed and
+   * `singular_values` to $$\sqrt{\lambda_i}$$.
+   * @param X data with shape n_samples x n_features
+   */
+  void fitLanczos(const Matrix<double>& X) {
+    size_t k = components(X);
+    auto res = lanczos(gramOperator(X), X.columns(), k);
+    PCs      = res.vectors;
+    right    = res.vectors.Transpose();
+
+    singular_values = res.values.Apply([](double val) { return val > 0 ? sqrt(val) : 0.0; });
+  }
 };
@@ -109,6 +109,7 @@
  */
 #pragma once
 
+#include "lin_alg/batched.h"
 #include "lin_alg/newton.h"
 
 
@@ -149,6 +150,9 @@ public:
   /**
    * Approximates newton fractal given by NewtonFractal::fun and NewtonFractal::jac.
    *
+   * All pixels iterate simultaneously, the newton steps of the pixels not yet converged are
+   * computed by a single batchedLUSolve() per iteration.
+   *
    * @returns Classified roots, meaning pixels approximated with same roots hold same values
    */
   Matrix<double> operator()() const {
@@ -156,22 +160,59 @@ public:
     auto x_i = linspace(xMin, xMax, n).Transpose();
     auto y_i = linspace(yMin, yMax, n).Transpose();
 
+    size_t count = n * n;
+    BatchedMatrix<double> x(count, 2, 1);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        x(i * n + j, 0, 0) = x_i(i, 0);
+        x(i * n + j, 1, 0) = y_i(j, 0);
+      }
+    }
+
+    // newton iteration of all pixels, converged pixels leave the active set
+    std::vector<int> iterations(count, 0);
+    std::vector<size_t> active(count);
+    for(size_t s = 0; s < count; ++s) { active[s] = s; }
+    for(int iter = 0; iter < maxIter && !active.empty(); ++iter) {
+      size_t m = active.size();
+      BatchedMatrix<double> xa(m, 2, 1), J(m, 2, 2), F(m, 2, 1);
+      for(size_t a = 0; a < m; ++a) {
+        xa(a, 0, 0) = x(active[a], 0, 0);
+        xa(a, 1, 0) = x(active[a], 1, 0);
+      }
+      jac(xa, J);
+      fun(xa, F);
+      batchedLUSolve(J, F);
+
+      std::vector<size_t> next;
+      for(size_t a = 0; a < m; ++a) {
+        size_t s = active[a];
+        x(s, 0, 0) += F(a, 0, 0);
+        x(s, 1, 0) += F(a, 1, 0);
+        iterations[s] += 1;
+        double r = sqrt(F(a, 0, 0) * F(a, 0, 0) + F(a, 1, 0) * F(a, 1, 0));
+        if(r > tol) next.push_back(s);
+      }
+      active.swap(next);
+    }
+
     auto M = zeros(n, n);
     std::vector<Matrix<double>> roots;
 
     for(size_t i = 0; i < n; ++i) {
       for(size_t j = 0; j < n; ++j) {
-        auto res = newton(fun, jac, { { x_i(i, 0) }, { y_i(j, 0) } }, tol, maxIter);
-        if(res.second == maxIter) {
+        size_t s = i * n + j;
+        if(iterations[s] == maxIter) {
           M(i, j) = 0;
         } else {
+          auto root    = x.Get(s);
           size_t index = 0;
           for(size_t k = 0; k < roots.size(); ++k) {
-            if(norm(res.first - roots[k]) <= tol) { index = k; }
+            if(norm(root - roots[k]) <= tol) { index = k; }
           }
           if(index == 0) {
             index = roots.size();
-            roots.push_back(res.first);
+            roots.push_back(root);
           }
           M(i, j) = (double)index;
         }
@@ -182,7 +223,7 @@ public:
 
 private:
   /**
-   * Newton fractal function
+   * Newton fractal function, evaluated negated for every system of the batch
    *
    * $$
    * \begin{pmatrix}
@@ -190,15 +231,21 @@ private:
    * -x_1^3 + 3x_0^2 \cdot x_1
    * \end{pmatrix}
    * $$
-   * @param x point to evaluate
-   * @returns evaluated value
+   * @param x points to evaluate (2 dimensional)
+   * @param F negated function values
    */
-  static Matrix<double> fun(const Matrix<double>& x) {
-    return Matrix<double>({ { pow(x(0, 0), 3) - 3 * x(0, 0) * x(1, 0) * x(1, 0) - 1 },
-                            { -pow(x(1, 0), 3) + 3 * x(0, 0) * x(0, 0) * x(1, 0) } });
+  static void fun(const BatchedMatrix<double>& x, BatchedMatrix<double>& F) {
+    const double* x0 = x.lane(0, 0);
+    const double* x1 = x.lane(1, 0);
+    double* f0       = F.lane(0, 0);
+    double* f1       = F.lane(1, 0);
+    for(size_t s = 0; s < x.count(); ++s) {
+      f0[s] = -(x0[s] * x0[s] * x0[s] - 3 * x0[s] * x1[s] * x1[s] - 1);
+      f1[s] = -(-x1[s] * x1[s] * x1[s] + 3 * x0[s] * x0[s] * x1[s]);
+    }
   }
   /**
-   * Helper, jacobian matrix of fun
+   * Helper, jacobian matrix of fun for every system of the batch
    *
    * $$
    * \begin{pmatrix}
@@ -206,12 +253,18 @@ private:
    * 6 x_0 x_1 & 3 x_0^2 - 3x_1^2
    * \end{pmatrix}
    * $$
-   * @param x current value (2 dimensional)
-   * @returns 2 by 2 jacobian matrix evaluated in x
+   * @param x current values (2 dimensional)
+   * @param J 2 by 2 jacobian matrices evaluated in x
    */
-  static Matrix<double> jac(const Matrix<double>& x) {
-    return Matrix<double>({ { 3 * (x(0, 0) * x(0, 0) - x(1, 0) * x(1, 0)), -6 * x(0, 0) * x(1, 0) },
-                            { 6 * x(0, 0) * x(1, 0), 3 * x(0, 0) * x(0, 0) - 3 * x(1, 0) * x(1, 0) } });
+  static void jac(const BatchedMatrix<double>& x, BatchedMatrix<double>& J) {
+    const double* x0 = x.lane(0, 0);
+    const double* x1 = x.lane(1, 0);
+    for(size_t s = 0; s < x.count(); ++s) {
+      J.lane(0, 0)[s] = 3 * (x0[s] * x0[s] - x1[s] * x1[s]);
+      J.lane(0, 1)[s] = -6 * x0[s] * x1[s];
+      J.lane(1, 0)[s] = 6 * x0[s] * x1[s];
+      J.lane(1, 1)[s] = 3 * x0[s] * x0[s] - 3 * x1[s] * x1[s];
+    }
   }
 };
 
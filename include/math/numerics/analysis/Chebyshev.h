@@ -0,0 +1,314 @@
+/**
+ * @file Chebyshev.h
+ *
+ * Chebyshev proxy of a smooth function on [a, b]
+ * $$f(x) \approx \sum_{k=0}^{n} c_k T_k(t), \quad t = \frac{2x - a - b}{b - a}$$
+ *
+ * The function is sampled on nested Chebyshev points of the second kind (17, 33, 65, ... points,
+ * previous samples are reused) until the trailing coefficients drop below the tolerance, afterwards
+ * the series is chopped to the smallest degree meeting it. Expensive functions are evaluated only
+ * during construction, the proxy is evaluated by the Clenshaw recurrence in O(n) per point and
+ * differentiated, integrated or searched for roots without further calls of f. The proxy is callable
+ * with a double, hence it can replace f wherever a std::function<double(double)> is expected
+ * (quadrature(), FunctionPlot, ...).
+ *
+ * Usage:
+ * \code
+ * ChebyshevApprox cheb(expensive, 0, 10);   // samples expensive() once
+ * auto y  = cheb(linspace(0, 10, 1000000)); // cheap evaluation of many points
+ * auto df = cheb.derivative();
+ * auto I  = cheb.integrate();               // integral over [0, 10]
+ * auto x0 = cheb.roots();
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/analysis/Chebyshev.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+/**
+ * Adaptive Chebyshev approximation of a function on an interval
+ */
+class ChebyshevApprox
+{
+public:
+  /**
+   * Samples f adaptively until the coefficients converge
+   * @param f function to approximate, called only during construction
+   * @param a left boundary
+   * @param b right boundary
+   * @param TOL tolerance of the coefficients relative to the largest one
+   * @param maxDegree maximum degree of the series
+   */
+  ChebyshevApprox(const std::function<double(double)>& f, double a, double b, double TOL = 1e-14,
+                  size_t maxDegree = 4096)
+    : _a(a)
+    , _b(b) {
+    assert(a < b);
+    // values at cos(pi j / N), j = 0, ..., N
+    size_t N                   = 16;
+    std::vector<double> values = sample(f, N, {});
+    while(true) {
+      _coefficients = coefficientsOf(values);
+      double scale  = 0;
+      for(auto c : _coefficients) { scale = std::max(scale, std::abs(c)); }
+      // a resolved series has a tail of negligible coefficients
+      size_t tail = std::max<size_t>(2, N / 8);
+      double rest = 0;
+      for(size_t k = N + 1 - tail; k <= N; ++k) { rest = std::max(rest, std::abs(_coefficients[k])); }
+      if(rest <= TOL * scale) {
+        chop(TOL * scale);
+        _converged = true;
+        return;
+      }
+      if(2 * N > maxDegree) break;
+      N *= 2;
+      values = sample(f, N, values);
+    }
+    std::cerr << "ChebyshevApprox: no convergence up to degree " << N << std::endl;
+  }
+
+  /**
+   * Proxy with given coefficients
+   * @param coefficients Chebyshev coefficients
+   * @param a left boundary
+   * @param b right boundary
+   */
+  ChebyshevApprox(std::vector<double> coefficients, double a, double b)
+    : _a(a)
+    , _b(b)
+    , _coefficients(std::move(coefficients))
+    , _converged(true) {
+    if(_coefficients.empty()) _coefficients.push_back(0.0);
+  }
+
+  /**
+   * @returns degree of the series
+   */
+  [[nodiscard]] size_t degree() const { return _coefficients.size() - 1; }
+
+  /**
+   * @returns Chebyshev coefficients
+   */
+  [[nodiscard]] const std::vector<double>& coefficients() const { return _coefficients; }
+
+  /**
+   * @returns true if the tolerance was reached during construction
+   */
+  [[nodiscard]] bool converged() const { return _converged; }
+
+  /**
+   * @returns left boundary
+   */
+  [[nodiscard]] double a() const { return _a; }
+
+  /**
+   * @returns right boundary
+   */
+  [[nodiscard]] double b() const { return _b; }
+
+  /**
+   * Evaluates the proxy by the Clenshaw recurrence
+   * @param x point in [a, b]
+   * @returns approximated f(x)
+   */
+  double operator()(double x) const {
+    double t  = (2 * x - _a - _b) / (_b - _a);
+    double t2 = 2 * t, b1 = 0, b2 = 0;
+    for(size_t k = _coefficients.size() - 1; k >= 1; --k) {
+      double bk = _coefficients[k] + t2 * b1 - b2;
+      b2        = b1;
+      b1        = bk;
+    }
+    return _coefficients[0] + t * b1 - b2;
+  }
+
+  /**
+   * Evaluates the proxy elementwise, chunks of points are evaluated in parallel
+   * @param X points in [a, b]
+   * @returns approximated f(X)
+   */
+  Matrix<double> operator()(const Matrix<double>& X) const {
+    Matrix<double> Y(0, X.rows(), X.columns(), X.elements());
+    size_t count = X.rows() * X.columns() * X.elements();
+    if(count == 0) return Y;
+    const double* x = &X(0, 0);
+    double* y       = &Y(0, 0);
+    parallelFor(
+        0,
+        count,
+        [&](size_t begin, size_t end) {
+          for(size_t i = begin; i < end; ++i) { y[i] = (*this)(x[i]); }
+        },
+        std::max<size_t>(64, 16384 / _coefficients.size()));
+    return Y;
+  }
+
+  /**
+   * @returns proxy of f'
+   */
+  [[nodiscard]] ChebyshevApprox derivative() const {
+    size_t n = degree();
+    if(n == 0) return { { 0.0 }, _a, _b };
+    // c'_{k-1} = c'_{k+1} + 2k c_k
+    std::vector<double> d(n + 2, 0.0);
+    for(size_t k = n; k >= 1; --k) { d[k - 1] = d[k + 1] + 2.0 * double(k) * _coefficients[k]; }
+    d[0] *= 0.5;
+    d.resize(n);
+    double scale = 2 / (_b - _a);
+    for(auto& c : d) { c *= scale; }
+    return { d, _a, _b };
+  }
+
+  /**
+   * @returns proxy of the antiderivative F with F(a) = 0
+   */
+  [[nodiscard]] ChebyshevApprox integral() const {
+    size_t n = degree();
+    std::vector<double> C(n + 2, 0.0);
+    auto c = [this, n](size_t k) { return k <= n ? _coefficients[k] : 0.0; };
+    C[1]   = c(0) - c(2) / 2;
+    for(size_t k = 2; k <= n + 1; ++k) { C[k] = (c(k - 1) - c(k + 1)) / (2.0 * k); }
+    double scale = (_b - _a) / 2, atA = 0;
+    for(size_t k = 1; k <= n + 1; ++k) {
+      C[k] *= scale;
+      atA += (k % 2 == 0 ? 1.0 : -1.0) * C[k];
+    }
+    C[0] = -atA;
+    return { C, _a, _b };
+  }
+
+  /**
+   * @returns definite integral of f over [a, b]
+   */
+  [[nodiscard]] double integrate() const {
+    // integral of T_k over [-1, 1] is 2 / (1 - k^2) for even k
+    double sum = 0;
+    for(size_t k = 0; k < _coefficients.size(); k += 2) { sum += _coefficients[k] * 2.0 / (1.0 - double(k * k)); }
+    return sum * (_b - _a) / 2;
+  }
+
+  /**
+   * Roots of the proxy in [a, b], located by sign changes on a grid finer than the degree and refined
+   * by bisection. Roots of even multiplicity without sign change are only found if a grid point hits
+   * them.
+   * @returns sorted roots
+   */
+  [[nodiscard]] std::vector<double> roots() const {
+    std::vector<double> out;
+    size_t M = std::max<size_t>(32, 4 * degree());
+    std::vector<double> x(M + 1);
+    for(size_t j = 0; j <= M; ++j) { x[j] = _a + (_b - _a) * (1 - std::cos(M_PI * double(j) / double(M))) / 2; }
+    x[M] = _b;
+
+    double fl = (*this)(x[0]);
+    for(size_t j = 0; j < M; ++j) {
+      double fr = (*this)(x[j + 1]);
+      if(fl == 0) {
+        out.push_back(x[j]);
+      } else if(fl * fr < 0) {
+        double l = x[j], r = x[j + 1], vl = fl;
+        for(int it = 0; it < 100 && r - l > 4 * std::numeric_limits<double>::epsilon() * std::max(std::abs(l), std::abs(r));
+            ++it) {
+          double m  = 0.5 * (l + r);
+          double vm = (*this)(m);
+          if(vm == 0) {
+            l = r = m;
+            break;
+          }
+          if((vm < 0) == (vl < 0)) {
+            l  = m;
+            vl = vm;
+          } else {
+            r = m;
+          }
+        }
+        out.push_back(0.5 * (l + r));
+      }
+      fl = fr;
+    }
+    if(fl == 0) out.push_back(x[M]);
+    return out;
+  }
+
+private:
+  //! left boundary
+  double _a;
+  //! right boundary
+  double _b;
+  //! Chebyshev coefficients
+  std::vector<double> _coefficients;
+  //! true if the tolerance was reached
+  bool _converged = false;
+
+  /**
+   * Samples f on N + 1 Chebyshev points, reusing the values of the N / 2 + 1 points of the previous level
+   */
+  [[nodiscard]] std::vector<double> sample(const std::function<double(double)>& f, size_t N,
+                                           const std::vector<double>& previous) const {
+    std::vector<double> values(N + 1);
+    for(size_t j = 0; j <= N; ++j) {
+      if(!previous.empty() && j % 2 == 0) {
+        values[j] = previous[j / 2];
+      } else {
+        double t  = std::cos(M_PI * double(j) / double(N));
+        values[j] = f(0.5 * (_a + _b) + 0.5 * (_b - _a) * t);
+      }
+    }
+    return values;
+  }
+
+  /**
+   * Chebyshev coefficients of the interpolant through values at cos(pi j / N) (discrete cosine transform)
+   */
+  static std::vector<double> coefficientsOf(const std::vector<double>& values) {
+    size_t N = values.size() - 1;
+    // cos(pi m / N) for m = 0, ..., 2N - 1, the product j k is reduced modulo 2N
+    std::vector<double> table(2 * N);
+    for(size_t m = 0; m < 2 * N; ++m) { table[m] = std::cos(M_PI * double(m) / double(N)); }
+    std::vector<double> c(N + 1);
+    parallelFor(
+        0,
+        N + 1,
+        [&](size_t begin, size_t end) {
+          for(size_t k = begin; k < end; ++k) {
+            double sum = 0.5 * (values[0] + (k % 2 == 0 ? values[N] : -values[N]));
+            size_t m   = 0;
+            for(size_t j = 1; j < N; ++j) {
+              m += k;
+              if(m >= 2 * N) m -= 2 * N;
+              sum += values[j] * table[m];
+            }
+            c[k] = sum * 2.0 / double(N);
+          }
+        },
+        std::max<size_t>(8, 65536 / (N + 1)));
+    c[0] *= 0.5;
+    c[N] *= 0.5;
+    return c;
+  }
+
+  /**
+   * Drops trailing coefficients below threshold
+   */
+  void chop(double threshold) {
+    while(_coefficients.size() > 1 && std::abs(_coefficients.back()) <= threshold) { _coefficients.pop_back(); }
+  }
+};
+
+/**
+ * \example numerics/analysis/TestChebyshev.cpp
+ * This is an example on how to use the ChebyshevApprox.
+ */
@@ -19,6 +19,9 @@
  *  \frac{f(x+h)-f(x-h)}{2h}
  * $$
  *
+ * The quotients on equidistant grids are also available as stencils (DifferenceStencil) for the
+ * method of lines (see pde/methodOfLines.h).
+ *
  * Usage:
  * \code
  * // create a function
@@ -39,6 +42,9 @@
 #include "../../matrix_utils.h"
 
 #include "../utils.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 /**
  * Computes forward difference quotient
@@ -136,6 +142,78 @@ inline Matrix<double> centralDiff4(const Matrix<double>& x, const Matrix<double>
   return df;
 }
 
+/**
+ * Difference quotient on an equidistant grid as weights of neighbouring values
+ * $$f^{(order)}(x_i) \approx \frac{1}{h^{order}} \sum_k w_k f(x_{i + o_k})$$
+ */
+struct DifferenceStencil {
+  //! offsets o_k of the neighbours
+  std::vector<int> offsets;
+  //! weights w_k
+  std::vector<double> weights;
+  //! order of the approximated derivative
+  size_t order = 1;
+};
+
+/**
+ * @returns stencil of forwardDiff()
+ */
+inline DifferenceStencil forwardStencil() { return { { 0, 1 }, { -1.0, 1.0 }, 1 }; }
+
+/**
+ * @returns stencil of backwardDiff()
+ */
+inline DifferenceStencil backwardStencil() { return { { -1, 0 }, { -1.0, 1.0 }, 1 }; }
+
+/**
+ * @returns stencil of centralDiff()
+ */
+inline DifferenceStencil centralStencil() { return { { -1, 1 }, { -0.5, 0.5 }, 1 }; }
+
+/**
+ * @returns stencil of backwardDiff2()
+ */
+inline DifferenceStencil backwardStencil2() { return { { -2, -1, 0 }, { 0.5, -2.0, 1.5 }, 1 }; }
+
+/**
+ * @returns stencil of centralDiff4()
+ */
+inline DifferenceStencil centralStencil4() {
+  return { { -2, -1, 1, 2 }, { 1.0 / 12.0, -8.0 / 12.0, 8.0 / 12.0, -1.0 / 12.0 }, 1 };
+}
+
+/**
+ * Central difference quotient of the 2nd derivative
+ * $$
+ *  f''(x) = \frac{f(x+h)-2f(x)+f(x-h)}{h^2}
+ * $$
+ * **Error** O(dx^2)
+ * @returns stencil
+ */
+inline DifferenceStencil secondStencil() { return { { -1, 0, 1 }, { 1.0, -2.0, 1.0 }, 2 }; }
+
+/**
+ * Applies a stencil to equidistant support values
+ * @param dx distance of the support values
+ * @param y y-values, one column per function
+ * @param stencil difference quotient
+ * @returns approximated differential evaluated on the x-values, 0 where the stencil exceeds the values
+ */
+inline Matrix<double> stencilDiff(double dx, const Matrix<double>& y, const DifferenceStencil& stencil) {
+  auto df      = zeros(y.rows(), y.columns());
+  double scale = std::pow(dx, -double(stencil.order));
+  int first    = *std::min_element(stencil.offsets.begin(), stencil.offsets.end());
+  int last     = *std::max_element(stencil.offsets.begin(), stencil.offsets.end());
+  for(int i = std::max(0, -first); i + std::max(0, last) < int(y.rows()); ++i) {
+    for(size_t j = 0; j < y.columns(); ++j) {
+      double v = 0;
+      for(size_t k = 0; k < stencil.offsets.size(); ++k) { v += stencil.weights[k] * y(i + stencil.offsets[k], j); }
+      df(i, j) = scale * v;
+    }
+  }
+  return df;
+}
+
 /**
  * \example numerics/analysis/TestDifferentiation.cpp
  * This is an example on how to use the Differentiation file.
@@ -1,102 +1,377 @@
+/**
+ * @file Integration.h
+ *
+ * Numerical quadrature of
+ * $$\int_a^b f(x) dx$$
+ *
+ * - quadGK(): globally adaptive Gauss-Kronrod (G7K15) quadrature. All intervals are kept in a heap
+ *   ordered by their error estimate, the worst interval is bisected until the summed error meets
+ *   max(atol, rtol |I|). Infinite bounds are mapped to finite ones by a change of variables.
+ * - quadTanhSinh(): double exponential quadrature, the nodes cluster at both ends, hence it copes
+ *   with integrable endpoint singularities such as log(x) or 1/sqrt(x) (and infinite bounds).
+ * - quadrature(): adaptive Simpson / trapezoid rule, returns the visited nodes as well.
+ *
+ * The integrand of quadGK() and quadTanhSinh() may be a BatchIntegrand, which gets all nodes of an
+ * evaluation round at once (30 for a bisection in quadGK(), a whole level in quadTanhSinh()), or a
+ * plain std::function<double(double)>. A failure to meet the tolerance is reported in the result
+ * (and to std::cerr), the estimate reached so far is still returned.
+ *
+ * Usage:
+ * \code
+ * auto res = quadGK([](double x) { return std::exp(-x * x); }, -INFINITY, INFINITY); // sqrt(pi)
+ * // vectorized integrand
+ * auto batch = [](const double* x, double* y, size_t n) { for(size_t i = 0; i < n; ++i) y[i] = std::log(x[i]); };
+ * auto sing  = quadTanhSinh(batch, 0, 1); // -1
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/analysis/Integration.h>
+ * \endcode
+ */
 #pragma once
 #include "../../Matrix.h"
-#include "../../sorting.h"
 #include "../utils.h"
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+//! vectorized integrand, writes f(x[i]) to y[i] for the n nodes in x
+using BatchIntegrand = std::function<void(const double* x, double* y, size_t n)>;
+
+/**
+ * Option struct for quadGK() and quadTanhSinh()
+ */
+struct QuadratureOption {
+  //! absolute tolerance of the integral
+  double atol = 1e-10;
+  //! relative tolerance of the integral
+  double rtol = 1e-10;
+  //! maximal number of intervals of quadGK()
+  size_t maxIntervals = 1000;
+  //! maximal number of levels of quadTanhSinh(), the step width is halved per level
+  size_t maxLevels = 10;
+};
+
+/**
+ * Result struct of quadGK() and quadTanhSinh()
+ */
+struct QuadratureResult {
+  //! approximated integral
+  double value = 0;
+  //! estimated absolute error
+  double error = 0;
+  //! number of evaluated nodes
+  size_t evaluations = 0;
+  //! number of intervals (quadGK) or levels (quadTanhSinh)
+  size_t intervals = 0;
+  //! true if the error meets the tolerance
+  bool converged = false;
+};
 
 namespace integration {
+  //! positive Kronrod nodes, the odd ones are the Gauss nodes, the center 0 is a Gauss node as well
+  constexpr double kronrodNodes[7] = { 0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+                                       0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+                                       0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+                                       0.207784955007898467600689403773245 };
+  //! Kronrod weights of kronrodNodes and the center
+  constexpr double kronrodWeights[8] = { 0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+                                         0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+                                         0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+                                         0.204432940075298892414161999234649, 0.209482141084727828012999174891714 };
+  //! Gauss weights of kronrodNodes[1], [3], [5] and the center
+  constexpr double gaussWeights[4] = { 0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+                                       0.381830050505118944950369775488975, 0.417959183673469387755102040816327 };
+
   /**
-   * Recursive implementation of numerical quadrature to approximate a given exact integral
-   * uses Simspon's - and Trapezoid Rule for approximation.
-   *
-   * The Trapezoid Rule is given as
-   *
-   * \begin{equation}
-   *  \int \limits_a^b f(x) dx
-   *  \approx
-   *  T(x) = \frac{b - a}{2}
-   *  \left[
-   *     f(a) + f(b)
-   *  \right]
-   * \end{equation}
-   * Simpson is given as
-   * \begin{equation}
-   *  \int \limits_a^b f(x) dx
-   *  \approx
-   *  S(x) = \frac{
-   *      b - a
-   *  }{
-   *      6
-   *  }
-   *  \left[
-   *      f(a) + 4 f
-   *      \left(
-   *          \frac{a+b}{2}
-   *      \right)
-   *      + f(b)
-   *  \right]
-   * \end{equation}
-   *
-   * For approximation a tolerance is given, which is used to compare against the local error
-   * of approximation. The error is calculated as
-   * $$
-   *  | S - T |
-   * $$
-   * Whenever the error reaches the threshold of tol, the method has succeeded and
-   * the result of Simpson's rule is returned.
-   *
-   * **Note** if (b-a) < hMin we reached the minimal step with and haven't found
-   * an satisfying result, therefore the algorithm exits with error code 1
-   *
-   * @param fun given Function to calculate the exact integral of
-   * @param a left boundary of integral
-   * @param b right boundary of integral
-   * @param tol local tolerance
-   * @param hMin minimum distance between a and b
-   * @param nodes already visited nodes on the integral ("x-axis")
-   * @param values already calculated function values for visited nodes
-   * @returns approximation of given exact integral.
+   * Subinterval of quadGK(), ordered by its error estimate for the max heap of the bisection
    */
-  std::pair<double, std::vector<double>> quad_adaptive_rec(
-  const std::function<double(double)>& fun,
-  const double& a,
-  const double& b,
-  const double& tol,
-  const double& hMin,
-  std::vector<double>& nodes,
-  Matrix<double>& values) {
-    double h = b - a;
-    if(h < hMin) {
-      // error
-      std::cerr << "H too small! h = " << h << std::endl;
-      exit(-1);
+  struct QuadInterval {
+    //! lower bound
+    double a;
+    //! upper bound
+    double b;
+    //! Kronrod estimate of the integral over [a, b]
+    double value;
+    //! error estimate of value
+    double error;
+    bool operator<(const QuadInterval& other) const { return error < other.error; }
+  };
+
+  /**
+   * Writes the 15 Kronrod nodes of [a, b] to x, the center first followed by the pairs c -+ h x_k.
+   */
+  inline void kronrodAbscissas(double a, double b, double* x) {
+    double c = 0.5 * (a + b), h = 0.5 * (b - a);
+    x[0] = c;
+    for(size_t k = 0; k < 7; ++k) {
+      x[1 + 2 * k] = c - h * kronrodNodes[k];
+      x[2 + 2 * k] = c + h * kronrodNodes[k];
     }
+  }
 
-    Matrix<double> x = { { a }, { a + (h / 2.0) }, { b } };
-    if(values.rows() == 0) {
-      values = x.Apply(fun);
-    } else if(values.rows() < 3) {
-      values = { { values(0, 0) }, { fun(x(1, 0)) }, { values(1, 0) } };
+  /**
+   * G7K15 rule on [a, b] with the values y of the nodes of kronrodAbscissas(). The error estimate
+   * |K15 - G7| is scaled as in QUADPACK.
+   *
+   * @param a left bound
+   * @param b right bound
+   * @param y 15 function values
+   * @returns the interval with its Kronrod value and error estimate
+   */
+  inline QuadInterval kronrodRule(double a, double b, const double* y) {
+    double h        = 0.5 * (b - a);
+    double gauss    = gaussWeights[3] * y[0], kronrod = kronrodWeights[7] * y[0];
+    double absolute = std::abs(kronrod);
+    for(size_t k = 0; k < 7; ++k) {
+      double sum = y[1 + 2 * k] + y[2 + 2 * k];
+      kronrod += kronrodWeights[k] * sum;
+      absolute += kronrodWeights[k] * (std::abs(y[1 + 2 * k]) + std::abs(y[2 + 2 * k]));
+      if(k % 2 == 1) { gauss += gaussWeights[k / 2] * sum; }
+    }
+    double mean       = 0.5 * kronrod;
+    double deviations = kronrodWeights[7] * std::abs(y[0] - mean);
+    for(size_t k = 0; k < 7; ++k) {
+      deviations += kronrodWeights[k] * (std::abs(y[1 + 2 * k] - mean) + std::abs(y[2 + 2 * k] - mean));
     }
+    h            = std::abs(h);
+    double error = std::abs((kronrod - gauss) * h);
+    absolute *= h;
+    deviations *= h;
+    if(deviations != 0 && error != 0) { error = deviations * std::min(1.0, std::pow(200 * error / deviations, 1.5)); }
+    double eps = std::numeric_limits<double>::epsilon();
+    if(absolute > std::numeric_limits<double>::min() / (50 * eps)) { error = std::max(50 * eps * absolute, error); }
+    return { a, b, kronrod * 0.5 * (b - a), error };
+  }
 
-    auto qSimpson = (h / 6.0) * (values(2, 0) + 4.0 * values(1, 0) + values(0, 0));
-    auto qTrapez  = (h / 2.0) * (values(2, 0) + values(0, 0));
+  /**
+   * Maps an integral with infinite bounds to a finite one, a and b are replaced by the new bounds
+   * - (-inf, inf): x = t / (1 - t^2), t in (-1, 1)
+   * - [a, inf): x = a + t / (1 - t), t in [0, 1)
+   * - (-inf, b]: x = b - t / (1 - t), t in [0, 1)
+   *
+   * @param f integrand
+   * @param a lower bound, a < b
+   * @param b upper bound
+   * @returns integrand in t including the derivative of the transformation, f if both bounds are finite
+   */
+  inline BatchIntegrand finiteInterval(const BatchIntegrand& f, double& a, double& b) {
+    bool lowerInfinite = std::isinf(a), upperInfinite = std::isinf(b);
+    if(!lowerInfinite && !upperInfinite) { return f; }
+    double origin = lowerInfinite ? b : a;
+    // -1: t / (1 - t^2), 0: origin + t / (1 - t), 1: origin - t / (1 - t)
+    int kind = lowerInfinite && upperInfinite ? -1 : (lowerInfinite ? 1 : 0);
+    a        = kind == -1 ? -1 : 0;
+    b        = 1;
+    std::vector<double> x;
+    return [f, origin, kind, x](const double* t, double* y, size_t n) mutable {
+      x.resize(n);
+      for(size_t i = 0; i < n; ++i) {
+        double s = kind == -1 ? 1 - t[i] * t[i] : 1 - t[i];
+        x[i]     = kind == -1 ? t[i] / s : (kind == 0 ? origin + t[i] / s : origin - t[i] / s);
+      }
+      f(x.data(), y, n);
+      for(size_t i = 0; i < n; ++i) {
+        if(y[i] == 0) { continue; }
+        double s = kind == -1 ? 1 - t[i] * t[i] : 1 - t[i];
+        y[i] *= kind == -1 ? (1 + t[i] * t[i]) / (s * s) : 1 / (s * s);
+      }
+    };
+  }
 
-    auto error = fabs(qSimpson - qTrapez);
+  /**
+   * Wraps a scalar integrand into a BatchIntegrand.
+   */
+  inline BatchIntegrand batch(const std::function<double(double)>& f) {
+    return [f](const double* x, double* y, size_t n) {
+      for(size_t i = 0; i < n; ++i) { y[i] = f(x[i]); }
+    };
+  }
+} // namespace integration
 
-    nodes.push_back(x(1, 0));
+/**
+ * Globally adaptive Gauss-Kronrod quadrature of
+ * $$\int_a^b f(x) dx$$
+ *
+ * The intervals are kept in a heap ordered by their G7K15 error estimate. The worst interval is
+ * bisected and the 30 nodes of both halves are evaluated by one call of f, until the summed error
+ * meets max(atol, rtol |I|) or option.maxIntervals is reached. Infinite bounds are supported.
+ *
+ * @param f vectorized integrand
+ * @param a lower bound (may be -INFINITY)
+ * @param b upper bound (may be INFINITY)
+ * @param option tolerances and maximal number of intervals
+ * @returns integral, error estimate and statistics
+ */
+inline QuadratureResult quadGK(const BatchIntegrand& f, double a, double b, const QuadratureOption& option = {}) {
+  QuadratureResult result;
+  if(a == b) {
+    result.converged = true;
+    return result;
+  }
+  if(a > b) {
+    result       = quadGK(f, b, a, option);
+    result.value = -result.value;
+    return result;
+  }
+  auto g = integration::finiteInterval(f, a, b);
+  std::vector<double> x(30), y(30);
+  integration::kronrodAbscissas(a, b, x.data());
+  g(x.data(), y.data(), 15);
+  result.evaluations = 15;
 
-    if(error <= tol) { return { qSimpson, nodes }; }
+  std::vector<integration::QuadInterval> heap = { integration::kronrodRule(a, b, y.data()) };
+  heap.reserve(option.maxIntervals + 1);
+  result.value = heap[0].value;
+  result.error = heap[0].error;
+  while(result.error > std::max(option.atol, option.rtol * std::abs(result.value))) {
+    if(!std::isfinite(result.value)) {
+      std::cerr << "quadGK: non finite integrand value" << std::endl;
+      break;
+    }
+    if(heap.size() >= option.maxIntervals) {
+      std::cerr << "quadGK: maximal number of intervals reached, error estimate " << result.error << std::endl;
+      break;
+    }
+    std::pop_heap(heap.begin(), heap.end());
+    auto worst = heap.back();
+    double m   = 0.5 * (worst.a + worst.b);
+    if(m <= worst.a || m >= worst.b) {
+      std::push_heap(heap.begin(), heap.end());
+      std::cerr << "quadGK: interval too small at x = " << m << ", error estimate " << result.error << std::endl;
+      break;
+    }
+    integration::kronrodAbscissas(worst.a, m, x.data());
+    integration::kronrodAbscissas(m, worst.b, x.data() + 15);
+    g(x.data(), y.data(), 30);
+    result.evaluations += 30;
+    heap.back() = integration::kronrodRule(worst.a, m, y.data());
+    std::push_heap(heap.begin(), heap.end());
+    heap.push_back(integration::kronrodRule(m, worst.b, y.data() + 15));
+    std::push_heap(heap.begin(), heap.end());
 
-    auto hTol        = tol / 2.0;
-    auto leftValues  = values.GetSlice(0, 1, 0, 0);
-    auto resLeft     = quad_adaptive_rec(fun, a, x(1, 0), hTol, hMin, nodes, leftValues);
-    auto rightValues = values.GetSlice(1, 2, 0, 0);
-    auto resRight    = quad_adaptive_rec(fun, x(1, 0), b, hTol, hMin, nodes, rightValues);
+    // summing up avoids the cancellation of updating the totals
+    result.value = 0;
+    result.error = 0;
+    for(const auto& interval : heap) {
+      result.value += interval.value;
+      result.error += interval.error;
+    }
+  }
+  result.intervals = heap.size();
+  result.converged = std::isfinite(result.value)
+                     && result.error <= std::max(option.atol, option.rtol * std::abs(result.value));
+  return result;
+}
 
-    return { resLeft.first + resRight.first, nodes };
+/**
+ * quadGK() of a scalar integrand.
+ */
+inline QuadratureResult quadGK(const std::function<double(double)>& f, double a, double b,
+                               const QuadratureOption& option = {}) {
+  return quadGK(integration::batch(f), a, b, option);
+}
+
+/**
+ * Tanh-sinh (double exponential) quadrature of
+ * $$\int_a^b f(x) dx, \quad x = c + d \tanh\left(\frac{\pi}{2} \sinh t\right)$$
+ *
+ * The trapezoid rule in t converges double exponentially even for integrable singularities at a
+ * or b, since the weights vanish faster than f grows. f is never evaluated at the bounds. Level k
+ * halves the step width to 2^-k and evaluates only the new nodes (one call of f per level), the
+ * error is estimated by the difference of two levels. Infinite bounds are supported. Nodes closer
+ * to a bound than its floating point spacing are dropped, hence a singularity at a bound b != 0
+ * is resolved only up to about eps |b| (shift it to 0 for full accuracy).
+ *
+ * @param f vectorized integrand
+ * @param a lower bound (may be -INFINITY)
+ * @param b upper bound (may be INFINITY)
+ * @param option tolerances and maximal number of levels
+ * @returns integral, error estimate and statistics
+ */
+inline QuadratureResult quadTanhSinh(const BatchIntegrand& f, double a, double b, const QuadratureOption& option = {}) {
+  QuadratureResult result;
+  if(a == b) {
+    result.converged = true;
+    return result;
   }
-} // namespace integration
+  if(a > b) {
+    result       = quadTanhSinh(f, b, a, option);
+    result.value = -result.value;
+    return result;
+  }
+  auto g   = integration::finiteInterval(f, a, b);
+  double c = 0.5 * (a + b), d = 0.5 * (b - a);
+  // beyond tMax the distance to the bounds underflows
+  const double tMax = 6.5;
+  std::vector<double> x, w, y;
+
+  // appends the nodes +-t to x and their weights to w
+  auto addNodes = [&](double t) {
+    double u     = M_PI_2 * std::sinh(t);
+    double delta = std::exp(-u) / std::cosh(u); // 1 - tanh(u)
+    double wt    = d * M_PI_2 * std::cosh(t) * delta * (2 - delta);
+    double lower = a + d * delta, upper = b - d * delta;
+    if(lower > a && lower < b) {
+      x.push_back(lower);
+      w.push_back(wt);
+    }
+    if(upper > a && upper < b) {
+      x.push_back(upper);
+      w.push_back(wt);
+    }
+  };
+
+  double sum = 0, previous = 0, h = 1;
+  for(size_t level = 0; level <= option.maxLevels; ++level) {
+    x.clear();
+    w.clear();
+    if(level == 0) {
+      x.push_back(c);
+      w.push_back(d * M_PI_2);
+      for(double t = 1; t <= tMax; t += 1) { addNodes(t); }
+    } else {
+      h *= 0.5;
+      for(double t = h; t <= tMax; t += 2 * h) { addNodes(t); }
+    }
+    y.resize(x.size());
+    g(x.data(), y.data(), x.size());
+    result.evaluations += x.size();
+    double add = 0;
+    for(size_t i = 0; i < x.size(); ++i) { add += w[i] * y[i]; }
+    previous         = sum;
+    sum              = level == 0 ? add : 0.5 * sum + h * add;
+    result.value     = sum;
+    result.intervals = level + 1;
+    if(!std::isfinite(sum)) {
+      std::cerr << "quadTanhSinh: non finite integrand value" << std::endl;
+      break;
+    }
+    if(level > 0) {
+      result.error = std::abs(sum - previous);
+      if(result.error <= std::max(option.atol, option.rtol * std::abs(sum))) {
+        result.converged = true;
+        break;
+      }
+    }
+  }
+  if(!result.converged && std::isfinite(sum)) {
+    std::cerr << "quadTanhSinh: maximal number of levels reached, error estimate " << result.error << std::endl;
+  }
+  return result;
+}
+
+/**
+ * quadTanhSinh() of a scalar integrand.
+ */
+inline QuadratureResult quadTanhSinh(const std::function<double(double)>& f, double a, double b,
+                                     const QuadratureOption& option = {}) {
+  return quadTanhSinh(integration::batch(f), a, b, option);
+}
 
 /**
  * Calculates the given exact integral
@@ -106,27 +381,59 @@ namespace integration {
  * \end{equation}
  * where $l$ := lower boundary, and $u$ := upper boundary
  *
+ * by the adaptive Simpson rule. An interval is accepted, if the difference of Simpson's rule
+ * $$S = \frac{b - a}{6} \left[ f(a) + 4 f\left(\frac{a+b}{2}\right) + f(b) \right]$$
+ * and the trapezoid rule $T = \frac{b - a}{2} [f(a) + f(b)]$ is at most its tolerance, otherwise
+ * it is bisected and both halves get half the tolerance. The intervals are processed with an
+ * explicit stack, every node is evaluated once.
+ *
+ * **Note** intervals shorter than hMin are accepted without meeting the tolerance, this is
+ * reported to std::cerr.
  *
  * @param fun Function to calculate exact integral of
  * @param lower lower boundary of integral
  * @param upper upper boundary of integral
  * @param tol tolerance of result to exact solution
  * @param hMin minimal distance between approximation points
- * @returns approximated exact integral of fun
+ * @returns approximated exact integral of fun and the sorted visited nodes
  */
-std::pair<double, std::vector<double>> quadrature(
+inline std::pair<double, std::vector<double>> quadrature(
 const std::function<double(double)>& fun,
 const double& lower,
 const double& upper,
 const double& tol,
 const double& hMin) {
-  std::vector<double> nodes = { lower, upper };
-  Matrix<double> q;
-  auto res   = integration::quad_adaptive_rec(fun, lower, upper, tol, hMin, nodes, q);
-  res.second = sort(res.second);
-  return res;
+  struct Segment {
+    double a, b, fa, fb, tol;
+  };
+  std::vector<double> nodes    = { lower, upper };
+  std::vector<Segment> pending = { { lower, upper, fun(lower), fun(upper), tol } };
+  double sum                   = 0;
+  bool tooSmall                = false;
+  while(!pending.empty()) {
+    Segment s = pending.back();
+    pending.pop_back();
+    double h  = s.b - s.a;
+    double m  = s.a + h / 2.0;
+    double fm = fun(m);
+    nodes.push_back(m);
+
+    double qSimpson = (h / 6.0) * (s.fa + 4.0 * fm + s.fb);
+    double qTrapez  = (h / 2.0) * (s.fa + s.fb);
+    if(std::abs(qSimpson - qTrapez) <= s.tol || h < hMin) {
+      tooSmall = tooSmall || std::abs(qSimpson - qTrapez) > s.tol;
+      sum += qSimpson;
+      continue;
+    }
+    // the left half is processed first
+    pending.push_back({ m, s.b, fm, s.fb, s.tol / 2.0 });
+    pending.push_back({ s.a, m, s.fa, fm, s.tol / 2.0 });
+  }
+  if(tooSmall) { std::cerr << "quadrature: minimal step width " << hMin << " reached, tolerance not met" << std::endl; }
+  std::sort(nodes.begin(), nodes.end());
+  return { sum, nodes };
 }
 /**
  * \example numerics/analysis/TestIntegration.cpp
- * This is an example on how to use the quadrature method.
+ * This is an example on how to use the quadrature methods.
  */
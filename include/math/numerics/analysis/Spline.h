@@ -10,7 +10,9 @@
 
 #include "../../Matrix.h"
 #include "../../matrix_utils.h"
-#include "../lin_alg/gaussSeidel.h"
+#include "../lin_alg/BandedMatrix.h"
+#include <algorithm>
+#include <vector>
 #include "../utils.h"
 
 /**
@@ -86,9 +88,9 @@ public:
   Matrix<double> curv(double h) {
     auto mi  = zeros(XI.rows(), XI.columns());
     auto dim = XI.rows() - 2;
-    auto rhs = 6.0 / (h * h) * (tridiag(dim, dim, 1, -2, 1) * YI.GetSlice(1, YI.rows() - 2, 0, YI.columns() - 1));
-    auto lhs = tridiag(dim, dim, 1, 4, 1);
-    auto res = gaussSeidel(lhs, rhs);
+    auto rhs = 6.0 / (h * h) * (BandedMatrix<double>::Tridiag(dim, 1, -2, 1) * YI.GetSlice(1, YI.rows() - 2, 0, YI.columns() - 1));
+    // tridiag(1, 4, 1) is strictly diagonally dominant, no pivoting required
+    auto res = thomas(BandedMatrix<double>::Tridiag(dim, 1, 4, 1), rhs);
     for(size_t i = 0; i < res.rows(); ++i) { mi(i + 1, 0) = res(i, 0); }
     return mi;
   }
@@ -134,15 +136,36 @@ public:
     auto innerXI = xi.rows() > xi.columns() ? xi : xi.Transpose();
     auto mi      = curv(XI(1, 0) - XI(0, 0));
     auto y       = zeros(innerXI.rows(), innerXI.columns());
-    // Elementwise evaluate splines, for all
-    // elements xi with i = 0, ..., n-1
-    for(size_t j = 0; j < XI.rows() - 1; ++j) {
-      // all elements x, between x_j and x_{j+1}
-      auto xl  = XI(j, 0);
-      auto xr  = XI(j + 1, 0);
-      auto ind = nonzero([xl, xr](const double& x) { return bool((xl <= x) && (x <= xr)); }, innerXI).Transpose();
-      // evaluate using the j-th spline
-      for(size_t i = 0; i < ind.rows(); ++i) { y(ind(i, 0), 0) += eval_spline_j(innerXI(ind(i, 0), 0), j, mi); }
+    size_t knots = XI.rows();
+
+    bool isAscending = true;
+    for(size_t j = 0; j + 1 < knots; ++j) {
+      if(XI(j + 1, 0) < XI(j, 0)) { isAscending = false; }
+    }
+    if(!isAscending) {
+      // Elementwise evaluate splines, for all
+      // elements xi with i = 0, ..., n-1
+      for(size_t j = 0; j < knots - 1; ++j) {
+        // all elements x, between x_j and x_{j+1}
+        auto xl  = XI(j, 0);
+        auto xr  = XI(j + 1, 0);
+        auto ind = nonzero([xl, xr](const double& x) { return bool((xl <= x) && (x <= xr)); }, innerXI).Transpose();
+        // evaluate using the j-th spline
+        for(size_t i = 0; i < ind.rows(); ++i) { y(ind(i, 0), 0) += eval_spline_j(innerXI(ind(i, 0), 0), j, mi); }
+      }
+      return y;
+    }
+
+    // sorted knots: locate the intervals [x_j, x_{j+1}] containing x by binary search, O(n log m).
+    // Points on a knot lie in both adjacent intervals and receive both contributions.
+    std::vector<double> knotValues(knots);
+    for(size_t j = 0; j < knots; ++j) { knotValues[j] = XI(j, 0); }
+    for(size_t i = 0; i < innerXI.rows(); ++i) {
+      double x = innerXI(i, 0);
+      auto j   = size_t(std::lower_bound(knotValues.begin() + 1, knotValues.end(), x) - (knotValues.begin() + 1));
+      for(; j + 1 < knots && XI(j, 0) <= x; ++j) {
+        if(x <= XI(j + 1, 0)) { y(i, 0) += eval_spline_j(x, j, mi); }
+      }
     }
     return y;
   }
@@ -0,0 +1,288 @@
+/**
+ * @file autodiff.h
+ *
+ * Forward mode automatic differentiation.
+ *
+ * Dual<N> carries a value and N directional derivatives, all arithmetic operators and the common
+ * elementary functions propagate them exactly. Functions written generically in the scalar type
+ * (e.g. as generic lambda) can be evaluated on Matrix<Dual<N>>, autodiffJacobian() seeds N columns
+ * of the identity per evaluation, hence a jacobian with up to N columns costs a single evaluation.
+ *
+ * Elementary functions have to be called unqualified (`sin(x)`, not `std::sin(x)`) to be found for
+ * Dual arguments.
+ *
+ * Usage:
+ * \code
+ * auto f = [](const auto& x) {
+ *   auto out = x;
+ *   out(0, 0) = x(0, 0) * x(1, 0) - 1;
+ *   out(1, 0) = sin(x(0, 0)) + x(1, 0);
+ *   return out;
+ * };
+ * auto J = autodiffJacobian(f, x);               // exact jacobian in x
+ * auto res = newton(f, autodiffJacobian(f), x0, 1e-12, 50);
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/autodiff.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../Matrix.h"
+#include <array>
+#include <cmath>
+#include <functional>
+#include <ostream>
+
+/**
+ * Dual number with N derivative directions
+ * @tparam N number of directional derivatives
+ */
+template<size_t N>
+class Dual
+{
+public:
+  //! function value
+  double value = 0;
+  //! directional derivatives
+  std::array<double, N> grad{};
+
+  /**
+   * Constant, all derivatives are zero
+   * @param v value
+   */
+  Dual(double v = 0)
+    : value(v) { }
+
+  /**
+   * Independent variable, seeds derivative direction i
+   * @param v value
+   * @param i seeded direction
+   */
+  Dual(double v, size_t i)
+    : value(v) {
+    grad[i] = 1.0;
+  }
+
+  /**
+   * addition assignment
+   * @param o summand
+   * @returns reference to this
+   */
+  Dual& operator+=(const Dual& o) {
+    value += o.value;
+    for(size_t i = 0; i < N; ++i) { grad[i] += o.grad[i]; }
+    return *this;
+  }
+  /**
+   * subtraction assignment
+   * @param o subtrahend
+   * @returns reference to this
+   */
+  Dual& operator-=(const Dual& o) {
+    value -= o.value;
+    for(size_t i = 0; i < N; ++i) { grad[i] -= o.grad[i]; }
+    return *this;
+  }
+  /**
+   * multiplication assignment
+   * @param o factor
+   * @returns reference to this
+   */
+  Dual& operator*=(const Dual& o) {
+    for(size_t i = 0; i < N; ++i) { grad[i] = grad[i] * o.value + value * o.grad[i]; }
+    value *= o.value;
+    return *this;
+  }
+  /**
+   * division assignment
+   * @param o divisor
+   * @returns reference to this
+   */
+  Dual& operator/=(const Dual& o) {
+    double inv = 1.0 / o.value;
+    value *= inv;
+    for(size_t i = 0; i < N; ++i) { grad[i] = (grad[i] - value * o.grad[i]) * inv; }
+    return *this;
+  }
+
+  //! negation
+  friend Dual operator-(Dual a) {
+    a.value = -a.value;
+    for(auto& g : a.grad) { g = -g; }
+    return a;
+  }
+  //! unary plus
+  friend Dual operator+(const Dual& a) { return a; }
+  //! sum
+  friend Dual operator+(Dual a, const Dual& b) { return a += b; }
+  //! difference
+  friend Dual operator-(Dual a, const Dual& b) { return a -= b; }
+  //! product
+  friend Dual operator*(Dual a, const Dual& b) { return a *= b; }
+  //! quotient
+  friend Dual operator/(Dual a, const Dual& b) { return a /= b; }
+
+  //! comparison of the values
+  friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+  //! comparison of the values
+  friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+  //! comparison of the values
+  friend bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+  //! comparison of the values
+  friend bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+  //! comparison of the values
+  friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+  //! comparison of the values
+  friend bool operator!=(const Dual& a, const Dual& b) { return a.value != b.value; }
+
+  //! prints the value
+  friend std::ostream& operator<<(std::ostream& ostr, const Dual& a) { return ostr << a.value; }
+
+  /**
+   * Chain rule helper
+   * @param a inner function
+   * @param f outer value f(a)
+   * @param df outer derivative f'(a)
+   * @returns f(a) with derivatives f'(a) * a'
+   */
+  static Dual chain(const Dual& a, double f, double df) {
+    Dual out(f);
+    for(size_t i = 0; i < N; ++i) { out.grad[i] = df * a.grad[i]; }
+    return out;
+  }
+};
+
+//! sine
+template<size_t N>
+Dual<N> sin(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::sin(a.value), std::cos(a.value));
+}
+//! cosine
+template<size_t N>
+Dual<N> cos(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::cos(a.value), -std::sin(a.value));
+}
+//! tangent
+template<size_t N>
+Dual<N> tan(const Dual<N>& a) {
+  double t = std::tan(a.value);
+  return Dual<N>::chain(a, t, 1 + t * t);
+}
+//! arc tangent
+template<size_t N>
+Dual<N> atan(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::atan(a.value), 1 / (1 + a.value * a.value));
+}
+//! exponential function
+template<size_t N>
+Dual<N> exp(const Dual<N>& a) {
+  double e = std::exp(a.value);
+  return Dual<N>::chain(a, e, e);
+}
+//! natural logarithm
+template<size_t N>
+Dual<N> log(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::log(a.value), 1 / a.value);
+}
+//! square root
+template<size_t N>
+Dual<N> sqrt(const Dual<N>& a) {
+  double s = std::sqrt(a.value);
+  return Dual<N>::chain(a, s, 0.5 / s);
+}
+//! hyperbolic sine
+template<size_t N>
+Dual<N> sinh(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::sinh(a.value), std::cosh(a.value));
+}
+//! hyperbolic cosine
+template<size_t N>
+Dual<N> cosh(const Dual<N>& a) {
+  return Dual<N>::chain(a, std::cosh(a.value), std::sinh(a.value));
+}
+//! hyperbolic tangent
+template<size_t N>
+Dual<N> tanh(const Dual<N>& a) {
+  double t = std::tanh(a.value);
+  return Dual<N>::chain(a, t, 1 - t * t);
+}
+//! absolute value
+template<size_t N>
+Dual<N> abs(const Dual<N>& a) {
+  return a.value < 0 ? -a : a;
+}
+//! absolute value
+template<size_t N>
+Dual<N> fabs(const Dual<N>& a) {
+  return abs(a);
+}
+//! power with constant exponent
+template<size_t N>
+Dual<N> pow(const Dual<N>& a, double p) {
+  return Dual<N>::chain(a, std::pow(a.value, p), p * std::pow(a.value, p - 1));
+}
+//! power with variable exponent, requires a positive base
+template<size_t N>
+Dual<N> pow(const Dual<N>& a, const Dual<N>& p) {
+  return exp(p * log(a));
+}
+
+/**
+ * Exact jacobian of a vector valued function by forward mode automatic differentiation.
+ *
+ * The columns are processed in chunks of N, every chunk requires one evaluation of f.
+ *
+ * @tparam N number of derivative directions per evaluation
+ * @param f function generic in the scalar type, maps a column vector Matrix<T> to a column vector Matrix<T>
+ * @param x point of evaluation
+ * @returns jacobian of f in x
+ */
+template<size_t N = 8, typename Function>
+Matrix<double> autodiffJacobian(const Function& f, const Matrix<double>& x) {
+  size_t n = x.rows();
+  Matrix<double> J;
+  Matrix<Dual<N>> xd(Dual<N>(), n, 1);
+  for(size_t c0 = 0; c0 < n; c0 += N) {
+    for(size_t i = 0; i < n; ++i) {
+      xd(i, 0) = (i >= c0 && i < c0 + N) ? Dual<N>(x(i, 0), i - c0) : Dual<N>(x(i, 0));
+    }
+    auto fd = f(xd);
+    if(c0 == 0) J = Matrix<double>(0, fd.rows(), n);
+    for(size_t r = 0; r < fd.rows(); ++r) {
+      for(size_t k = 0; k < N && c0 + k < n; ++k) { J(r, c0 + k) = fd(r, 0).grad[k]; }
+    }
+  }
+  return J;
+}
+
+/**
+ * Jacobian function of f, usable wherever a Jacobian is expected (e.g. newton())
+ * @tparam N number of derivative directions per evaluation
+ * @param f function generic in the scalar type
+ * @returns callable evaluating the exact jacobian of f
+ */
+template<size_t N = 8, typename Function>
+std::function<Matrix<double>(const Matrix<double>&)> autodiffJacobian(const Function& f) {
+  return [f](const Matrix<double>& x) { return autodiffJacobian<N>(f, x); };
+}
+
+/**
+ * Jacobian of an ode with respect to y, usable as ODEOption::Jac
+ * @tparam N number of derivative directions per evaluation
+ * @param f right hand side f(t, y), generic in the scalar type of y
+ * @returns callable evaluating the exact jacobian of f with respect to y
+ */
+template<size_t N = 8, typename Function>
+std::function<Matrix<double>(double, Matrix<double>)> autodiffODEJacobian(const Function& f) {
+  return [f](double t, const Matrix<double>& y) {
+    return autodiffJacobian<N>([&f, t](const auto& yd) { return f(t, yd); }, y);
+  };
+}
+
+/**
+ * \example numerics/TestAutodiff.cpp
+ * This is an example on how to use automatic differentiation.
+ */
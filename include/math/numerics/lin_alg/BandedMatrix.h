@@ -0,0 +1,377 @@
+/**
+ * @file BandedMatrix.h
+ *
+ * Storage and solvers for banded matrices, i.e. matrices with
+ * $$a_{ij} = 0 \text{ for } i - j > k_l \text{ or } j - i > k_u$$
+ *
+ * Only the (kl + ku + 1) diagonals inside the band are stored, which requires O(n * (kl + ku)) memory
+ * instead of O(n^2). Implemented solvers:
+ * - thomas(): tridiagonal solver without pivoting, O(n)
+ * - BandedLU: LU decomposition with partial pivoting, O(n * kl * (kl + ku))
+ * - cyclicThomas(): periodic tridiagonal systems (e.g. periodic splines) via Sherman-Morrison, O(n)
+ *
+ * Usage:
+ * \code
+ * auto A = BandedMatrix<double>::Tridiag(n, 1, 4, 1);
+ * auto x = thomas(A, b);
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/BandedMatrix.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Banded matrix with kl sub- and ku super-diagonals.
+ *
+ * Row i stores the columns i - kl, ..., i + ku contiguously.
+ * @tparam T value type
+ */
+template<typename T = double>
+class BandedMatrix
+{
+public:
+  /**
+   * Default constructor
+   */
+  BandedMatrix() { }
+
+  /**
+   * Creates square banded matrix of given dimension
+   * @param n number of rows and columns
+   * @param kl number of sub-diagonals
+   * @param ku number of super-diagonals
+   * @param val initial value of all elements inside the band
+   */
+  BandedMatrix(size_t n, size_t kl, size_t ku, T val = 0)
+    : _n(n)
+    , _kl(kl)
+    , _ku(ku)
+    , _data(n * (kl + ku + 1), val) { }
+
+  /**
+   * Creates tri-diagonal matrix, banded counterpart of tridiag()
+   * @param n row/column dimension
+   * @param lower lower diagonal element value
+   * @param center diagonal element value
+   * @param upper upper diagonal element value
+   * @returns tri-diagonal matrix with 3n stored values
+   */
+  static BandedMatrix Tridiag(size_t n, T lower, T center, T upper) {
+    BandedMatrix out(n, 1, 1);
+    for(size_t i = 0; i < n; ++i) {
+      if(i > 0) out(i, i - 1) = lower;
+      out(i, i) = center;
+      if(i + 1 < n) out(i, i + 1) = upper;
+    }
+    return out;
+  }
+
+  /**
+   * Extracts band of given dense matrix, elements outside the band are dropped
+   * @param A square matrix
+   * @param kl number of sub-diagonals
+   * @param ku number of super-diagonals
+   * @returns banded representation of A
+   */
+  static BandedMatrix FromDense(const Matrix<T>& A, size_t kl, size_t ku) {
+    assert(A.rows() == A.columns());
+    BandedMatrix out(A.rows(), kl, ku);
+    for(size_t i = 0; i < A.rows(); ++i) {
+      for(size_t j = out.FirstColumn(i); j <= out.LastColumn(i); ++j) { out(i, j) = A(i, j); }
+    }
+    return out;
+  }
+
+  /**
+   * row getter
+   * @returns number of rows
+   */
+  [[nodiscard]] inline size_t rows() const { return _n; }
+  /**
+   * columns getter
+   * @returns number of columns
+   */
+  [[nodiscard]] inline size_t columns() const { return _n; }
+  /**
+   * @returns number of sub-diagonals
+   */
+  [[nodiscard]] inline size_t lower() const { return _kl; }
+  /**
+   * @returns number of super-diagonals
+   */
+  [[nodiscard]] inline size_t upper() const { return _ku; }
+
+  /**
+   * @param i row index
+   * @returns index of the first column of row i inside the band
+   */
+  [[nodiscard]] inline size_t FirstColumn(size_t i) const { return i > _kl ? i - _kl : 0; }
+  /**
+   * @param i row index
+   * @returns index of the last column of row i inside the band
+   */
+  [[nodiscard]] inline size_t LastColumn(size_t i) const { return i + _ku < _n ? i + _ku : _n - 1; }
+
+  /**
+   * Helper to test whether an element is stored
+   * @param i row index
+   * @param j column index
+   * @returns true if (i, j) lies inside the band
+   */
+  [[nodiscard]] inline bool InBand(size_t i, size_t j) const { return j + _kl >= i && j <= i + _ku; }
+
+  /**
+   * element access, (i, j) has to lie inside the band
+   * @param i row index
+   * @param j column index
+   * @returns value at given address
+   */
+  T& operator()(size_t i, size_t j) {
+    assert(InBand(i, j));
+    return _data[i * (_kl + _ku + 1) + (j + _kl - i)];
+  }
+  /**
+   * const element access
+   * @param i row index
+   * @param j column index
+   * @returns value at given address, 0 outside the band
+   */
+  T operator()(size_t i, size_t j) const {
+    if(!InBand(i, j)) return T(0);
+    return _data[i * (_kl + _ku + 1) + (j + _kl - i)];
+  }
+
+  /**
+   * Converts into dense representation
+   * @returns dense n x n matrix
+   */
+  [[nodiscard]] Matrix<T> ToDense() const {
+    Matrix<T> out(0, _n, _n);
+    for(size_t i = 0; i < _n; ++i) {
+      for(size_t j = FirstColumn(i); j <= LastColumn(i); ++j) { out(i, j) = (*this)(i, j); }
+    }
+    return out;
+  }
+
+private:
+  //! number rows/columns
+  size_t _n = 0;
+  //! number sub-diagonals
+  size_t _kl = 0;
+  //! number super-diagonals
+  size_t _ku = 0;
+  //! row-wise band storage
+  std::vector<T> _data;
+};
+
+/**
+ * Banded Matrix-Matrix multiplication, O(n * (kl + ku) * columns)
+ * @param lhs banded matrix with dimension n x n
+ * @param rhs matrix with dimension n x m
+ * @returns n x m result matrix
+ */
+template<typename T>
+inline Matrix<T> operator*(const BandedMatrix<T>& lhs, const Matrix<T>& rhs) {
+  assert(lhs.columns() == rhs.rows());
+  size_t m = rhs.columns();
+  Matrix<T> result(0, lhs.rows(), m);
+  for(size_t i = 0; i < lhs.rows(); ++i) {
+    for(size_t j = lhs.FirstColumn(i); j <= lhs.LastColumn(i); ++j) {
+      T aij = lhs(i, j);
+      for(size_t c = 0; c < m; ++c) { result(i, c) += aij * rhs(j, c); }
+    }
+  }
+  return result;
+}
+
+/**
+ * Thomas algorithm, solves tri-diagonal systems in O(n) without pivoting.
+ *
+ * Stable for diagonally dominant or symmetric positive definite matrices.
+ *
+ * @param A tri-diagonal matrix (kl = ku = 1)
+ * @param d right hand side(s), n x m
+ * @returns solution x of A x = d
+ */
+inline Matrix<double> thomas(const BandedMatrix<double>& A, const Matrix<double>& d) {
+  assert(A.lower() == 1 && A.upper() == 1);
+  size_t n = A.rows(), m = d.columns();
+  assert(d.rows() == n);
+  std::vector<double> c(n, 0.0);
+  auto x = d;
+
+  double beta = A(0, 0);
+  for(size_t col = 0; col < m; ++col) { x(0, col) /= beta; }
+  for(size_t i = 1; i < n; ++i) {
+    c[i - 1] = A(i - 1, i) / beta;
+    beta     = A(i, i) - A(i, i - 1) * c[i - 1];
+    for(size_t col = 0; col < m; ++col) { x(i, col) = (x(i, col) - A(i, i - 1) * x(i - 1, col)) / beta; }
+  }
+  for(size_t i = n - 1; i-- > 0;) {
+    for(size_t col = 0; col < m; ++col) { x(i, col) -= c[i] * x(i + 1, col); }
+  }
+  return x;
+}
+
+/**
+ * Solves a cyclic tri-diagonal system, as it occurs for periodic splines
+ *
+ * $$
+ * \begin{pmatrix}
+ *   b_0 & c_0 & & \beta \\\
+ *   a_1 & b_1 & c_1 & \\\
+ *   & \ddots & \ddots & \ddots \\\
+ *   \alpha & & a_{n-1} & b_{n-1}
+ * \end{pmatrix} x = d
+ * $$
+ *
+ * using the Sherman-Morrison formula on top of two thomas() solves.
+ *
+ * @param A tri-diagonal part of the system, n >= 3
+ * @param alpha lower left corner element $$a_{n-1, 0}$$
+ * @param beta upper right corner element $$a_{0, n-1}$$
+ * @param d right hand side(s), n x m
+ * @returns solution x
+ */
+inline Matrix<double> cyclicThomas(const BandedMatrix<double>& A, double alpha, double beta, const Matrix<double>& d) {
+  size_t n = A.rows(), m = d.columns();
+  assert(n >= 3);
+  double gamma = -A(0, 0);
+  auto B       = A;
+  B(0, 0)      = A(0, 0) - gamma;
+  B(n - 1, n - 1) = A(n - 1, n - 1) - alpha * beta / gamma;
+
+  Matrix<double> u(0, n, 1);
+  u(0, 0)     = gamma;
+  u(n - 1, 0) = alpha;
+
+  auto x = thomas(B, d);
+  auto z = thomas(B, u);
+
+  double denominator = 1.0 + z(0, 0) + beta * z(n - 1, 0) / gamma;
+  for(size_t col = 0; col < m; ++col) {
+    double factor = (x(0, col) + beta * x(n - 1, col) / gamma) / denominator;
+    for(size_t i = 0; i < n; ++i) { x(i, col) -= factor * z(i, 0); }
+  }
+  return x;
+}
+
+/**
+ * LU decomposition with partial pivoting of a banded matrix.
+ *
+ * Row interchanges increase the upper bandwidth of U to kl + ku, the multipliers of L are stored
+ * column wise (at most kl per column).
+ */
+class BandedLU
+{
+public:
+  //! upper triangular factor with bandwidth kl + ku
+  BandedMatrix<double> U;
+  //! multipliers, column k holds l_{k+1,k}, ..., l_{k+kl,k}
+  std::vector<double> multipliers;
+  //! pivot rows, row k was interchanged with row pivots[k]
+  std::vector<size_t> pivots;
+  //! false if a zero pivot occurred
+  bool isRegular = false;
+
+  /**
+   * Default constructor
+   */
+  BandedLU() { }
+
+  /**
+   * Factorizes given matrix
+   * @param A banded matrix
+   */
+  explicit BandedLU(const BandedMatrix<double>& A) { factorize(A); }
+
+  /**
+   * Gaussian elimination with partial pivoting restricted to the band
+   * @param A banded matrix
+   * @returns true if A is regular
+   */
+  bool factorize(const BandedMatrix<double>& A) {
+    size_t n = A.rows(), kl = A.lower(), ku = A.upper();
+    _kl      = kl;
+    // rows of the working matrix hold columns i - kl, ..., i + kl + ku
+    U = BandedMatrix<double>(n, kl, kl + ku);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = A.FirstColumn(i); j <= A.LastColumn(i); ++j) { U(i, j) = A(i, j); }
+    }
+    multipliers.assign(n * (kl > 0 ? kl : 1), 0.0);
+    pivots.resize(n);
+    isRegular = true;
+
+    for(size_t k = 0; k < n; ++k) {
+      size_t last = k + kl < n ? k + kl : n - 1;
+      size_t p    = k;
+      for(size_t r = k + 1; r <= last; ++r) {
+        if(std::abs(U(r, k)) > std::abs(U(p, k))) p = r;
+      }
+      pivots[k] = p;
+      if(U(p, k) == 0.0) {
+        isRegular = false;
+        continue;
+      }
+      size_t lastColumn = U.LastColumn(k);
+      if(p != k) {
+        // p <= k + kl, hence columns k, ..., k + kl + ku lie inside the band of row p
+        for(size_t j = k; j <= lastColumn; ++j) { std::swap(U(k, j), U(p, j)); }
+      }
+      for(size_t r = k + 1; r <= last; ++r) {
+        double l                              = U(r, k) / U(k, k);
+        multipliers[k * kl + (r - k - 1)] = l;
+        U(r, k)                               = 0.0;
+        if(l == 0.0) continue;
+        for(size_t j = k + 1; j <= lastColumn; ++j) { U(r, j) -= l * U(k, j); }
+      }
+    }
+    return isRegular;
+  }
+
+  /**
+   * Solves A x = b using the stored factorization
+   * @param b right hand side(s), n x m
+   * @returns x
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    size_t n = U.rows(), m = b.columns();
+    assert(b.rows() == n);
+    auto x = b;
+    for(size_t k = 0; k < n; ++k) {
+      size_t p = pivots[k];
+      if(p != k) {
+        for(size_t c = 0; c < m; ++c) { std::swap(x(k, c), x(p, c)); }
+      }
+      size_t last = k + _kl < n ? k + _kl : n - 1;
+      for(size_t r = k + 1; r <= last; ++r) {
+        double l = multipliers[k * _kl + (r - k - 1)];
+        for(size_t c = 0; c < m; ++c) { x(r, c) -= l * x(k, c); }
+      }
+    }
+    for(size_t i = n; i-- > 0;) {
+      for(size_t j = i + 1; j <= U.LastColumn(i); ++j) {
+        double uij = U(i, j);
+        for(size_t c = 0; c < m; ++c) { x(i, c) -= uij * x(j, c); }
+      }
+      for(size_t c = 0; c < m; ++c) { x(i, c) /= U(i, i); }
+    }
+    return x;
+  }
+
+private:
+  //! number of sub-diagonals of the factorized matrix
+  size_t _kl = 0;
+};
+
+/**
+ * \example numerics/lin_alg/TestBandedMatrix.cpp
+ * This is an example on how to use BandedMatrix and its solvers.
+ */
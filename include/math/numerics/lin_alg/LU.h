@@ -34,19 +34,22 @@
 
 #pragma once
 #include "../../Matrix.h"
+#include "trsm.h"
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
 
 /**
- * LU-decomposition of A
+ * LU-decomposition of A, also available in single precision (Matrix<float>)
  * @param A matrix to decompose
  * @returns in-place decomposed matrix L+U
  */
-std::pair<Matrix<double>, std::vector<unsigned int>> LU(const Matrix<double>& A) {
-  auto m           = A.rows();
-  auto n           = A.columns();
-  Matrix<double> B = A;
+template<typename T>
+std::pair<Matrix<T>, std::vector<unsigned int>> LU(const Matrix<T>& A) {
+  auto m      = A.rows();
+  auto n      = A.columns();
+  Matrix<T> B = A;
 
   if(m != n) {
     // Error
@@ -55,13 +58,16 @@ std::pair<Matrix<double>, std::vector<unsigned int>> LU(const Matrix<double>& A)
   // init pivot vector
   std::vector<unsigned int> p(m, 0);
   for(size_t i = 0; i < m; i++) { p[i] = i; }
+  if(n == 0) return { B, p };
 
-  for(size_t col = 0; col < n - 1; col++) {
-    auto maxVal = std::abs(B(col, col));
+  // raw row-major access, the row updates are contiguous and vectorize
+  T* b = &B(0, 0);
+  for(size_t col = 0; col + 1 < n; col++) {
+    auto maxVal = std::abs(b[col * n + col]);
     auto index  = col;
     for(size_t q = col; q < n; q++) {
-      if(std::abs(B(q, col)) > maxVal) {
-        maxVal = std::abs(B(q, col));
+      if(std::abs(b[q * n + col]) > maxVal) {
+        maxVal = std::abs(b[q * n + col]);
         index  = q;
       }
     }
@@ -69,23 +75,44 @@ std::pair<Matrix<double>, std::vector<unsigned int>> LU(const Matrix<double>& A)
     p[index]  = p[col];
     p[col]    = safe;
 
-    if(index != col) {
-      auto matrixSafe = B(col);
+    if(index != col) { std::swap_ranges(b + col * n, b + (col + 1) * n, b + index * n); }
 
-      B.SetRow(col, B(index));
-      B.SetRow(index, matrixSafe);
-    }
-
-    for(size_t row = col + 1; row < n; row++) { B(row, col) /= B(col, col); }
+    for(size_t row = col + 1; row < n; row++) { b[row * n + col] /= b[col * n + col]; }
 
+    const T* pivotRow = b + col * n;
     for(size_t i = col + 1; i < m; i++) {
-      for(size_t j = col + 1; j < n; j++) { B(i, j) -= (B(i, col) * B(col, j)); }
+      T* bi = b + i * n;
+      T l   = bi[col];
+      for(size_t j = col + 1; j < n; j++) { bi[j] -= l * pivotRow[j]; }
     }
   }
 
   return { B, p };
 }
 
+/**
+ * Solves $$Ax = b$$ with a decomposition computed by LU()
+ * @param LR decomposition L+U paired with the row permutation
+ * @param b right hand side(s)
+ * @returns $$x$$
+ */
+template<typename T>
+Matrix<T> luSolve(const std::pair<Matrix<T>, std::vector<unsigned int>>& LR, const Matrix<T>& b) {
+  auto x = b;
+  if(b.rows() == 0 || b.columns() == 0) return x;
+  size_t nrhs = b.columns();
+  for(size_t i = 0; i < b.rows(); i++) {
+    const T* source = &b(LR.second[i], 0);
+    std::copy(source, source + nrhs, &x(i, 0));
+  }
+
+  // L c = P b, U x = c, in place on the permuted right hand side(s)
+  size_t n = LR.first.rows();
+  trsm(&LR.first(0, 0), n, n, &x(0, 0), nrhs, nrhs, LOWER_TRIANGULAR, false, UNIT_DIAGONAL);
+  trsm(&LR.first(0, 0), n, n, &x(0, 0), nrhs, nrhs, UPPER_TRIANGULAR);
+  return x;
+}
+
 /**
  * \example numerics/lin_alg/TestLU.cpp
  * This is an example on how to use LU.
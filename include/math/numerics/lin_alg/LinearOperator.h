@@ -0,0 +1,60 @@
+/**
+ * @file LinearOperator.h
+ *
+ * Matrix-free representation of linear maps $$x \mapsto A x$$ as used by the iterative solvers
+ * (lanczos(), cg(), bicgstab(), gmres()), together with adapters for dense and sparse matrices.
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/LinearOperator.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "SparseMatrix.h"
+#include <functional>
+
+//! representation of a linear operator, computes y = A * x for column vectors x
+using LinearOperator = std::function<Matrix<double>(const Matrix<double>&)>;
+
+/**
+ * Wraps a dense matrix as linear operator.
+ *
+ * **Note** the operator references A, it has to outlive the returned operator.
+ *
+ * @param A matrix with dimension n x m
+ * @returns operator computing A * x
+ */
+inline LinearOperator asOperator(const Matrix<double>& A) {
+  return [&A](const Matrix<double>& x) {
+    size_t n = A.rows(), m = A.columns();
+    Matrix<double> y(0, n, 1);
+    const double* data = &A(0, 0);
+    for(size_t i = 0; i < n; ++i) {
+      double s = 0.0;
+      for(size_t j = 0; j < m; ++j) { s += data[i * m + j] * x(j, 0); }
+      y(i, 0) = s;
+    }
+    return y;
+  };
+}
+
+/**
+ * Wraps a sparse matrix as linear operator, uses the threaded SpMV.
+ *
+ * **Note** the operator references A, it has to outlive the returned operator.
+ *
+ * @param A sparse matrix
+ * @returns operator computing A * x
+ */
+inline LinearOperator asOperator(const CSRMatrix<double>& A) {
+  return [&A](const Matrix<double>& x) { return A * x; };
+}
+
+/**
+ * Identity overload, allows generic code to accept matrices as well as operators
+ * @param A linear operator
+ * @returns A
+ */
+inline LinearOperator asOperator(const LinearOperator& A) { return A; }
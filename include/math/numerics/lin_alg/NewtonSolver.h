@@ -0,0 +1,277 @@
+/**
+ * @file NewtonSolver.h
+ *
+ * Newton engine for nonlinear systems $$f(x) = 0$$ with
+ * - finite difference jacobians if no derivative is given, using a column coloring of a known
+ *   sparsity pattern (a banded jacobian requires bandwidth + 1 evaluations of f),
+ * - jacobian reuse: full newton, chord (simplified) newton and Broyden updates,
+ * - backtracking line search on the residual norm.
+ *
+ * The columns (colors) of a finite difference jacobian are evaluated concurrently by parallelFor(),
+ * hence f must be safe to call from multiple threads.
+ *
+ * Usage:
+ * \code
+ * NewtonOption option;
+ * option.update = CHORD_NEWTON;
+ * NewtonSolver solver(f, pattern, option); // finite differences on a sparse pattern
+ * auto res = solver.solve(x0);
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/NewtonSolver.h>
+ * \endcode
+ */
+#pragma once
+
+#include "finiteDifferences.h"
+#include "newton.h"
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+/**
+ * Jacobian handling of NewtonSolver
+ */
+enum NewtonUpdate {
+  //! evaluate and factorize the jacobian in every iteration
+  FULL_NEWTON = 0,
+  //! reuse the factorized jacobian until convergence slows down
+  CHORD_NEWTON = 1,
+  //! rank one (good) Broyden updates of the factorized jacobian until convergence slows down
+  BROYDEN_NEWTON = 2
+};
+
+/**
+ * Options for NewtonSolver
+ */
+struct NewtonOption {
+  //! jacobian handling
+  NewtonUpdate update = FULL_NEWTON;
+  //! converged if the norm of the (undamped) newton step is below TOL
+  double TOL = 1e-10;
+  //! converged if the norm of the residual is below fTOL (disabled for 0)
+  double fTOL = 0;
+  //! maximum number of iterations
+  int maxIter = 100;
+  //! backtracking line search on the residual norm
+  bool lineSearch = true;
+  //! chord/Broyden: jacobian is refreshed if a step is larger than contraction times the previous step
+  double contraction = 0.5;
+  //! Broyden: maximum number of updates before the jacobian is refreshed
+  size_t maxUpdates = 20;
+  //! relative finite difference step, 0 uses the square root of the machine precision
+  double fdStep = 0;
+};
+
+/**
+ * Result of NewtonSolver::solve
+ */
+struct NewtonResult {
+  //! approximated root
+  Matrix<double> x;
+  //! number of iterations
+  int iterations = 0;
+  //! number of evaluations of f, including finite differences
+  size_t functionEvaluations = 0;
+  //! number of jacobian evaluations (and factorizations)
+  size_t jacobianEvaluations = 0;
+  //! norm of f(x)
+  double residual = 0;
+  //! true if the tolerance was reached
+  bool converged = false;
+};
+
+/**
+ * Newton solver with optional finite difference jacobian, jacobian reuse and line search
+ */
+class NewtonSolver
+{
+public:
+  //! options of the iteration
+  NewtonOption option;
+
+  /**
+   * Dense solver
+   * @param f function
+   * @param Df jacobian of f, nullptr for finite differences
+   * @param _option options of the iteration
+   */
+  explicit NewtonSolver(const LinearEquation& f, const Jacobian& Df = nullptr, const NewtonOption& _option = NewtonOption())
+    : option(_option)
+    , _f(f)
+    , _Df(Df) { }
+
+  /**
+   * Sparse solver with finite difference jacobian on a known sparsity pattern
+   * @param f function
+   * @param pattern sparsity pattern of the jacobian, the values are ignored
+   * @param _option options of the iteration
+   */
+  NewtonSolver(const LinearEquation& f, const CSRMatrix<double>& pattern, const NewtonOption& _option = NewtonOption())
+    : option(_option)
+    , _f(f)
+    , _pattern(pattern)
+    , _colors(jacobianColoring(pattern))
+    , _sparse(true) { }
+
+  /**
+   * @returns number of colors of the sparsity pattern, equals the number of evaluations of f per jacobian
+   */
+  [[nodiscard]] size_t colors() const {
+    size_t count = 0;
+    for(auto c : _colors) { count = std::max(count, c + 1); }
+    return count;
+  }
+
+  /**
+   * Approximates a root of f
+   * @param x0 start value
+   * @returns result of the iteration
+   */
+  NewtonResult solve(const Matrix<double>& x0) {
+    NewtonResult res;
+    res.x  = x0;
+    auto F = _f(res.x);
+    res.functionEvaluations++;
+
+    bool needJacobian = true, fresh = false;
+    double previousStep = std::numeric_limits<double>::infinity();
+    while(res.iterations < option.maxIter) {
+      if(needJacobian) {
+        if(!factorize(res.x, F, res)) break;
+        needJacobian = false;
+        fresh        = true;
+      }
+      auto delta = applyInverse(F * -1.0);
+
+      double normF  = norm(F);
+      double lambda = 1.0;
+      auto x        = res.x + delta;
+      auto Fx       = _f(x);
+      res.functionEvaluations++;
+      bool sufficient = norm(Fx) <= (1 - 1e-4 * lambda) * normF;
+      while(option.lineSearch && !sufficient && lambda > 1.0 / 1024) {
+        lambda *= 0.5;
+        x  = res.x + delta * lambda;
+        Fx = _f(x);
+        res.functionEvaluations++;
+        sufficient = norm(Fx) <= (1 - 1e-4 * lambda) * normF;
+      }
+      if(option.lineSearch && !sufficient) {
+        if(!fresh) {
+          // step of an outdated jacobian failed, retry with a fresh one
+          needJacobian = true;
+          continue;
+        }
+        // no descent with a fresh jacobian, the step is rejected and the iteration stalls
+        res.converged = norm(delta) <= option.TOL || (option.fTOL > 0 && normF <= option.fTOL);
+        break;
+      }
+
+      if(option.update == BROYDEN_NEWTON) broydenUpdate(x - res.x, Fx - F);
+      double step = lambda * norm(delta);
+      res.x       = x;
+      F           = Fx;
+      res.iterations++;
+
+      if(norm(delta) <= option.TOL || (option.fTOL > 0 && norm(F) <= option.fTOL)) {
+        res.converged = true;
+        break;
+      }
+      needJacobian = option.update == FULL_NEWTON || step > option.contraction * previousStep ||
+                     (option.update == BROYDEN_NEWTON && _updates.size() >= option.maxUpdates);
+      previousStep = step;
+      fresh        = false;
+    }
+    res.residual = norm(F);
+    return res;
+  }
+
+private:
+  //! function
+  LinearEquation _f;
+  //! dense jacobian, nullptr for finite differences
+  Jacobian _Df;
+  //! sparsity pattern for sparse finite differences
+  CSRMatrix<double> _pattern;
+  //! column coloring of the pattern
+  std::vector<size_t> _colors;
+  //! true if the sparse path is used
+  bool _sparse = false;
+  //! dense LU factorization with pivots
+  std::pair<Matrix<double>, std::vector<unsigned int>> _lu;
+  //! sparse LU factorization, the symbolic analysis is done once
+  std::optional<SparseLU> _sparseLU;
+  //! Broyden updates (u, s), the inverse is (I + u_k s_k^T) ... (I + u_1 s_1^T) J^{-1}
+  std::vector<std::pair<Matrix<double>, Matrix<double>>> _updates;
+
+  /**
+   * Evaluates and factorizes the jacobian in x
+   * @returns false if the jacobian is singular
+   */
+  bool factorize(const Matrix<double>& x, const Matrix<double>& F, NewtonResult& res) {
+    _updates.clear();
+    res.jacobianEvaluations++;
+    if(_sparse) {
+      auto J = finiteDifferenceJacobian(_f, x, F, _pattern, _colors, option.fdStep, true);
+      res.functionEvaluations += colors();
+      if(_sparseLU) {
+        _sparseLU->factorize(J);
+      } else {
+        _sparseLU.emplace(J);
+      }
+      return _sparseLU->isRegular;
+    }
+    Matrix<double> J;
+    if(_Df) {
+      J = _Df(x);
+    } else {
+      J = finiteDifferenceJacobian(_f, x, F, option.fdStep, true);
+      res.functionEvaluations += x.rows();
+    }
+    _lu = LU(J);
+    for(size_t i = 0; i < J.rows(); ++i) {
+      if(_lu.first(i, i) == 0.0) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Applies the inverse of the current (updated) jacobian
+   */
+  [[nodiscard]] Matrix<double> applyInverse(const Matrix<double>& b) const {
+    Matrix<double> z;
+    if(_sparse) {
+      z = _sparseLU->solve(b);
+    } else {
+      z = luSolve(_lu, b);
+    }
+    for(const auto& [u, s] : _updates) {
+      double sz = 0;
+      for(size_t i = 0; i < z.rows(); ++i) { sz += s(i, 0) * z(i, 0); }
+      z += u * sz;
+    }
+    return z;
+  }
+
+  /**
+   * Good Broyden update of the inverse jacobian by the Sherman-Morrison formula
+   * @param s accepted step
+   * @param y change of the residual
+   */
+  void broydenUpdate(const Matrix<double>& s, const Matrix<double>& y) {
+    auto Hy      = applyInverse(y);
+    double denom = 0;
+    for(size_t i = 0; i < s.rows(); ++i) { denom += s(i, 0) * Hy(i, 0); }
+    if(std::abs(denom) <= std::numeric_limits<double>::epsilon() * norm(s) * norm(Hy)) return;
+    _updates.emplace_back((s - Hy) * (1.0 / denom), s);
+  }
+};
+
+/**
+ * \example numerics/lin_alg/TestNewtonSolver.cpp
+ * This is an example on how to use the NewtonSolver.
+ */
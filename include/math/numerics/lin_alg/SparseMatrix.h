@@ -0,0 +1,821 @@
+/**
+ * @file SparseMatrix.h
+ *
+ * Compressed storage formats for sparse matrices:
+ * - COOMatrix: coordinate list, used to assemble matrices element by element
+ * - CSRMatrix: compressed sparse rows, row-wise computations (SpMV, SpMM, SpGEMM)
+ * - CSCMatrix: compressed sparse columns, column-wise access (e.g. direct solvers)
+ *
+ * Memory requirements are O(rows + nnz) instead of O(rows * columns). Within every row (CSR)
+ * or column (CSC) the indices are stored sorted and without duplicates.
+ *
+ * Usage:
+ * \code
+ * COOMatrix<double> coo(n, n);
+ * for(size_t i = 0; i < n; ++i) { coo.add(i, i, 2.0); }
+ * SparseMatrix<double> A(coo);
+ * auto y = A * x;
+ * A.Save("A.csr");
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/SparseMatrix.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+template<typename T>
+class CSRMatrix;
+template<typename T>
+class CSCMatrix;
+
+/**
+ * Sparse matrix in coordinate format, duplicates are summed on conversion.
+ * @tparam T value type
+ */
+template<typename T = double>
+class COOMatrix
+{
+public:
+  //! row indices
+  std::vector<size_t> rowIndices;
+  //! column indices
+  std::vector<size_t> columnIndices;
+  //! values
+  std::vector<T> values;
+
+  /**
+   * Creates empty matrix of given dimension
+   * @param rows number of rows
+   * @param columns number of columns
+   */
+  COOMatrix(size_t rows = 0, size_t columns = 0)
+    : _rows(rows)
+    , _columns(columns) { }
+
+  /**
+   * Appends an element, entries with the same position are accumulated
+   * @param i row index
+   * @param j column index
+   * @param value value to add
+   */
+  void add(size_t i, size_t j, T value) {
+    assert(i < _rows && j < _columns);
+    rowIndices.push_back(i);
+    columnIndices.push_back(j);
+    values.push_back(value);
+  }
+
+  /**
+   * Reserves memory for the given number of entries
+   * @param nnz expected number of entries
+   */
+  void reserve(size_t nnz) {
+    rowIndices.reserve(nnz);
+    columnIndices.reserve(nnz);
+    values.reserve(nnz);
+  }
+
+  /**
+   * row getter
+   * @returns number of rows
+   */
+  [[nodiscard]] inline size_t rows() const { return _rows; }
+  /**
+   * columns getter
+   * @returns number of columns
+   */
+  [[nodiscard]] inline size_t columns() const { return _columns; }
+  /**
+   * @returns number of stored entries (including duplicates)
+   */
+  [[nodiscard]] inline size_t nonZeros() const { return values.size(); }
+
+  /**
+   * Converts into dense representation
+   * @returns dense rows x columns matrix
+   */
+  [[nodiscard]] Matrix<T> ToDense() const {
+    Matrix<T> out(0, _rows, _columns);
+    for(size_t k = 0; k < values.size(); ++k) { out(rowIndices[k], columnIndices[k]) += values[k]; }
+    return out;
+  }
+
+private:
+  //! number of rows
+  size_t _rows = 0;
+  //! number of columns
+  size_t _columns = 0;
+};
+
+/**
+ * Sparse matrix in compressed sparse row format.
+ *
+ * The column indices of row i are stored in indices[indptr[i]], ..., indices[indptr[i + 1] - 1].
+ * @tparam T value type
+ */
+template<typename T = double>
+class CSRMatrix
+{
+public:
+  //! row pointers, rows + 1 entries
+  std::vector<size_t> indptr;
+  //! column indices, sorted within every row
+  std::vector<size_t> indices;
+  //! non zero values
+  std::vector<T> values;
+
+  /**
+   * Creates empty (all zero) matrix of given dimension
+   * @param rows number of rows
+   * @param columns number of columns
+   */
+  CSRMatrix(size_t rows = 0, size_t columns = 0)
+    : indptr(rows + 1, 0)
+    , _rows(rows)
+    , _columns(columns) { }
+
+  /**
+   * Creates matrix from given compressed arrays
+   * @param rows number of rows
+   * @param columns number of columns
+   * @param _indptr row pointers
+   * @param _indices column indices, sorted within every row
+   * @param _values values
+   */
+  CSRMatrix(size_t rows, size_t columns, std::vector<size_t> _indptr, std::vector<size_t> _indices, std::vector<T> _values)
+    : indptr(std::move(_indptr))
+    , indices(std::move(_indices))
+    , values(std::move(_values))
+    , _rows(rows)
+    , _columns(columns) {
+    assert(indptr.size() == rows + 1 && indices.size() == values.size());
+  }
+
+  /**
+   * Compresses a coordinate list, duplicates are summed up
+   * @param coo assembled matrix
+   */
+  explicit CSRMatrix(const COOMatrix<T>& coo)
+    : CSRMatrix(coo.rows(), coo.columns()) {
+    size_t nnz = coo.nonZeros();
+    for(size_t k = 0; k < nnz; ++k) { indptr[coo.rowIndices[k] + 1]++; }
+    std::partial_sum(indptr.begin(), indptr.end(), indptr.begin());
+
+    std::vector<size_t> position(indptr.begin(), indptr.end() - 1);
+    std::vector<size_t> cols(nnz);
+    std::vector<T> vals(nnz);
+    for(size_t k = 0; k < nnz; ++k) {
+      size_t p = position[coo.rowIndices[k]]++;
+      cols[p]  = coo.columnIndices[k];
+      vals[p]  = coo.values[k];
+    }
+
+    // sort every row and merge duplicates
+    std::vector<size_t> order;
+    indices.reserve(nnz);
+    values.reserve(nnz);
+    size_t start = 0;
+    for(size_t i = 0; i < _rows; ++i) {
+      size_t end = indptr[i + 1];
+      order.resize(end - start);
+      std::iota(order.begin(), order.end(), start);
+      std::sort(order.begin(), order.end(), [&cols](size_t a, size_t b) { return cols[a] < cols[b]; });
+      size_t rowStart = indices.size();
+      for(size_t p : order) {
+        if(indices.size() > rowStart && indices.back() == cols[p]) {
+          values.back() += vals[p];
+        } else {
+          indices.push_back(cols[p]);
+          values.push_back(vals[p]);
+        }
+      }
+      start         = end;
+      indptr[i + 1] = indices.size();
+    }
+  }
+
+  /**
+   * Compresses a dense matrix
+   * @param A dense matrix
+   * @param tolerance elements with absolute value <= tolerance are dropped
+   * @returns sparse representation of A
+   */
+  static CSRMatrix FromDense(const Matrix<T>& A, T tolerance = T(0)) {
+    CSRMatrix out(A.rows(), A.columns());
+    for(size_t i = 0; i < A.rows(); ++i) {
+      for(size_t j = 0; j < A.columns(); ++j) {
+        if(std::abs(A(i, j)) > tolerance) {
+          out.indices.push_back(j);
+          out.values.push_back(A(i, j));
+        }
+      }
+      out.indptr[i + 1] = out.indices.size();
+    }
+    return out;
+  }
+
+  /**
+   * Sparse identity matrix
+   * @param n dimension
+   * @returns n x n identity
+   */
+  static CSRMatrix Identity(size_t n) {
+    CSRMatrix out(n, n);
+    out.indices.resize(n);
+    out.values.assign(n, T(1));
+    for(size_t i = 0; i < n; ++i) {
+      out.indices[i]    = i;
+      out.indptr[i + 1] = i + 1;
+    }
+    return out;
+  }
+
+  /**
+   * row getter
+   * @returns number of rows
+   */
+  [[nodiscard]] inline size_t rows() const { return _rows; }
+  /**
+   * columns getter
+   * @returns number of columns
+   */
+  [[nodiscard]] inline size_t columns() const { return _columns; }
+  /**
+   * @returns number of stored elements
+   */
+  [[nodiscard]] inline size_t nonZeros() const { return values.size(); }
+
+  /**
+   * element access by binary search within row i
+   * @param i row index
+   * @param j column index
+   * @returns value at (i, j), 0 if not stored
+   */
+  T operator()(size_t i, size_t j) const {
+    assert(i < _rows && j < _columns);
+    auto first = indices.begin() + indptr[i];
+    auto last  = indices.begin() + indptr[i + 1];
+    auto it    = std::lower_bound(first, last, j);
+    if(it == last || *it != j) return T(0);
+    return values[it - indices.begin()];
+  }
+
+  /**
+   * Converts into dense representation
+   * @returns dense rows x columns matrix
+   */
+  [[nodiscard]] Matrix<T> ToDense() const {
+    Matrix<T> out(0, _rows, _columns);
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t k = indptr[i]; k < indptr[i + 1]; ++k) { out(i, indices[k]) = values[k]; }
+    }
+    return out;
+  }
+
+  /**
+   * Converts into coordinate format
+   * @returns COO representation
+   */
+  [[nodiscard]] COOMatrix<T> ToCOO() const {
+    COOMatrix<T> out(_rows, _columns);
+    out.reserve(nonZeros());
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t k = indptr[i]; k < indptr[i + 1]; ++k) { out.add(i, indices[k], values[k]); }
+    }
+    return out;
+  }
+
+  /**
+   * Transposition in O(rows + columns + nnz)
+   * @returns transposed matrix in CSR format
+   */
+  [[nodiscard]] CSRMatrix Transpose() const {
+    CSRMatrix out(_columns, _rows);
+    out.indices.resize(nonZeros());
+    out.values.resize(nonZeros());
+    for(size_t j : indices) { out.indptr[j + 1]++; }
+    std::partial_sum(out.indptr.begin(), out.indptr.end(), out.indptr.begin());
+    std::vector<size_t> position(out.indptr.begin(), out.indptr.end() - 1);
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t k = indptr[i]; k < indptr[i + 1]; ++k) {
+        size_t p         = position[indices[k]]++;
+        out.indices[p] = i;
+        out.values[p]  = values[k];
+      }
+    }
+    return out;
+  }
+
+  /**
+   * Converts into compressed sparse column format
+   * @returns CSC representation
+   */
+  [[nodiscard]] CSCMatrix<T> ToCSC() const;
+
+  /**
+   * Apply given function to all stored elements, implicit zeros are not touched
+   * @param fun function to apply
+   * @returns matrix with transformed values and the same sparsity pattern
+   */
+  [[nodiscard]] CSRMatrix Apply(const std::function<T(T)>& fun) const {
+    auto out = *this;
+    for(auto& v : out.values) { v = fun(v); }
+    return out;
+  }
+
+  /**
+   * Element-wise multiplication, the result contains the intersection of both patterns
+   * @param other matrix of same dimension
+   * @returns this .* other
+   */
+  [[nodiscard]] CSRMatrix HadamardMulti(const CSRMatrix& other) const {
+    assert(_rows == other.rows() && _columns == other.columns());
+    CSRMatrix out(_rows, _columns);
+    for(size_t i = 0; i < _rows; ++i) {
+      size_t a = indptr[i], b = other.indptr[i];
+      while(a < indptr[i + 1] && b < other.indptr[i + 1]) {
+        if(indices[a] < other.indices[b]) {
+          ++a;
+        } else if(other.indices[b] < indices[a]) {
+          ++b;
+        } else {
+          out.indices.push_back(indices[a]);
+          out.values.push_back(values[a] * other.values[b]);
+          ++a;
+          ++b;
+        }
+      }
+      out.indptr[i + 1] = out.indices.size();
+    }
+    return out;
+  }
+
+  /**
+   * Element-wise linear combination alpha * this + beta * other, the result contains the union of both patterns
+   * @param other matrix of same dimension
+   * @param alpha factor of this
+   * @param beta factor of other
+   * @returns combined matrix
+   */
+  [[nodiscard]] CSRMatrix Combine(const CSRMatrix& other, T alpha, T beta) const {
+    assert(_rows == other.rows() && _columns == other.columns());
+    CSRMatrix out(_rows, _columns);
+    out.indices.reserve(nonZeros() + other.nonZeros());
+    out.values.reserve(nonZeros() + other.nonZeros());
+    for(size_t i = 0; i < _rows; ++i) {
+      size_t a = indptr[i], b = other.indptr[i];
+      size_t aEnd = indptr[i + 1], bEnd = other.indptr[i + 1];
+      while(a < aEnd || b < bEnd) {
+        if(b == bEnd || (a < aEnd && indices[a] < other.indices[b])) {
+          out.indices.push_back(indices[a]);
+          out.values.push_back(alpha * values[a++]);
+        } else if(a == aEnd || other.indices[b] < indices[a]) {
+          out.indices.push_back(other.indices[b]);
+          out.values.push_back(beta * other.values[b++]);
+        } else {
+          out.indices.push_back(indices[a]);
+          out.values.push_back(alpha * values[a++] + beta * other.values[b++]);
+        }
+      }
+      out.indptr[i + 1] = out.indices.size();
+    }
+    return out;
+  }
+
+  /**
+   * Removes explicitly stored elements with absolute value <= tolerance
+   * @param tolerance drop tolerance
+   */
+  void Prune(T tolerance = T(0)) {
+    size_t nnz = 0, start = 0;
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t k = start; k < indptr[i + 1]; ++k) {
+        if(std::abs(values[k]) > tolerance) {
+          indices[nnz]  = indices[k];
+          values[nnz++] = values[k];
+        }
+      }
+      start         = indptr[i + 1];
+      indptr[i + 1] = nnz;
+    }
+    indices.resize(nnz);
+    values.resize(nnz);
+  }
+
+  /**
+   * Extracts the main diagonal
+   * @returns min(rows, columns) x 1 vector
+   */
+  [[nodiscard]] Matrix<T> Diagonal() const {
+    size_t n = std::min(_rows, _columns);
+    Matrix<T> out(0, n, 1);
+    for(size_t i = 0; i < n; ++i) { out(i, 0) = (*this)(i, i); }
+    return out;
+  }
+
+  /**
+   * Writes the matrix in a compact binary format:
+   * magic "MATHCSR1", rows, columns, nnz, sizeof(T) (each uint64) followed by indptr, indices (uint64) and values
+   * @param fileName path of the output file
+   * @returns true on success
+   */
+  bool Save(const char* fileName) const {
+    std::ofstream file(fileName, std::ios::binary);
+    if(!file.is_open()) {
+      std::cerr << "CSRMatrix::Save: Unable to open file " << fileName << std::endl;
+      return false;
+    }
+    file.write(MAGIC, 8);
+    uint64_t header[4] = { _rows, _columns, nonZeros(), sizeof(T) };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    std::vector<uint64_t> buffer(indptr.begin(), indptr.end());
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(uint64_t));
+    buffer.assign(indices.begin(), indices.end());
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    return file.good();
+  }
+
+  /**
+   * Reads a matrix written by Save()
+   * @param fileName path of the input file
+   * @returns loaded matrix, empty 0 x 0 matrix on failure
+   */
+  static CSRMatrix Load(const char* fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file.is_open()) {
+      std::cerr << "CSRMatrix::Load: Unable to open file " << fileName << std::endl;
+      return {};
+    }
+    char magic[8];
+    uint64_t header[4];
+    file.read(magic, 8);
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if(!file.good() || std::memcmp(magic, MAGIC, 8) != 0 || header[3] != sizeof(T)) {
+      std::cerr << "CSRMatrix::Load: Invalid file format " << fileName << std::endl;
+      return {};
+    }
+    CSRMatrix out(header[0], header[1]);
+    std::vector<uint64_t> buffer(header[0] + 1);
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(uint64_t));
+    out.indptr.assign(buffer.begin(), buffer.end());
+    buffer.resize(header[2]);
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(uint64_t));
+    out.indices.assign(buffer.begin(), buffer.end());
+    out.values.resize(header[2]);
+    file.read(reinterpret_cast<char*>(out.values.data()), out.values.size() * sizeof(T));
+    if(!file.good() || out.indptr.back() != header[2]) {
+      std::cerr << "CSRMatrix::Load: Truncated file " << fileName << std::endl;
+      return {};
+    }
+    return out;
+  }
+
+private:
+  //! file signature of the binary format
+  static constexpr const char* MAGIC = "MATHCSR1";
+  //! number of rows
+  size_t _rows = 0;
+  //! number of columns
+  size_t _columns = 0;
+};
+
+/**
+ * Sparse matrix in compressed sparse column format.
+ *
+ * The row indices of column j are stored in indices[indptr[j]], ..., indices[indptr[j + 1] - 1].
+ * @tparam T value type
+ */
+template<typename T = double>
+class CSCMatrix
+{
+public:
+  //! column pointers, columns + 1 entries
+  std::vector<size_t> indptr;
+  //! row indices, sorted within every column
+  std::vector<size_t> indices;
+  //! non zero values
+  std::vector<T> values;
+
+  /**
+   * Creates empty (all zero) matrix of given dimension
+   * @param rows number of rows
+   * @param columns number of columns
+   */
+  CSCMatrix(size_t rows = 0, size_t columns = 0)
+    : indptr(columns + 1, 0)
+    , _rows(rows)
+    , _columns(columns) { }
+
+  /**
+   * Compresses a coordinate list, duplicates are summed up
+   * @param coo assembled matrix
+   */
+  explicit CSCMatrix(const COOMatrix<T>& coo)
+    : CSCMatrix(CSRMatrix<T>(coo).ToCSC()) { }
+
+  /**
+   * Compresses a dense matrix
+   * @param A dense matrix
+   * @param tolerance elements with absolute value <= tolerance are dropped
+   * @returns sparse representation of A
+   */
+  static CSCMatrix FromDense(const Matrix<T>& A, T tolerance = T(0)) { return CSRMatrix<T>::FromDense(A, tolerance).ToCSC(); }
+
+  /**
+   * row getter
+   * @returns number of rows
+   */
+  [[nodiscard]] inline size_t rows() const { return _rows; }
+  /**
+   * columns getter
+   * @returns number of columns
+   */
+  [[nodiscard]] inline size_t columns() const { return _columns; }
+  /**
+   * @returns number of stored elements
+   */
+  [[nodiscard]] inline size_t nonZeros() const { return values.size(); }
+
+  /**
+   * element access by binary search within column j
+   * @param i row index
+   * @param j column index
+   * @returns value at (i, j), 0 if not stored
+   */
+  T operator()(size_t i, size_t j) const {
+    assert(i < _rows && j < _columns);
+    auto first = indices.begin() + indptr[j];
+    auto last  = indices.begin() + indptr[j + 1];
+    auto it    = std::lower_bound(first, last, i);
+    if(it == last || *it != i) return T(0);
+    return values[it - indices.begin()];
+  }
+
+  /**
+   * Converts into dense representation
+   * @returns dense rows x columns matrix
+   */
+  [[nodiscard]] Matrix<T> ToDense() const {
+    Matrix<T> out(0, _rows, _columns);
+    for(size_t j = 0; j < _columns; ++j) {
+      for(size_t k = indptr[j]; k < indptr[j + 1]; ++k) { out(indices[k], j) = values[k]; }
+    }
+    return out;
+  }
+
+  /**
+   * Converts into compressed sparse row format
+   * @returns CSR representation
+   */
+  [[nodiscard]] CSRMatrix<T> ToCSR() const {
+    // the arrays of a CSC matrix are the CSR arrays of its transposed
+    CSRMatrix<T> transposed(_columns, _rows, indptr, indices, values);
+    return transposed.Transpose();
+  }
+
+  /**
+   * Transposition without moving data
+   * @returns transposed matrix in CSR format
+   */
+  [[nodiscard]] CSRMatrix<T> Transpose() const { return CSRMatrix<T>(_columns, _rows, indptr, indices, values); }
+
+private:
+  //! number of rows
+  size_t _rows = 0;
+  //! number of columns
+  size_t _columns = 0;
+};
+
+template<typename T>
+CSCMatrix<T> CSRMatrix<T>::ToCSC() const {
+  auto transposed = Transpose();
+  CSCMatrix<T> out(_rows, _columns);
+  out.indptr  = std::move(transposed.indptr);
+  out.indices = std::move(transposed.indices);
+  out.values  = std::move(transposed.values);
+  return out;
+}
+
+//! default sparse format used for computations
+template<typename T = double>
+using SparseMatrix = CSRMatrix<T>;
+
+/**
+ * Sparse Matrix-Matrix multiplication (SpMV for a single column), parallelized over the rows
+ * @param lhs sparse matrix with dimension n x k
+ * @param rhs dense matrix with dimension k x m
+ * @returns dense n x m result matrix
+ */
+template<typename T>
+inline Matrix<T> operator*(const CSRMatrix<T>& lhs, const Matrix<T>& rhs) {
+  assert(lhs.columns() == rhs.rows() && rhs.elements() == 1);
+  size_t m = rhs.columns();
+  Matrix<T> result(0, lhs.rows(), m);
+  if(lhs.rows() == 0 || m == 0) return result;
+  const T* x = &rhs(0, 0);
+  T* y       = &result(0, 0);
+  parallelFor(
+      0,
+      lhs.rows(),
+      [&](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          T* yi = y + i * m;
+          for(size_t k = lhs.indptr[i]; k < lhs.indptr[i + 1]; ++k) {
+            T a        = lhs.values[k];
+            const T* xk = x + lhs.indices[k] * m;
+            for(size_t c = 0; c < m; ++c) { yi[c] += a * xk[c]; }
+          }
+        }
+      },
+      std::max<size_t>(1, 16384 / (1 + (lhs.nonZeros() * m) / std::max<size_t>(1, lhs.rows()))));
+  return result;
+}
+
+/**
+ * Sparse Matrix-Matrix multiplication in CSC format, parallelized over the columns of rhs
+ * @param lhs sparse matrix with dimension n x k
+ * @param rhs dense matrix with dimension k x m
+ * @returns dense n x m result matrix
+ */
+template<typename T>
+inline Matrix<T> operator*(const CSCMatrix<T>& lhs, const Matrix<T>& rhs) {
+  assert(lhs.columns() == rhs.rows() && rhs.elements() == 1);
+  size_t m = rhs.columns();
+  Matrix<T> result(0, lhs.rows(), m);
+  if(lhs.rows() == 0 || m == 0) return result;
+  parallelFor(
+      0,
+      m,
+      [&](size_t begin, size_t end) {
+        for(size_t c = begin; c < end; ++c) {
+          for(size_t j = 0; j < lhs.columns(); ++j) {
+            T xj = rhs(j, c);
+            if(xj == T(0)) continue;
+            for(size_t k = lhs.indptr[j]; k < lhs.indptr[j + 1]; ++k) { result(lhs.indices[k], c) += lhs.values[k] * xj; }
+          }
+        }
+      },
+      1);
+  return result;
+}
+
+/**
+ * Sparse Matrix-Matrix multiplication (SpGEMM) using Gustavson's row-wise algorithm.
+ *
+ * Runs a symbolic pass counting the non zeros of every row followed by the numeric pass,
+ * both parallelized over the rows of lhs.
+ * @param lhs sparse matrix with dimension n x k
+ * @param rhs sparse matrix with dimension k x m
+ * @returns sparse n x m result
+ */
+template<typename T>
+inline CSRMatrix<T> operator*(const CSRMatrix<T>& lhs, const CSRMatrix<T>& rhs) {
+  assert(lhs.columns() == rhs.rows());
+  size_t n = lhs.rows(), m = rhs.columns();
+  CSRMatrix<T> result(n, m);
+  constexpr size_t UNSET = size_t(-1);
+
+  parallelFor(
+      0,
+      n,
+      [&](size_t begin, size_t end) {
+        std::vector<size_t> marker(m, UNSET);
+        for(size_t i = begin; i < end; ++i) {
+          size_t count = 0;
+          for(size_t a = lhs.indptr[i]; a < lhs.indptr[i + 1]; ++a) {
+            size_t k = lhs.indices[a];
+            for(size_t b = rhs.indptr[k]; b < rhs.indptr[k + 1]; ++b) {
+              if(marker[rhs.indices[b]] != i) {
+                marker[rhs.indices[b]] = i;
+                ++count;
+              }
+            }
+          }
+          result.indptr[i + 1] = count;
+        }
+      },
+      256);
+  std::partial_sum(result.indptr.begin(), result.indptr.end(), result.indptr.begin());
+  result.indices.resize(result.indptr[n]);
+  result.values.resize(result.indptr[n]);
+
+  parallelFor(
+      0,
+      n,
+      [&](size_t begin, size_t end) {
+        std::vector<size_t> marker(m, UNSET);
+        std::vector<T> accumulator(m, T(0));
+        for(size_t i = begin; i < end; ++i) {
+          size_t rowStart = result.indptr[i], p = rowStart;
+          for(size_t a = lhs.indptr[i]; a < lhs.indptr[i + 1]; ++a) {
+            size_t k = lhs.indices[a];
+            T v      = lhs.values[a];
+            for(size_t b = rhs.indptr[k]; b < rhs.indptr[k + 1]; ++b) {
+              size_t j = rhs.indices[b];
+              if(marker[j] != i) {
+                marker[j]           = i;
+                result.indices[p++] = j;
+                accumulator[j]      = v * rhs.values[b];
+              } else {
+                accumulator[j] += v * rhs.values[b];
+              }
+            }
+          }
+          std::sort(result.indices.begin() + rowStart, result.indices.begin() + p);
+          for(size_t q = rowStart; q < p; ++q) { result.values[q] = accumulator[result.indices[q]]; }
+        }
+      },
+      256);
+  return result;
+}
+
+/**
+ * Sparse matrix addition
+ * @param lhs sparse matrix
+ * @param rhs sparse matrix of same dimension
+ * @returns lhs + rhs
+ */
+template<typename T>
+inline CSRMatrix<T> operator+(const CSRMatrix<T>& lhs, const CSRMatrix<T>& rhs) {
+  return lhs.Combine(rhs, T(1), T(1));
+}
+
+/**
+ * Sparse matrix subtraction
+ * @param lhs sparse matrix
+ * @param rhs sparse matrix of same dimension
+ * @returns lhs - rhs
+ */
+template<typename T>
+inline CSRMatrix<T> operator-(const CSRMatrix<T>& lhs, const CSRMatrix<T>& rhs) {
+  return lhs.Combine(rhs, T(1), T(-1));
+}
+
+/**
+ * Sparse matrix scalar multiplication
+ * @param lambda scalar
+ * @param A sparse matrix
+ * @returns lambda * A
+ */
+template<typename T>
+inline CSRMatrix<T> operator*(T lambda, const CSRMatrix<T>& A) {
+  return A.Apply([lambda](T v) { return lambda * v; });
+}
+
+/**
+ * Sparse matrix scalar multiplication
+ * @param A sparse matrix
+ * @param lambda scalar
+ * @returns A * lambda
+ */
+template<typename T>
+inline CSRMatrix<T> operator*(const CSRMatrix<T>& A, T lambda) {
+  return lambda * A;
+}
+
+/**
+ * Kronecker product of two sparse matrices, e.g. to assemble multi dimensional stencils
+ * $$A \otimes B = (a_{ij} B)_{ij}$$
+ * @param A sparse matrix with dimension n x m
+ * @param B sparse matrix with dimension p x q
+ * @returns sparse (n * p) x (m * q) matrix
+ */
+template<typename T>
+inline CSRMatrix<T> kron(const CSRMatrix<T>& A, const CSRMatrix<T>& B) {
+  size_t p = B.rows(), q = B.columns();
+  CSRMatrix<T> out(A.rows() * p, A.columns() * q);
+  out.indices.reserve(A.nonZeros() * B.nonZeros());
+  out.values.reserve(A.nonZeros() * B.nonZeros());
+  for(size_t i = 0; i < A.rows(); ++i) {
+    for(size_t r = 0; r < p; ++r) {
+      for(size_t a = A.indptr[i]; a < A.indptr[i + 1]; ++a) {
+        for(size_t b = B.indptr[r]; b < B.indptr[r + 1]; ++b) {
+          out.indices.push_back(A.indices[a] * q + B.indices[b]);
+          out.values.push_back(A.values[a] * B.values[b]);
+        }
+      }
+      out.indptr[i * p + r + 1] = out.indices.size();
+    }
+  }
+  return out;
+}
+
+/**
+ * \example numerics/lin_alg/TestSparseMatrix.cpp
+ * This is an example on how to use the sparse matrix formats.
+ */
@@ -15,13 +15,16 @@
 
 #pragma once
 #include "../utils.h"
+#include "trsm.h"
 #include <iostream>
 #include <vector>
 
 /**
- * Backward-substitution
+ * Backward-substitution with upper triangular matrix, the strictly lower part of R is not accessed.
+ *
+ * All columns of b are solved at once by trsm().
  * @param R Coefficient matrix
- * @param b result vector
+ * @param b result vector(s)
  * @returns z
  */
 Matrix<double> backwardSub(const Matrix<double>& R, const Matrix<double>& b) {
@@ -29,7 +32,7 @@ Matrix<double> backwardSub(const Matrix<double>& R, const Matrix<double>& b) {
   size_t n  = R.columns();
   size_t v  = b.rows();
   size_t nv = b.columns();
-  if(v != m) {
+  if(v != m || nv == 0) {
     // Error, cannot compute
     std::cout << "Matrix vector dimension miss match, error!\n";
     return Matrix<double>();
@@ -40,16 +43,8 @@ Matrix<double> backwardSub(const Matrix<double>& R, const Matrix<double>& b) {
     return Matrix<double>();
   }
 
-  auto x = zeros(v, nv);
-
-  if(R(m - 1, n - 1) != 0) { x.SetRow(v - 1, b(v - 1) * (1 / R(m - 1, n - 1))); }
-
-  for(int j = (int)m - 2; j >= 0; j--) {
-    double s_k = 0.0f;
-    for(size_t k = j + 1; k < m; k++) { s_k += (R(j, k) * x(k, 0)); }
-    for(size_t i = 0; i < nv; ++i) { x(j, i) = (b(j, i) - s_k) / R(j, j); }
-  }
-
+  auto x = b;
+  trsm(R, x, UPPER_TRIANGULAR);
   return x;
 }
 /**
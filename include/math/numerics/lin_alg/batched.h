@@ -0,0 +1,247 @@
+/**
+ * @file batched.h
+ *
+ * Batched linear algebra for thousands of independent small systems.
+ *
+ * A BatchedMatrix stores `count` matrices of equal size interleaved: all values of element (i, j)
+ * are contiguous, one per system. Every kernel loops over the systems in its innermost loop,
+ * hence the SIMD lanes process different systems and no per system allocation is required.
+ *
+ * Usage:
+ * \code
+ * BatchedMatrix<double> A(count, 2, 2), b(count, 2, 1);
+ * // fill A(s, i, j), b(s, i, 0) for every system s
+ * auto regular = batchedLUSolve(A, b); // b(s, :, 0) holds the solution of system s
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/batched.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/**
+ * Stack of `count` rows x columns matrices, element (i, j) of system s is stored at
+ * data[(i * columns + j) * count + s].
+ * @tparam T value type
+ */
+template<typename T = double>
+class BatchedMatrix
+{
+public:
+  /**
+   * Creates batch of matrices
+   * @param count number of systems
+   * @param rows number of rows of every matrix
+   * @param columns number of columns of every matrix
+   * @param val initial value
+   */
+  BatchedMatrix(size_t count = 0, size_t rows = 0, size_t columns = 0, T val = 0)
+    : _count(count)
+    , _rows(rows)
+    , _columns(columns)
+    , _data(count * rows * columns, val) { }
+
+  /**
+   * @returns number of systems
+   */
+  [[nodiscard]] inline size_t count() const { return _count; }
+  /**
+   * row getter
+   * @returns number of rows of every matrix
+   */
+  [[nodiscard]] inline size_t rows() const { return _rows; }
+  /**
+   * columns getter
+   * @returns number of columns of every matrix
+   */
+  [[nodiscard]] inline size_t columns() const { return _columns; }
+
+  /**
+   * element access
+   * @param s system index
+   * @param i row index
+   * @param j column index
+   * @returns element (i, j) of system s
+   */
+  inline T& operator()(size_t s, size_t i, size_t j) { return _data[(i * _columns + j) * _count + s]; }
+  /**
+   * const element access
+   * @param s system index
+   * @param i row index
+   * @param j column index
+   * @returns element (i, j) of system s
+   */
+  inline const T& operator()(size_t s, size_t i, size_t j) const { return _data[(i * _columns + j) * _count + s]; }
+
+  /**
+   * @param i row index
+   * @param j column index
+   * @returns pointer to the contiguous values of element (i, j) of all systems
+   */
+  inline T* lane(size_t i, size_t j) { return &_data[(i * _columns + j) * _count]; }
+  /**
+   * @param i row index
+   * @param j column index
+   * @returns pointer to the contiguous values of element (i, j) of all systems
+   */
+  inline const T* lane(size_t i, size_t j) const { return &_data[(i * _columns + j) * _count]; }
+
+  /**
+   * Copies a single system into the batch
+   * @param s system index
+   * @param A rows x columns matrix
+   */
+  void Set(size_t s, const Matrix<T>& A) {
+    assert(A.rows() == _rows && A.columns() == _columns);
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t j = 0; j < _columns; ++j) { (*this)(s, i, j) = A(i, j); }
+    }
+  }
+
+  /**
+   * Extracts a single system
+   * @param s system index
+   * @returns rows x columns matrix
+   */
+  [[nodiscard]] Matrix<T> Get(size_t s) const {
+    Matrix<T> out(0, _rows, _columns);
+    for(size_t i = 0; i < _rows; ++i) {
+      for(size_t j = 0; j < _columns; ++j) { out(i, j) = (*this)(s, i, j); }
+    }
+    return out;
+  }
+
+private:
+  //! number of systems
+  size_t _count;
+  //! rows of every matrix
+  size_t _rows;
+  //! columns of every matrix
+  size_t _columns;
+  //! interleaved values
+  std::vector<T> _data;
+};
+
+/**
+ * Batched matrix-matrix multiplication $$C_s = \alpha A_s B_s + \beta C_s$$ for every system s
+ * @param A batch of m x k matrices
+ * @param B batch of k x n matrices
+ * @param C batch of m x n matrices, overwritten
+ * @param alpha factor of the product
+ * @param beta factor of C
+ */
+template<typename T>
+void batchedGemm(const BatchedMatrix<T>& A, const BatchedMatrix<T>& B, BatchedMatrix<T>& C, T alpha = T(1), T beta = T(0)) {
+  assert(A.count() == B.count() && A.count() == C.count());
+  assert(A.columns() == B.rows() && A.rows() == C.rows() && B.columns() == C.columns());
+  size_t m = A.rows(), k = A.columns(), n = B.columns();
+  parallelFor(
+      0,
+      A.count(),
+      [&](size_t begin, size_t end) {
+        for(size_t i = 0; i < m; ++i) {
+          for(size_t j = 0; j < n; ++j) {
+            T* c = C.lane(i, j);
+            for(size_t s = begin; s < end; ++s) { c[s] *= beta; }
+            for(size_t p = 0; p < k; ++p) {
+              const T* a = A.lane(i, p);
+              const T* b = B.lane(p, j);
+              for(size_t s = begin; s < end; ++s) { c[s] += alpha * a[s] * b[s]; }
+            }
+          }
+        }
+      },
+      4096);
+}
+
+/**
+ * Solves $$A_s X_s = B_s$$ for every system s by LU decomposition with partial pivoting.
+ *
+ * Both batches are overwritten: A by the LU factors of the row-permuted systems and B by the
+ * solutions. Pivot rows are selected per system, singular systems (zero pivot) are flagged and
+ * leave non-finite values in their solution.
+ *
+ * @param A batch of n x n coefficient matrices
+ * @param B batch of n x nrhs right hand sides
+ * @returns per system flag, true if the system is regular
+ */
+template<typename T>
+std::vector<bool> batchedLUSolve(BatchedMatrix<T>& A, BatchedMatrix<T>& B) {
+  assert(A.count() == B.count() && A.rows() == A.columns() && A.rows() == B.rows());
+  size_t count = A.count(), n = A.rows(), nrhs = B.columns();
+  std::vector<unsigned char> regular(count, 1);
+
+  parallelFor(
+      0,
+      count,
+      [&](size_t begin, size_t end) {
+        std::vector<size_t> pivot(end - begin);
+        for(size_t k = 0; k < n; ++k) {
+          // pivot search, per system
+          const T* akk = A.lane(k, k);
+          for(size_t s = begin; s < end; ++s) {
+            size_t p = k;
+            T maxVal = std::abs(akk[s]);
+            for(size_t i = k + 1; i < n; ++i) {
+              T v = std::abs(A(s, i, k));
+              if(v > maxVal) {
+                maxVal = v;
+                p      = i;
+              }
+            }
+            pivot[s - begin] = p;
+            if(maxVal == T(0)) regular[s] = 0;
+          }
+          // row interchange
+          for(size_t s = begin; s < end; ++s) {
+            size_t p = pivot[s - begin];
+            if(p == k) continue;
+            for(size_t j = 0; j < n; ++j) { std::swap(A(s, k, j), A(s, p, j)); }
+            for(size_t j = 0; j < nrhs; ++j) { std::swap(B(s, k, j), B(s, p, j)); }
+          }
+          // elimination, vectorized over the systems
+          for(size_t i = k + 1; i < n; ++i) {
+            T* aik = A.lane(i, k);
+            for(size_t s = begin; s < end; ++s) { aik[s] /= akk[s]; }
+            for(size_t j = k + 1; j < n; ++j) {
+              T* aij       = A.lane(i, j);
+              const T* akj = A.lane(k, j);
+              for(size_t s = begin; s < end; ++s) { aij[s] -= aik[s] * akj[s]; }
+            }
+            for(size_t j = 0; j < nrhs; ++j) {
+              T* bij       = B.lane(i, j);
+              const T* bkj = B.lane(k, j);
+              for(size_t s = begin; s < end; ++s) { bij[s] -= aik[s] * bkj[s]; }
+            }
+          }
+        }
+        // backward substitution
+        for(size_t i = n; i-- > 0;) {
+          const T* aii = A.lane(i, i);
+          for(size_t j = 0; j < nrhs; ++j) {
+            T* bij = B.lane(i, j);
+            for(size_t p = i + 1; p < n; ++p) {
+              const T* aip = A.lane(i, p);
+              const T* bpj = B.lane(p, j);
+              for(size_t s = begin; s < end; ++s) { bij[s] -= aip[s] * bpj[s]; }
+            }
+            for(size_t s = begin; s < end; ++s) { bij[s] /= aii[s]; }
+          }
+        }
+      },
+      4096);
+  return std::vector<bool>(regular.begin(), regular.end());
+}
+
+/**
+ * \example numerics/lin_alg/TestBatched.cpp
+ * This is an example on how to use the batched kernels.
+ */
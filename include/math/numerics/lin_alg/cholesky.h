@@ -0,0 +1,406 @@
+/**
+ * @file cholesky.h
+ *
+ * Factorizations of symmetric matrices.
+ *
+ * - Cholesky: blocked factorization of symmetric positive definite matrices
+ * $$
+ * A = L \cdot L^T
+ * $$
+ * - LDLT: Bunch-Kaufman factorization of symmetric (indefinite) matrices
+ * $$
+ * P A P^T = L \cdot D \cdot L^T
+ * $$
+ * with unit lower triangular L and block diagonal D (1x1 and 2x2 blocks).
+ *
+ * Both require half the flops of LU() and store the factor for repeated solves.
+ *
+ * Usage:
+ * \code
+ * Cholesky chol(A);
+ * auto x = chol.solve(b);
+ * chol.update(v); // factor of A + v * v^T
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/cholesky.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../utils.h"
+#include "trsm.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Cholesky factorization $$A = L L^T$$ of a symmetric positive definite matrix
+ */
+class Cholesky
+{
+public:
+  //! lower triangular factor
+  Matrix<double> L;
+  //! false if the factorized matrix was not (numerically) positive definite
+  bool isPositiveDefinite = false;
+
+  /**
+   * Default constructor
+   */
+  Cholesky() { }
+
+  /**
+   * Factorizes given matrix
+   * @param A symmetric positive definite matrix, only the lower triangle is accessed
+   * @param blockSize size of the diagonal blocks used by the blocked algorithm
+   */
+  explicit Cholesky(const Matrix<double>& A, size_t blockSize = 64) { factorize(A, blockSize); }
+
+  /**
+   * Right-looking blocked Cholesky factorization.
+   *
+   * Each step factorizes a diagonal block, solves the panel below it and applies a symmetric
+   * rank-k update to the trailing matrix. All inner loops are dot products of contiguous rows.
+   *
+   * @param A symmetric positive definite matrix, only the lower triangle is accessed
+   * @param blockSize size of the diagonal blocks
+   * @returns true on success, false if A is not positive definite
+   */
+  bool factorize(const Matrix<double>& A, size_t blockSize = 64) {
+    assert(A.rows() == A.columns());
+    size_t n = A.rows();
+    L        = A;
+    double* a = &L(0, 0);
+    if(blockSize == 0) blockSize = 1;
+
+    isPositiveDefinite = true;
+    for(size_t k0 = 0; k0 < n && isPositiveDefinite; k0 += blockSize) {
+      size_t k1 = k0 + blockSize < n ? k0 + blockSize : n;
+
+      // diagonal block and panel below it
+      for(size_t j = k0; j < k1; ++j) {
+        double* rowJ = a + j * n;
+        double d     = rowJ[j];
+        for(size_t p = k0; p < j; ++p) { d -= rowJ[p] * rowJ[p]; }
+        if(!(d > 0.0)) {
+          isPositiveDefinite = false;
+          break;
+        }
+        d       = std::sqrt(d);
+        rowJ[j] = d;
+        for(size_t i = j + 1; i < n; ++i) {
+          double* rowI = a + i * n;
+          double s     = rowI[j];
+          for(size_t p = k0; p < j; ++p) { s -= rowI[p] * rowJ[p]; }
+          rowI[j] = s / d;
+        }
+      }
+      if(!isPositiveDefinite) break;
+
+      // symmetric rank-k update of the trailing matrix
+      for(size_t i = k1; i < n; ++i) {
+        double* rowI = a + i * n;
+        for(size_t j = k1; j <= i; ++j) {
+          const double* rowJ = a + j * n;
+          double s           = 0.0;
+          for(size_t p = k0; p < k1; ++p) { s += rowI[p] * rowJ[p]; }
+          rowI[j] -= s;
+        }
+      }
+    }
+
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = i + 1; j < n; ++j) { a[i * n + j] = 0.0; }
+    }
+    return isPositiveDefinite;
+  }
+
+  /**
+   * Solves $$A X = B$$ using the stored factor
+   * @param b right hand side(s), n x nrhs
+   * @returns X
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    assert(b.rows() == L.rows());
+    auto x = b;
+    // L y = b, L^T x = y
+    trsm(L, x, LOWER_TRIANGULAR);
+    trsm(L, x, LOWER_TRIANGULAR, true);
+    return x;
+  }
+
+  /**
+   * Logarithm of the determinant $$\log\det A = 2\sum\log l_{ii}$$
+   * @returns log-determinant of the factorized matrix
+   */
+  [[nodiscard]] double logDet() const {
+    double out = 0.0;
+    for(size_t i = 0; i < L.rows(); ++i) { out += std::log(L(i, i)); }
+    return 2.0 * out;
+  }
+
+  /**
+   * Rank-1 update, transforms the factor of A into the factor of $$A + x x^T$$ in O(n^2)
+   * @param x vector with n elements
+   */
+  void update(const Matrix<double>& x) { rankOne(x, 1.0); }
+
+  /**
+   * Rank-1 downdate, transforms the factor of A into the factor of $$A - x x^T$$ in O(n^2)
+   * @param x vector with n elements
+   * @returns false if the downdated matrix is not positive definite, the factor stays untouched then
+   */
+  bool downdate(const Matrix<double>& x) { return rankOne(x, -1.0); }
+
+private:
+  /**
+   * Shared implementation of update (sign = 1) and downdate (sign = -1)
+   */
+  bool rankOne(const Matrix<double>& x, double sign) {
+    size_t n = L.rows();
+    assert(x.IsVector() && x.elements_total() == n);
+    auto factor = L;
+    double* l   = &factor(0, 0);
+    std::vector<double> w(&x(0, 0), &x(0, 0) + n);
+
+    for(size_t k = 0; k < n; ++k) {
+      double lkk = l[k * n + k];
+      double r2  = lkk * lkk + sign * w[k] * w[k];
+      if(!(r2 > 0.0)) { return false; }
+      double r = std::sqrt(r2);
+      double c = r / lkk;
+      double s = w[k] / lkk;
+
+      l[k * n + k] = r;
+      for(size_t i = k + 1; i < n; ++i) {
+        l[i * n + k] = (l[i * n + k] + sign * s * w[i]) / c;
+        w[i]         = c * w[i] - s * l[i * n + k];
+      }
+    }
+    L = factor;
+    return true;
+  }
+};
+
+/**
+ * Bunch-Kaufman factorization $$P A P^T = L D L^T$$ of a symmetric, possibly indefinite, matrix.
+ *
+ * Uses symmetric pivoting with 1x1 and 2x2 diagonal blocks, which keeps the factorization stable
+ * without destroying symmetry.
+ */
+class LDLT
+{
+public:
+  //! unit lower triangular factor
+  Matrix<double> L;
+  //! block diagonal factor with 1x1 and 2x2 blocks
+  Matrix<double> D;
+  //! symmetric permutation, row i of P A P^T is row perm[i] of A
+  std::vector<size_t> perm;
+  //! size of the diagonal block starting at index i (1 or 2, 0 for the second row of a 2x2 block)
+  std::vector<int> blockSize;
+  //! false if D is singular
+  bool isRegular = false;
+
+  /**
+   * Default constructor
+   */
+  LDLT() { }
+
+  /**
+   * Factorizes given matrix
+   * @param A symmetric matrix, only the lower triangle is accessed
+   */
+  explicit LDLT(const Matrix<double>& A) { factorize(A); }
+
+  /**
+   * Bunch-Kaufman partial pivoting factorization
+   * @param A symmetric matrix, only the lower triangle is accessed
+   * @returns true if D is regular
+   */
+  bool factorize(const Matrix<double>& A) {
+    assert(A.rows() == A.columns());
+    const double alpha = (1.0 + std::sqrt(17.0)) / 8.0;
+    size_t n           = A.rows();
+
+    // work on a full symmetric copy
+    Matrix<double> W = A;
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = i + 1; j < n; ++j) { W(i, j) = W(j, i); }
+    }
+    perm.resize(n);
+    blockSize.assign(n, 1);
+    for(size_t i = 0; i < n; ++i) { perm[i] = i; }
+    isRegular = true;
+
+    auto interchange = [&](size_t k, size_t r, size_t s) {
+      if(r == s) return;
+      // rows of the already computed part of L
+      for(size_t j = 0; j < k; ++j) { std::swap(W(r, j), W(s, j)); }
+      // rows and columns of the trailing matrix
+      for(size_t j = k; j < n; ++j) { std::swap(W(r, j), W(s, j)); }
+      for(size_t i = k; i < n; ++i) { std::swap(W(i, r), W(i, s)); }
+      std::swap(perm[r], perm[s]);
+    };
+
+    size_t k = 0;
+    while(k < n) {
+      double absakk = std::abs(W(k, k));
+      size_t imax   = k;
+      double colmax = 0.0;
+      for(size_t i = k + 1; i < n; ++i) {
+        if(std::abs(W(i, k)) > colmax) {
+          colmax = std::abs(W(i, k));
+          imax   = i;
+        }
+      }
+
+      size_t step = 1;
+      if(absakk == 0.0 && colmax == 0.0) {
+        isRegular = false;
+        k++;
+        continue;
+      }
+      if(absakk < alpha * colmax) {
+        double rowmax = 0.0;
+        for(size_t j = k; j < n; ++j) {
+          if(j != imax && std::abs(W(imax, j)) > rowmax) rowmax = std::abs(W(imax, j));
+        }
+        if(absakk >= alpha * colmax * (colmax / rowmax)) {
+          // no interchange, 1x1 pivot
+        } else if(std::abs(W(imax, imax)) >= alpha * rowmax) {
+          interchange(k, k, imax);
+        } else {
+          interchange(k, k + 1, imax);
+          step = 2;
+        }
+      }
+
+      if(step == 1) {
+        double d = W(k, k);
+        for(size_t j = k + 1; j < n; ++j) {
+          double ljk = W(j, k) / d;
+          for(size_t i = j; i < n; ++i) {
+            W(i, j) -= W(i, k) * ljk;
+            W(j, i) = W(i, j);
+          }
+        }
+        for(size_t i = k + 1; i < n; ++i) { W(i, k) /= d; }
+      } else {
+        double d11 = W(k, k), d21 = W(k + 1, k), d22 = W(k + 1, k + 1);
+        double det = d11 * d22 - d21 * d21;
+        if(det == 0.0) { isRegular = false; }
+        // columns of L for the 2x2 block: [l_k, l_k+1] = [a_k, a_k+1] * D^{-1}
+        for(size_t j = k + 2; j < n; ++j) {
+          double ajk = W(j, k), ajk1 = W(j, k + 1);
+          double wk  = (d22 * ajk - d21 * ajk1) / det;
+          double wk1 = (d11 * ajk1 - d21 * ajk) / det;
+          for(size_t i = j; i < n; ++i) {
+            W(i, j) -= W(i, k) * wk + W(i, k + 1) * wk1;
+            W(j, i) = W(i, j);
+          }
+          W(j, k)     = wk;
+          W(j, k + 1) = wk1;
+        }
+        blockSize[k]     = 2;
+        blockSize[k + 1] = 0;
+      }
+      k += step;
+    }
+
+    L = eye(n);
+    D = zeros(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      if(blockSize[i] == 2) {
+        D(i, i)         = W(i, i);
+        D(i + 1, i)     = W(i + 1, i);
+        D(i, i + 1)     = W(i + 1, i);
+        D(i + 1, i + 1) = W(i + 1, i + 1);
+      } else if(blockSize[i] == 1) {
+        D(i, i) = W(i, i);
+        if(D(i, i) == 0.0) isRegular = false;
+      }
+      for(size_t j = 0; j < i; ++j) {
+        if(!(blockSize[j] == 2 && i == j + 1)) L(i, j) = W(i, j);
+      }
+    }
+    return isRegular;
+  }
+
+  /**
+   * Solves $$A X = B$$ using the stored factorization
+   * @param b right hand side(s), n x nrhs
+   * @returns X
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    size_t n = L.rows(), nrhs = b.columns();
+    assert(b.rows() == n);
+    Matrix<double> y(0, n, nrhs);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t c = 0; c < nrhs; ++c) { y(i, c) = b(perm[i], c); }
+    }
+    // L z = P b
+    trsm(L, y, LOWER_TRIANGULAR, false, UNIT_DIAGONAL);
+    // D w = z
+    for(size_t i = 0; i < n; ++i) {
+      if(blockSize[i] == 1) {
+        for(size_t c = 0; c < nrhs; ++c) { y(i, c) /= D(i, i); }
+      } else if(blockSize[i] == 2) {
+        double d11 = D(i, i), d21 = D(i + 1, i), d22 = D(i + 1, i + 1);
+        double det = d11 * d22 - d21 * d21;
+        for(size_t c = 0; c < nrhs; ++c) {
+          double z1 = y(i, c), z2 = y(i + 1, c);
+          y(i, c)     = (d22 * z1 - d21 * z2) / det;
+          y(i + 1, c) = (d11 * z2 - d21 * z1) / det;
+        }
+      }
+    }
+    // L^T v = w
+    trsm(L, y, LOWER_TRIANGULAR, true, UNIT_DIAGONAL);
+    Matrix<double> x(0, n, nrhs);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t c = 0; c < nrhs; ++c) { x(perm[i], c) = y(i, c); }
+    }
+    return x;
+  }
+
+  /**
+   * Logarithm of the absolute value of the determinant, $$\log|\det A| = \sum \log|\det D_i|$$
+   * @returns log of the absolute determinant
+   */
+  [[nodiscard]] double logAbsDet() const {
+    double out = 0.0;
+    for(size_t i = 0; i < D.rows(); ++i) {
+      if(blockSize[i] == 1) out += std::log(std::abs(D(i, i)));
+      else if(blockSize[i] == 2)
+        out += std::log(std::abs(D(i, i) * D(i + 1, i + 1) - D(i + 1, i) * D(i + 1, i)));
+    }
+    return out;
+  }
+
+  /**
+   * Sign of the determinant of the factorized matrix
+   * @returns -1, 0 or 1
+   */
+  [[nodiscard]] int detSign() const {
+    int sign = 1;
+    for(size_t i = 0; i < D.rows(); ++i) {
+      double d = 0.0;
+      if(blockSize[i] == 1) d = D(i, i);
+      else if(blockSize[i] == 2)
+        d = D(i, i) * D(i + 1, i + 1) - D(i + 1, i) * D(i + 1, i);
+      else
+        continue;
+      if(d == 0.0) return 0;
+      if(d < 0.0) sign = -sign;
+    }
+    return sign;
+  }
+};
+
+/**
+ * \example numerics/lin_alg/TestCholesky.cpp
+ * This is an example on how to use the Cholesky and LDLT factorizations.
+ */
@@ -0,0 +1,226 @@
+/**
+ * @file expm.h
+ *
+ * Matrix exponential and its action on vectors.
+ *
+ * - expm(): scaling and squaring with a Padé approximant of degree 3, 5, 7, 9 or 13 chosen from the
+ *   1-norm of A (Higham, "The scaling and squaring method for the matrix exponential revisited").
+ * - phi(): $$\varphi_k(A)$$, e.g. $$\varphi_1(A) = A^{-1}(e^A - I)$$, via the exponential of an
+ *   augmented matrix, used by the exponential integrators in ode/odeExponential.h.
+ * - expmv(): $$e^{tA} v$$ for large or sparse A by Krylov (Arnoldi) approximation, only matrix-vector
+ *   products with A are required. The time interval is split into substeps whenever the a posteriori
+ *   error estimate exceeds the tolerance.
+ *
+ * Usage:
+ * \code
+ * auto E = expm(A);
+ * auto w = expmv(asOperator(sparseA), v, 0.5); // exp(0.5 A) v
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/expm.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../utils.h"
+#include "LU.h"
+#include "LinearOperator.h"
+#include "gemm.h"
+#include "krylov.h"
+#include <cmath>
+#include <vector>
+
+namespace expm_detail {
+/**
+ * 1-norm (maximum absolute column sum)
+ */
+inline double norm1(const Matrix<double>& A) {
+  std::vector<double> sums(A.columns(), 0.0);
+  for(size_t i = 0; i < A.rows(); ++i) {
+    for(size_t j = 0; j < A.columns(); ++j) { sums[j] += std::abs(A(i, j)); }
+  }
+  double out = 0;
+  for(auto s : sums) { out = std::max(out, s); }
+  return out;
+}
+
+/**
+ * sum_k c[k] * P[k] + c0 * I
+ */
+inline Matrix<double> combine(double c0, const std::vector<double>& c, const std::vector<const Matrix<double>*>& P) {
+  size_t n = P[0]->rows();
+  Matrix<double> out(0, n, n);
+  for(size_t k = 0; k < P.size(); ++k) {
+    const double* p = &(*P[k])(0, 0);
+    double* o       = &out(0, 0);
+    for(size_t i = 0; i < n * n; ++i) { o[i] += c[k] * p[i]; }
+  }
+  for(size_t i = 0; i < n; ++i) { out(i, i) += c0; }
+  return out;
+}
+} // namespace expm_detail
+
+/**
+ * Matrix exponential by scaling and squaring with Padé approximation
+ * @param A square matrix
+ * @returns $$e^A$$
+ */
+inline Matrix<double> expm(const Matrix<double>& A) {
+  size_t n = A.rows();
+  if(n != A.columns()) {
+    std::cerr << "expm: matrix has to be square" << std::endl;
+    return Matrix<double>();
+  }
+  if(n == 0) return A;
+  using expm_detail::combine;
+
+  // maximal 1-norms for the Padé degrees 3, 5, 7, 9 and 13
+  const double theta[]   = { 1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1, 2.097847961257068 };
+  const size_t degrees[] = { 3, 5, 7, 9 };
+  const double theta13   = 5.371920351148152;
+  const std::vector<std::vector<double>> coefficients = {
+    { 120, 60, 12, 1 },
+    { 30240, 15120, 3360, 420, 30, 1 },
+    { 17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1 },
+    { 17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160, 110880, 3960, 90, 1 }
+  };
+  double a1 = expm_detail::norm1(A);
+
+  Matrix<double> U, V;
+  int squarings = 0;
+  auto A2       = multiply(A, A);
+  bool done     = false;
+  for(size_t d = 0; d < 4 && !done; ++d) {
+    if(a1 > theta[d]) continue;
+    // powers A^2 ... A^{degree - 1}, b holds the coefficients of degree degrees[d]
+    const auto& b = coefficients[d];
+    std::vector<Matrix<double>> powers = { A2 };
+    for(size_t p = 4; p < degrees[d]; p += 2) { powers.push_back(multiply(powers.back(), A2)); }
+    std::vector<double> odd, even;
+    std::vector<const Matrix<double>*> P;
+    for(size_t k = 0; k < powers.size(); ++k) {
+      odd.push_back(b[2 * k + 3]);
+      even.push_back(b[2 * k + 2]);
+      P.push_back(&powers[k]);
+    }
+    U    = multiply(A, combine(b[1], odd, P));
+    V    = combine(b[0], even, P);
+    done = true;
+  }
+  if(!done) {
+    const double b[] = { 64764752532480000., 32382376266240000., 7771770303897600., 1187353796428800.,
+                         129060195264000.,   10559470521600.,    670442572800.,     33522128640.,
+                         1323241920.,        40840800.,          960960.,           16380.,
+                         182.,               1. };
+    squarings    = std::max(0, (int)std::ceil(std::log2(a1 / theta13)));
+    double scale = std::pow(2.0, -squarings);
+    auto As      = A * scale;
+    auto B2      = A2 * (scale * scale);
+    auto B4      = multiply(B2, B2);
+    auto B6      = multiply(B4, B2);
+    auto U1      = multiply(B6, combine(0, { b[13], b[11], b[9] }, { &B6, &B4, &B2 }));
+    auto U2      = combine(b[1], { b[7], b[5], b[3] }, { &B6, &B4, &B2 });
+    U            = multiply(As, U1 + U2);
+    auto V1      = multiply(B6, combine(0, { b[12], b[10], b[8] }, { &B6, &B4, &B2 }));
+    V            = V1 + combine(b[0], { b[6], b[4], b[2] }, { &B6, &B4, &B2 });
+  }
+
+  // (V - U) E = (V + U)
+  auto E = luSolve(LU(V - U), V + U);
+  for(int s = 0; s < squarings; ++s) { E = multiply(E, E); }
+  return E;
+}
+
+/**
+ * Exponential and phi-functions $$\varphi_0 = e^A, \quad \varphi_{k+1}(A) = A^{-1}(\varphi_k(A) - I / k!)$$
+ * used by exponential integrators, all taken from the first block row of the exponential of
+ * $$\begin{pmatrix} A & I & & \\ & 0 & I & \\ & & \ddots & I \\ & & & 0 \end{pmatrix}$$
+ * @param A square matrix
+ * @param p highest phi-function
+ * @returns $$\varphi_0(A), \dots, \varphi_p(A)$$
+ */
+inline std::vector<Matrix<double>> phi(const Matrix<double>& A, size_t p) {
+  size_t n = A.rows();
+  if(n == 0) return std::vector<Matrix<double>>(p + 1, A);
+  Matrix<double> M(0, (p + 1) * n, (p + 1) * n);
+  for(size_t i = 0; i < n; ++i) {
+    for(size_t j = 0; j < n; ++j) { M(i, j) = A(i, j); }
+    for(size_t b = 0; b < p; ++b) { M(b * n + i, (b + 1) * n + i) = 1.0; }
+  }
+  auto E = expm(M);
+  std::vector<Matrix<double>> out;
+  for(size_t b = 0; b <= p; ++b) { out.push_back(E.GetSlice(0, n - 1, b * n, (b + 1) * n - 1)); }
+  return out;
+}
+
+/**
+ * Action of the matrix exponential on a vector by Krylov approximation
+ * @param A linear operator, see asOperator()
+ * @param v column vector
+ * @param t time, computes $$e^{tA} v$$
+ * @param m dimension of the Krylov subspaces
+ * @param TOL tolerance of the error estimate per unit time, relative to the norm of v
+ * @returns $$e^{tA} v$$
+ */
+inline Matrix<double> expmv(const LinearOperator& A, const Matrix<double>& v, double t = 1.0, size_t m = 30,
+                            double TOL = 1e-12) {
+  size_t n = v.rows();
+  m        = std::max<size_t>(1, std::min(m, n));
+  auto w   = v;
+
+  double done = 0, tau = t, vNorm = norm(v);
+  if(t == 0 || vNorm == 0) return w;
+
+  while(std::abs(done) < std::abs(t)) {
+    double beta = norm(w);
+    if(beta == 0) break;
+
+    // Arnoldi with modified Gram-Schmidt
+    std::vector<Matrix<double>> basis = { w * (1.0 / beta) };
+    Matrix<double> H(0, m + 1, m);
+    size_t k       = m;
+    bool breakdown = false;
+    for(size_t j = 0; j < m; ++j) {
+      auto p = A(basis[j]);
+      for(size_t i = 0; i <= j; ++i) {
+        H(i, j) = krylov::dot(basis[i], p);
+        krylov::axpy(-H(i, j), basis[i], p);
+      }
+      H(j + 1, j) = norm(p);
+      if(H(j + 1, j) <= 1e-12 * beta) {
+        k         = j + 1;
+        breakdown = true;
+        break;
+      }
+      basis.push_back(p * (1.0 / H(j + 1, j)));
+    }
+
+    // largest substep with acceptable error, the basis is independent of the step size
+    tau = std::abs(tau) > std::abs(t - done) ? t - done : tau;
+    Matrix<double> E;
+    while(true) {
+      Matrix<double> Hk(0, k, k);
+      for(size_t i = 0; i < k; ++i) {
+        for(size_t j = 0; j < k; ++j) { Hk(i, j) = tau * H(i, j); }
+      }
+      E            = expm(Hk);
+      double error = breakdown ? 0.0 : beta * std::abs(tau * H(k, k - 1) * E(k - 1, 0));
+      if(error <= TOL * std::abs(tau) * std::max(vNorm, 1.0) || std::abs(tau) < 1e-14 * std::abs(t)) break;
+      tau *= 0.5;
+    }
+
+    w = Matrix<double>(0, n, 1);
+    for(size_t i = 0; i < k; ++i) { krylov::axpy(beta * E(i, 0), basis[i], w); }
+    done += tau;
+    tau *= 2;
+  }
+  return w;
+}
+
+/**
+ * \example numerics/lin_alg/TestExpm.cpp
+ * This is an example on how to use expm and expmv.
+ */
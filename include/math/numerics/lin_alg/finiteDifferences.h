@@ -0,0 +1,147 @@
+/**
+ * @file finiteDifferences.h
+ *
+ * Forward difference jacobians of vector valued functions, dense or on a known sparsity pattern.
+ * The sparse variant perturbs all columns of one color of jacobianColoring() at once. The columns
+ * (colors) are evaluated sequentially unless parallel is set, f must then be safe to call from
+ * multiple threads.
+ *
+ * Usage:
+ * \code
+ * auto J  = finiteDifferenceJacobian(f, x, f(x));
+ * auto Js = finiteDifferenceJacobian(f, x, f(x), pattern, jacobianColoring(pattern));
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/finiteDifferences.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include "SparseMatrix.h"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <vector>
+
+//! representation of linear equation
+using LinearEquation = std::function<Matrix<double>(const Matrix<double>&)>;
+
+/**
+ * Greedy coloring of the columns of a sparsity pattern, columns sharing a row get different colors.
+ * @param pattern sparsity pattern of the jacobian
+ * @returns color of every column, colors are numbered from 0
+ */
+inline std::vector<size_t> jacobianColoring(const CSRMatrix<double>& pattern) {
+  size_t n         = pattern.columns();
+  size_t uncolored = std::numeric_limits<size_t>::max();
+  auto columns     = pattern.ToCSC();
+  std::vector<size_t> color(n, uncolored);
+  // forbidden[c] == j marks color c as used by a neighbour of column j
+  std::vector<size_t> forbidden(n + 1, uncolored);
+  for(size_t j = 0; j < n; ++j) {
+    for(size_t p = columns.indptr[j]; p < columns.indptr[j + 1]; ++p) {
+      size_t i = columns.indices[p];
+      for(size_t q = pattern.indptr[i]; q < pattern.indptr[i + 1]; ++q) {
+        size_t k = pattern.indices[q];
+        if(color[k] != uncolored) forbidden[color[k]] = j;
+      }
+    }
+    size_t c = 0;
+    while(forbidden[c] == j) { ++c; }
+    color[j] = c;
+  }
+  return color;
+}
+
+/**
+ * Dense forward difference jacobian
+ * @param f function
+ * @param x point of evaluation
+ * @param fx f(x)
+ * @param fdStep relative step, 0 uses the square root of the machine precision
+ * @param parallel evaluate the columns concurrently by parallelFor(), f has to be thread safe
+ * @returns jacobian of f in x
+ */
+inline Matrix<double> finiteDifferenceJacobian(const LinearEquation& f, const Matrix<double>& x, const Matrix<double>& fx,
+                                               double fdStep = 0, bool parallel = false) {
+  size_t m = fx.rows(), n = x.rows();
+  if(fdStep <= 0) fdStep = std::sqrt(std::numeric_limits<double>::epsilon());
+  Matrix<double> J(0, m, n);
+  parallelFor(
+      0,
+      n,
+      [&](size_t begin, size_t end) {
+        auto xp = x;
+        for(size_t j = begin; j < end; ++j) {
+          double h = fdStep * std::max(1.0, std::abs(x(j, 0)));
+          xp(j, 0) = x(j, 0) + h;
+          auto fp  = f(xp);
+          xp(j, 0) = x(j, 0);
+          for(size_t i = 0; i < m; ++i) { J(i, j) = (fp(i, 0) - fx(i, 0)) / h; }
+        }
+      },
+      parallel ? 4 : n);
+  return J;
+}
+
+/**
+ * Sparse forward difference jacobian, all columns of one color are perturbed at once.
+ * @param f function
+ * @param x point of evaluation
+ * @param fx f(x)
+ * @param pattern sparsity pattern of the jacobian
+ * @param colors column coloring of the pattern, see jacobianColoring()
+ * @param fdStep relative step, 0 uses the square root of the machine precision
+ * @param parallel evaluate the colors concurrently by parallelFor(), f has to be thread safe
+ * @returns jacobian of f in x with the given pattern
+ */
+inline CSRMatrix<double> finiteDifferenceJacobian(const LinearEquation& f, const Matrix<double>& x, const Matrix<double>& fx,
+                                                  const CSRMatrix<double>& pattern, const std::vector<size_t>& colors,
+                                                  double fdStep = 0, bool parallel = false) {
+  size_t n = pattern.columns();
+  assert(colors.size() == n && x.rows() == n);
+  if(fdStep <= 0) fdStep = std::sqrt(std::numeric_limits<double>::epsilon());
+  size_t colorCount = 0;
+  for(auto c : colors) { colorCount = std::max(colorCount, c + 1); }
+
+  std::vector<std::vector<size_t>> groups(colorCount);
+  for(size_t j = 0; j < n; ++j) { groups[colors[j]].push_back(j); }
+  // stored entries of the pattern in column order, entry p of column j is value position[p]
+  auto columns = pattern.ToCSC();
+  std::vector<size_t> position(pattern.nonZeros());
+  std::vector<size_t> next(columns.indptr.begin(), columns.indptr.end() - 1);
+  for(size_t i = 0; i < pattern.rows(); ++i) {
+    for(size_t q = pattern.indptr[i]; q < pattern.indptr[i + 1]; ++q) { position[next[pattern.indices[q]]++] = q; }
+  }
+
+  CSRMatrix<double> J(pattern.rows(), n, pattern.indptr, pattern.indices, std::vector<double>(pattern.nonZeros(), 0.0));
+  parallelFor(
+      0,
+      colorCount,
+      [&](size_t begin, size_t end) {
+        auto xp = x;
+        for(size_t c = begin; c < end; ++c) {
+          for(auto j : groups[c]) { xp(j, 0) = x(j, 0) + fdStep * std::max(1.0, std::abs(x(j, 0))); }
+          auto fp = f(xp);
+          for(auto j : groups[c]) {
+            double h = xp(j, 0) - x(j, 0);
+            for(size_t p = columns.indptr[j]; p < columns.indptr[j + 1]; ++p) {
+              size_t i             = columns.indices[p];
+              J.values[position[p]] = (fp(i, 0) - fx(i, 0)) / h;
+            }
+            xp(j, 0) = x(j, 0);
+          }
+        }
+      },
+      parallel ? 4 : colorCount);
+  return J;
+}
+
+/**
+ * \example numerics/lin_alg/TestNewtonSolver.cpp
+ * This is an example on how to use the finite difference jacobians.
+ */
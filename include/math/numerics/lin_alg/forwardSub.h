@@ -15,13 +15,16 @@
 
 #pragma once
 #include "../utils.h"
+#include "trsm.h"
 #include <iostream>
 #include <vector>
 
 /**
- * Forward-substitution
+ * Forward-substitution with unit lower triangular matrix, the diagonal of L is not accessed.
+ *
+ * All columns of b are solved at once by trsm().
  * @param L Coefficient Matrix
- * @param b resulting vector
+ * @param b resulting vector(s)
  * @returns c
  */
 Matrix<double> forwardSub(const Matrix<double>& L, const Matrix<double>& b) {
@@ -29,7 +32,7 @@ Matrix<double> forwardSub(const Matrix<double>& L, const Matrix<double>& b) {
   size_t n  = L.columns();
   size_t v  = b.rows();
   size_t nv = b.columns();
-  if(v != m || (nv != 1 && nv != n)) {
+  if(v != m || nv == 0) {
     // Error, cannot compute
     std::cout << "Matrix vector dimension miss match, error!\n";
     return Matrix<double>();
@@ -40,16 +43,8 @@ Matrix<double> forwardSub(const Matrix<double>& L, const Matrix<double>& b) {
     return Matrix<double>();
   }
 
-  auto c = zeros(v, nv);
-
-  c.SetRow(0, b(0));
-
-  for(size_t j = 1; j < m; j++) {
-    double s_k = 0.0f;
-    for(size_t k = 0; k < j; k++) { s_k += (L(j, k) * c(k, 0)); }
-    for(size_t i = 0; i < nv; ++i) { c(j, i) = b(j, i) - s_k; }
-  }
-
+  auto c = b;
+  trsm(L, c, LOWER_TRIANGULAR, false, UNIT_DIAGONAL);
   return c;
 }
 
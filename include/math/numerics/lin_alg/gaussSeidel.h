@@ -15,6 +15,7 @@
 #include "LU.h"
 #include "backwardSub.h"
 #include "forwardSub.h"
+#include "trsm.h"
 #include <vector>
 
 /**
@@ -27,13 +28,7 @@
  * @returns $$x$$
  */
 Matrix<double> gaussSeidel(const Matrix<double>& A, const Matrix<double>& b) {
-  auto LR = LU(A);
-
-  auto bCopy = b;
-  for(size_t i = 0; i < b.rows(); i++) { bCopy.SetRow(i, b(LR.second[i])); }
-
-  auto c = forwardSub(LR.first, bCopy);
-  return backwardSub(LR.first, c);
+  return luSolve(LU(A), b);
 }
 
 /**
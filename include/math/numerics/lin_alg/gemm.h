@@ -0,0 +1,250 @@
+/**
+ * @file gemm.h
+ *
+ * Dense matrix-matrix multiplication engine
+ * $$C \leftarrow \alpha A B + \beta C$$
+ *
+ * - gemm(): cache blocked kernel, row blocks are distributed by parallelFor(). The innermost loop
+ *   runs over contiguous rows of B and C.
+ * - strassen(): Strassen-Winograd recursion (7 products, 15 additions per level) down to
+ *   strassenCutoff(), below the blocked kernel takes over. All temporaries of the recursion live in
+ *   one workspace allocated up front, odd dimensions are handled by peeling the last row/column.
+ * - multiply(): chooses between both, Strassen is only used if all dimensions reach the cutoff.
+ *
+ * Strassen-Winograd trades accuracy for speed: the error bound grows with the recursion depth
+ * (normwise instead of componentwise), which is acceptable for most statistical workloads. It is
+ * therefore opt-in: Matrix::operator* keeps the plain loop, callers choose the engine by calling
+ * multiply() or gemm(). The default cutoff is a fixed, conservative value, the `benchmarks` target
+ * (MATH_BENCHMARKS) prints the crossover measured on the current machine.
+ *
+ * Usage:
+ * \code
+ * auto C = multiply(A, B);  // blocked or Strassen depending on the size
+ * strassenCutoff() = 256;   // tune the crossover
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/gemm.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include <algorithm>
+#include <vector>
+
+/**
+ * Minimal dimension for which multiply() uses the Strassen-Winograd recursion, also the size at
+ * which the recursion hands off to the blocked kernel.
+ * @returns reference to the global cutoff
+ */
+inline size_t& strassenCutoff() {
+  static size_t cutoff = 768;
+  return cutoff;
+}
+
+/**
+ * Blocked general matrix multiplication on raw row-major buffers
+ * $$C \leftarrow \alpha A B + \beta C$$
+ * @param m rows of A and C
+ * @param n columns of B and C
+ * @param k columns of A, rows of B
+ * @param alpha factor of the product
+ * @param A m x k matrix with leading dimension lda
+ * @param lda row stride of A
+ * @param B k x n matrix with leading dimension ldb
+ * @param ldb row stride of B
+ * @param beta factor of C, C is not read for beta = 0
+ * @param C m x n matrix with leading dimension ldc
+ * @param ldc row stride of C
+ */
+template<typename T>
+void gemm(size_t m, size_t n, size_t k, T alpha, const T* A, size_t lda, const T* B, size_t ldb, T beta, T* C,
+          size_t ldc) {
+  if(m == 0 || n == 0) return;
+  // block sizes: a KC x NC panel of B stays in L2, a row of C in L1
+  const size_t MC = 64, KC = 256, NC = 512;
+  size_t work     = std::max<size_t>(1, n * k);
+  parallelFor(
+      0,
+      m,
+      [&](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+          T* ci = C + i * ldc;
+          if(beta == T(0)) {
+            std::fill(ci, ci + n, T(0));
+          } else if(beta != T(1)) {
+            for(size_t j = 0; j < n; ++j) { ci[j] *= beta; }
+          }
+        }
+        for(size_t jc = 0; jc < n; jc += NC) {
+          size_t je = std::min(n, jc + NC);
+          for(size_t pc = 0; pc < k; pc += KC) {
+            size_t pe = std::min(k, pc + KC);
+            for(size_t ic = begin; ic < end; ic += MC) {
+              size_t ie = std::min(end, ic + MC);
+              for(size_t i = ic; i < ie; ++i) {
+                T* ci       = C + i * ldc;
+                const T* ai = A + i * lda;
+                for(size_t p = pc; p < pe; ++p) {
+                  T a = alpha * ai[p];
+                  if(a == T(0)) continue;
+                  const T* bp = B + p * ldb;
+                  for(size_t j = jc; j < je; ++j) { ci[j] += a * bp[j]; }
+                }
+              }
+            }
+          }
+        }
+      },
+      std::max<size_t>(16, (1 << 18) / work));
+}
+
+namespace strassen_detail {
+/**
+ * C = A + sign * B for m x n blocks
+ */
+template<typename T>
+void add(size_t m, size_t n, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc, T sign) {
+  for(size_t i = 0; i < m; ++i) {
+    const T* a = A + i * lda;
+    const T* b = B + i * ldb;
+    T* c       = C + i * ldc;
+    for(size_t j = 0; j < n; ++j) { c[j] = a[j] + sign * b[j]; }
+  }
+}
+
+/**
+ * Workspace entries required by recurse() for an m x k times k x n product
+ */
+inline size_t workspace(size_t m, size_t n, size_t k, size_t cutoff) {
+  if(std::min({ m, n, k }) < std::max<size_t>(cutoff, 2)) return 0;
+  size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  return m2 * std::max(k2, n2) + k2 * n2 + workspace(m2, n2, k2, cutoff);
+}
+
+/**
+ * C = A B by Strassen-Winograd, C is m x n and overwritten.
+ *
+ * Schedule of Boyer, Dumas, Pernet and Zhou with two temporaries X, Y and the quadrants of C.
+ */
+template<typename T>
+void recurse(size_t m, size_t n, size_t k, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc, T* work,
+             size_t cutoff) {
+  if(std::min({ m, n, k }) < std::max<size_t>(cutoff, 2)) {
+    gemm<T>(m, n, k, T(1), A, lda, B, ldb, T(0), C, ldc);
+    return;
+  }
+  size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const T *A11 = A, *A12 = A + k2, *A21 = A + m2 * lda, *A22 = A21 + k2;
+  const T *B11 = B, *B12 = B + n2, *B21 = B + k2 * ldb, *B22 = B21 + n2;
+  T *C11 = C, *C12 = C + n2, *C21 = C + m2 * ldc, *C22 = C21 + n2;
+  size_t ldx = std::max(k2, n2);
+  T* X       = work;
+  T* Y       = X + m2 * ldx;
+  T* next    = Y + k2 * n2;
+
+  add(m2, k2, A11, lda, A21, lda, X, ldx, T(-1));                    // S3 = A11 - A21
+  add(k2, n2, B22, ldb, B12, ldb, Y, n2, T(-1));                     // T3 = B22 - B12
+  recurse(m2, n2, k2, X, ldx, Y, n2, C21, ldc, next, cutoff);        // P7 = S3 T3
+  add(m2, k2, A21, lda, A22, lda, X, ldx, T(1));                     // S1 = A21 + A22
+  add(k2, n2, B12, ldb, B11, ldb, Y, n2, T(-1));                     // T1 = B12 - B11
+  recurse(m2, n2, k2, X, ldx, Y, n2, C22, ldc, next, cutoff);        // P5 = S1 T1
+  add(k2, n2, B22, ldb, Y, n2, Y, n2, T(-1));                        // T2 = B22 - T1
+  add(m2, k2, X, ldx, A11, lda, X, ldx, T(-1));                      // S2 = S1 - A11
+  recurse(m2, n2, k2, X, ldx, Y, n2, C12, ldc, next, cutoff);        // P6 = S2 T2
+  add(m2, k2, A12, lda, X, ldx, X, ldx, T(-1));                      // S4 = A12 - S2
+  recurse(m2, n2, k2, X, ldx, B22, ldb, C11, ldc, next, cutoff);     // P3 = S4 B22
+  recurse(m2, n2, k2, A11, lda, B11, ldb, X, ldx, next, cutoff);     // P1 = A11 B11
+  add(m2, n2, X, ldx, C12, ldc, C12, ldc, T(1));                     // U2 = P1 + P6
+  add(m2, n2, C12, ldc, C21, ldc, C21, ldc, T(1));                   // U3 = U2 + P7
+  add(m2, n2, C12, ldc, C22, ldc, C12, ldc, T(1));                   // U4 = U2 + P5
+  add(m2, n2, C21, ldc, C22, ldc, C22, ldc, T(1));                   // U7 = U3 + P5
+  add(m2, n2, C12, ldc, C11, ldc, C12, ldc, T(1));                   // U5 = U4 + P3
+  add(k2, n2, Y, n2, B21, ldb, Y, n2, T(-1));                        // T4 = T2 - B21
+  recurse(m2, n2, k2, A22, lda, Y, n2, C11, ldc, next, cutoff);      // P4 = A22 T4
+  add(m2, n2, C21, ldc, C11, ldc, C21, ldc, T(-1));                  // U6 = U3 - P4
+  recurse(m2, n2, k2, A12, lda, B21, ldb, C11, ldc, next, cutoff);   // P2 = A12 B21
+  add(m2, n2, X, ldx, C11, ldc, C11, ldc, T(1));                     // U1 = P1 + P2
+
+  // peeling of odd dimensions
+  size_t me = 2 * m2, ne = 2 * n2, ke = 2 * k2;
+  if(ke < k) gemm<T>(me, ne, k - ke, T(1), A + ke, lda, B + ke * ldb, ldb, T(1), C, ldc);
+  if(ne < n) gemm<T>(me, n - ne, k, T(1), A, lda, B + ne, ldb, T(0), C + ne, ldc);
+  if(me < m) gemm<T>(m - me, n, k, T(1), A + me * lda, lda, B, ldb, T(0), C + me * ldc, ldc);
+}
+} // namespace strassen_detail
+
+/**
+ * Strassen-Winograd multiplication on raw row-major buffers, C = A B
+ * @param m rows of A and C
+ * @param n columns of B and C
+ * @param k columns of A, rows of B
+ * @param A m x k matrix with leading dimension lda
+ * @param lda row stride of A
+ * @param B k x n matrix with leading dimension ldb
+ * @param ldb row stride of B
+ * @param C m x n matrix with leading dimension ldc, overwritten
+ * @param ldc row stride of C
+ * @param cutoff blocks with a dimension below cutoff are handed off to gemm()
+ */
+template<typename T>
+void strassen(size_t m, size_t n, size_t k, const T* A, size_t lda, const T* B, size_t ldb, T* C, size_t ldc,
+              size_t cutoff = strassenCutoff()) {
+  std::vector<T> work(strassen_detail::workspace(m, n, k, cutoff));
+  strassen_detail::recurse<T>(m, n, k, A, lda, B, ldb, C, ldc, work.data(), cutoff);
+}
+
+/**
+ * Strassen-Winograd multiplication
+ * @param A m x k matrix
+ * @param B k x n matrix
+ * @param cutoff blocks with a dimension below cutoff are handed off to the blocked kernel
+ * @returns A B
+ */
+template<typename T>
+Matrix<T> strassen(const Matrix<T>& A, const Matrix<T>& B, size_t cutoff = strassenCutoff()) {
+  assert(A.columns() == B.rows() && A.elements() == 1 && B.elements() == 1);
+  Matrix<T> C(0, A.rows(), B.columns());
+  if(C.rows() == 0 || C.columns() == 0 || A.columns() == 0) return C;
+  strassen<T>(A.rows(), B.columns(), A.columns(), &A(0, 0), A.columns(), &B(0, 0), B.columns(), &C(0, 0),
+              C.columns(), cutoff);
+  return C;
+}
+
+/**
+ * Blocked matrix multiplication
+ * @param A m x k matrix
+ * @param B k x n matrix
+ * @returns A B
+ */
+template<typename T>
+Matrix<T> gemm(const Matrix<T>& A, const Matrix<T>& B) {
+  assert(A.columns() == B.rows() && A.elements() == 1 && B.elements() == 1);
+  Matrix<T> C(0, A.rows(), B.columns());
+  if(C.rows() == 0 || C.columns() == 0 || A.columns() == 0) return C;
+  gemm<T>(A.rows(), B.columns(), A.columns(), T(1), &A(0, 0), A.columns(), &B(0, 0), B.columns(), T(0), &C(0, 0),
+          C.columns());
+  return C;
+}
+
+/**
+ * Matrix multiplication choosing the fastest kernel, Strassen-Winograd is used if all dimensions are
+ * at least strassenCutoff()
+ * @param A m x k matrix
+ * @param B k x n matrix
+ * @returns A B
+ */
+template<typename T>
+Matrix<T> multiply(const Matrix<T>& A, const Matrix<T>& B) {
+  size_t cutoff = strassenCutoff();
+  if(std::min({ A.rows(), A.columns(), B.columns() }) >= cutoff) return strassen(A, B, cutoff);
+  return gemm(A, B);
+}
+
+/**
+ * \example numerics/lin_alg/TestGemm.cpp
+ * This is an example on how to use the gemm kernels.
+ */
@@ -0,0 +1,632 @@
+/**
+ * @file krylov.h
+ *
+ * Preconditioned Krylov subspace methods for large systems of linear equations $$A x = b$$:
+ * - cg(): Conjugate Gradient, A symmetric positive definite
+ * - bicgstab(): BiCGSTAB, general non-symmetric A
+ * - gmres(): restarted GMRES(m), general non-symmetric A
+ *
+ * The solvers only access A through matrix-vector products, A may be a dense Matrix, a CSRMatrix
+ * or any LinearOperator. Apart from the m basis vectors of GMRES, memory requirements are O(n).
+ *
+ * Preconditioners approximate $$z = M^{-1} r$$ and are available as
+ * jacobiPreconditioner(), gaussSeidelPreconditioner(), ssorPreconditioner(),
+ * iluPreconditioner() (ILU(0)) and icPreconditioner() (IC(0)).
+ *
+ * Usage:
+ * \code
+ * KrylovOption option;
+ * option.preconditioner = icPreconditioner(A);
+ * auto res = cg(A, b, option);
+ * // res.x, res.residuals, res.converged
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/krylov.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "LinearOperator.h"
+#include "SparseMatrix.h"
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+//! preconditioner, computes z = M^{-1} r for column vectors r
+using Preconditioner = std::function<Matrix<double>(const Matrix<double>&)>;
+
+/**
+ * Option struct for the Krylov solvers
+ */
+struct KrylovOption {
+  //! relative tolerance, stops once ||b - A x|| <= TOL * ||b||
+  double TOL = 1e-10;
+  //! absolute tolerance, stops once ||b - A x|| <= absTOL
+  double absTOL = 0.0;
+  //! max number of iterations (matrix-vector products for GMRES)
+  size_t maxIter = 1000;
+  //! size of the Krylov basis between two GMRES restarts
+  size_t restart = 30;
+  //! optional (right) preconditioner, nullptr = none
+  Preconditioner preconditioner = nullptr;
+};
+
+/**
+ * Representation of the result of a Krylov solver
+ */
+struct KrylovResult {
+  //! approximated solution, n x 1
+  Matrix<double> x;
+  //! residual norm ||b - A x|| per iteration, starting with the initial residual
+  std::vector<double> residuals;
+  //! number of performed iterations
+  size_t iterations = 0;
+  //! true if the tolerance was reached
+  bool converged = false;
+};
+
+namespace krylov {
+  /**
+   * Euclidean inner product of two column vectors
+   */
+  inline double dot(const Matrix<double>& a, const Matrix<double>& b) {
+    const double* pa = &a(0, 0);
+    const double* pb = &b(0, 0);
+    double s         = 0.0;
+    for(size_t i = 0; i < a.rows(); ++i) { s += pa[i] * pb[i]; }
+    return s;
+  }
+
+  /**
+   * y += alpha * x for column vectors
+   */
+  inline void axpy(double alpha, const Matrix<double>& x, Matrix<double>& y) {
+    const double* px = &x(0, 0);
+    double* py       = &y(0, 0);
+    for(size_t i = 0; i < x.rows(); ++i) { py[i] += alpha * px[i]; }
+  }
+
+  /**
+   * Applies the preconditioner, identity if none is set
+   */
+  inline Matrix<double> apply(const Preconditioner& M, const Matrix<double>& r) { return M ? M(r) : r; }
+
+  /**
+   * @returns the stopping threshold for given right hand side norm
+   */
+  inline double threshold(const KrylovOption& option, double bNorm) { return std::max(option.TOL * bNorm, option.absTOL); }
+} // namespace krylov
+
+/**
+ * Preconditioned Conjugate Gradient method for symmetric positive definite systems.
+ *
+ * The preconditioner has to be symmetric positive definite as well (Jacobi, SSOR, IC(0)).
+ *
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param x0 initial guess, zero vector if empty
+ * @param option solver options
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult cg(const Operator& op, const Matrix<double>& b, const Matrix<double>& x0, const KrylovOption& option = {}) {
+  LinearOperator A = asOperator(op);
+  KrylovResult result;
+  size_t n = b.rows();
+  result.x = x0.rows() == n ? x0 : Matrix<double>(0, n, 1);
+
+  Matrix<double> r = b;
+  if(x0.rows() == n) krylov::axpy(-1.0, A(result.x), r);
+  double tol   = krylov::threshold(option, std::sqrt(krylov::dot(b, b)));
+  double rNorm = std::sqrt(krylov::dot(r, r));
+  result.residuals.push_back(rNorm);
+  if(rNorm <= tol) {
+    result.converged = true;
+    return result;
+  }
+
+  auto z    = krylov::apply(option.preconditioner, r);
+  auto p    = z;
+  double rz = krylov::dot(r, z);
+  for(size_t it = 1; it <= option.maxIter; ++it) {
+    auto Ap      = A(p);
+    double pAp   = krylov::dot(p, Ap);
+    if(pAp <= 0.0) {
+      std::cerr << "cg: operator is not positive definite" << std::endl;
+      break;
+    }
+    double alpha = rz / pAp;
+    krylov::axpy(alpha, p, result.x);
+    krylov::axpy(-alpha, Ap, r);
+    rNorm = std::sqrt(krylov::dot(r, r));
+    result.residuals.push_back(rNorm);
+    result.iterations = it;
+    if(rNorm <= tol) {
+      result.converged = true;
+      break;
+    }
+    z            = krylov::apply(option.preconditioner, r);
+    double rzNew = krylov::dot(r, z);
+    double beta  = rzNew / rz;
+    rz           = rzNew;
+    double* pp       = &p(0, 0);
+    const double* pz = &z(0, 0);
+    for(size_t i = 0; i < n; ++i) { pp[i] = pz[i] + beta * pp[i]; }
+  }
+  return result;
+}
+
+/**
+ * Preconditioned Conjugate Gradient method starting at x0 = 0
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param option solver options
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult cg(const Operator& op, const Matrix<double>& b, const KrylovOption& option = {}) {
+  return cg(op, b, Matrix<double>(), option);
+}
+
+/**
+ * Right preconditioned BiCGSTAB method (van der Vorst) for general systems.
+ *
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param x0 initial guess, zero vector if empty
+ * @param option solver options
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult bicgstab(const Operator& op, const Matrix<double>& b, const Matrix<double>& x0, const KrylovOption& option = {}) {
+  LinearOperator A = asOperator(op);
+  KrylovResult result;
+  size_t n = b.rows();
+  result.x = x0.rows() == n ? x0 : Matrix<double>(0, n, 1);
+
+  Matrix<double> r = b;
+  if(x0.rows() == n) krylov::axpy(-1.0, A(result.x), r);
+  double tol   = krylov::threshold(option, std::sqrt(krylov::dot(b, b)));
+  double rNorm = std::sqrt(krylov::dot(r, r));
+  result.residuals.push_back(rNorm);
+  if(rNorm <= tol) {
+    result.converged = true;
+    return result;
+  }
+
+  auto rHat  = r;
+  double rho = 1.0, alpha = 1.0, omega = 1.0;
+  Matrix<double> v(0, n, 1), p(0, n, 1);
+  for(size_t it = 1; it <= option.maxIter; ++it) {
+    double rhoNew = krylov::dot(rHat, r);
+    if(rhoNew == 0.0) {
+      std::cerr << "bicgstab: breakdown, rho = 0" << std::endl;
+      break;
+    }
+    double beta = (rhoNew / rho) * (alpha / omega);
+    rho         = rhoNew;
+    double* pp       = &p(0, 0);
+    const double* pr = &r(0, 0);
+    const double* pv = &v(0, 0);
+    for(size_t i = 0; i < n; ++i) { pp[i] = pr[i] + beta * (pp[i] - omega * pv[i]); }
+
+    auto pHat = krylov::apply(option.preconditioner, p);
+    v         = A(pHat);
+    alpha     = rho / krylov::dot(rHat, v);
+    auto s    = r;
+    krylov::axpy(-alpha, v, s);
+    krylov::axpy(alpha, pHat, result.x);
+    result.iterations = it;
+
+    double sNorm = std::sqrt(krylov::dot(s, s));
+    if(sNorm <= tol) {
+      result.residuals.push_back(sNorm);
+      result.converged = true;
+      break;
+    }
+
+    auto sHat = krylov::apply(option.preconditioner, s);
+    auto t    = A(sHat);
+    double tt = krylov::dot(t, t);
+    omega     = tt > 0.0 ? krylov::dot(t, s) / tt : 0.0;
+    krylov::axpy(omega, sHat, result.x);
+    r = s;
+    krylov::axpy(-omega, t, r);
+
+    rNorm = std::sqrt(krylov::dot(r, r));
+    result.residuals.push_back(rNorm);
+    if(rNorm <= tol) {
+      result.converged = true;
+      break;
+    }
+    if(omega == 0.0) {
+      std::cerr << "bicgstab: breakdown, omega = 0" << std::endl;
+      break;
+    }
+  }
+  return result;
+}
+
+/**
+ * Right preconditioned BiCGSTAB method starting at x0 = 0
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param option solver options
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult bicgstab(const Operator& op, const Matrix<double>& b, const KrylovOption& option = {}) {
+  return bicgstab(op, b, Matrix<double>(), option);
+}
+
+/**
+ * Right preconditioned restarted GMRES(m) using modified Gram-Schmidt and Givens rotations.
+ *
+ * Right preconditioning keeps the monitored residual equal to the true residual ||b - A x||.
+ *
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param x0 initial guess, zero vector if empty
+ * @param option solver options, option.restart defines m
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult gmres(const Operator& op, const Matrix<double>& b, const Matrix<double>& x0, const KrylovOption& option = {}) {
+  LinearOperator A = asOperator(op);
+  KrylovResult result;
+  size_t n = b.rows();
+  size_t m = std::max<size_t>(1, std::min(option.restart, n));
+  result.x = x0.rows() == n ? x0 : Matrix<double>(0, n, 1);
+
+  double tol = krylov::threshold(option, std::sqrt(krylov::dot(b, b)));
+  std::vector<Matrix<double>> V(m + 1);
+  Matrix<double> H(0, m + 1, m);
+  std::vector<double> cs(m), sn(m), g(m + 1);
+
+  Matrix<double> r = b;
+  if(x0.rows() == n) krylov::axpy(-1.0, A(result.x), r);
+  double beta = std::sqrt(krylov::dot(r, r));
+  result.residuals.push_back(beta);
+
+  while(true) {
+    if(beta <= tol) {
+      result.converged = true;
+      break;
+    }
+    if(result.iterations >= option.maxIter) break;
+
+    V[0] = r * (1.0 / beta);
+    std::fill(g.begin(), g.end(), 0.0);
+    g[0]     = beta;
+    size_t k = 0;
+    for(; k < m && result.iterations < option.maxIter; ++k) {
+      auto w = A(krylov::apply(option.preconditioner, V[k]));
+      for(size_t i = 0; i <= k; ++i) {
+        H(i, k) = krylov::dot(w, V[i]);
+        krylov::axpy(-H(i, k), V[i], w);
+      }
+      H(k + 1, k) = std::sqrt(krylov::dot(w, w));
+      if(H(k + 1, k) > 0.0) V[k + 1] = w * (1.0 / H(k + 1, k));
+
+      // apply previous rotations and compute the new one
+      for(size_t i = 0; i < k; ++i) {
+        double tmp  = cs[i] * H(i, k) + sn[i] * H(i + 1, k);
+        H(i + 1, k) = -sn[i] * H(i, k) + cs[i] * H(i + 1, k);
+        H(i, k)     = tmp;
+      }
+      double denom = std::hypot(H(k, k), H(k + 1, k));
+      cs[k]        = denom > 0.0 ? H(k, k) / denom : 1.0;
+      sn[k]        = denom > 0.0 ? H(k + 1, k) / denom : 0.0;
+      H(k, k)      = denom;
+      H(k + 1, k)  = 0.0;
+      g[k + 1]     = -sn[k] * g[k];
+      g[k]         = cs[k] * g[k];
+
+      result.iterations++;
+      result.residuals.push_back(std::abs(g[k + 1]));
+      if(std::abs(g[k + 1]) <= tol || denom == 0.0) {
+        ++k;
+        break;
+      }
+    }
+
+    // solve the upper triangular system H y = g and update x += M^{-1} V y
+    std::vector<double> y(k);
+    for(size_t i = k; i-- > 0;) {
+      double s = g[i];
+      for(size_t j = i + 1; j < k; ++j) { s -= H(i, j) * y[j]; }
+      y[i] = H(i, i) != 0.0 ? s / H(i, i) : 0.0;
+    }
+    Matrix<double> update(0, n, 1);
+    for(size_t j = 0; j < k; ++j) { krylov::axpy(y[j], V[j], update); }
+    krylov::axpy(1.0, krylov::apply(option.preconditioner, update), result.x);
+
+    r = b;
+    krylov::axpy(-1.0, A(result.x), r);
+    beta                    = std::sqrt(krylov::dot(r, r));
+    result.residuals.back() = beta;
+    if(k > 0 && H(k - 1, k - 1) == 0.0) {
+      std::cerr << "gmres: breakdown" << std::endl;
+      break;
+    }
+  }
+  return result;
+}
+
+/**
+ * Right preconditioned restarted GMRES(m) starting at x0 = 0
+ * @param op matrix, sparse matrix or LinearOperator with dimension n x n
+ * @param b right hand side, n x 1
+ * @param option solver options, option.restart defines m
+ * @returns approximated solution and convergence history
+ */
+template<typename Operator>
+KrylovResult gmres(const Operator& op, const Matrix<double>& b, const KrylovOption& option = {}) {
+  return gmres(op, b, Matrix<double>(), option);
+}
+
+/**
+ * Jacobi (diagonal) preconditioner $$M = D$$
+ * @param A sparse matrix with non zero diagonal
+ * @returns preconditioner
+ */
+inline Preconditioner jacobiPreconditioner(const CSRMatrix<double>& A) {
+  auto invDiag = std::make_shared<std::vector<double>>(A.rows());
+  for(size_t i = 0; i < A.rows(); ++i) {
+    double d        = A(i, i);
+    (*invDiag)[i] = d != 0.0 ? 1.0 / d : 1.0;
+  }
+  return [invDiag](const Matrix<double>& r) {
+    auto z = r;
+    for(size_t i = 0; i < r.rows(); ++i) { z(i, 0) *= (*invDiag)[i]; }
+    return z;
+  };
+}
+
+/**
+ * Gauss-Seidel preconditioner, performs forward Gauss-Seidel sweeps on A z = r starting at z = 0.
+ *
+ * Not symmetric, use with bicgstab() or gmres().
+ * **Note** the preconditioner references A, it has to outlive the returned preconditioner.
+ * @param A sparse matrix with non zero diagonal
+ * @param sweeps number of sweeps
+ * @returns preconditioner
+ */
+inline Preconditioner gaussSeidelPreconditioner(const CSRMatrix<double>& A, size_t sweeps = 1) {
+  return [&A, sweeps](const Matrix<double>& r) {
+    size_t n = A.rows();
+    Matrix<double> z(0, n, 1);
+    for(size_t sweep = 0; sweep < sweeps; ++sweep) {
+      for(size_t i = 0; i < n; ++i) {
+        double s = r(i, 0), d = 1.0;
+        for(size_t k = A.indptr[i]; k < A.indptr[i + 1]; ++k) {
+          if(A.indices[k] == i) d = A.values[k];
+          else s -= A.values[k] * z(A.indices[k], 0);
+        }
+        z(i, 0) = s / d;
+      }
+    }
+    return z;
+  };
+}
+
+/**
+ * Symmetric successive over-relaxation (SSOR) preconditioner, one forward and one backward
+ * SOR sweep on A z = r starting at z = 0. Symmetric for symmetric A, can be used with cg().
+ *
+ * **Note** the preconditioner references A, it has to outlive the returned preconditioner.
+ * @param A sparse matrix with non zero diagonal
+ * @param omega relaxation parameter in (0, 2)
+ * @returns preconditioner
+ */
+inline Preconditioner ssorPreconditioner(const CSRMatrix<double>& A, double omega = 1.0) {
+  assert(omega > 0.0 && omega < 2.0);
+  return [&A, omega](const Matrix<double>& r) {
+    size_t n = A.rows();
+    Matrix<double> z(0, n, 1);
+    auto relax = [&](size_t i) {
+      double s = r(i, 0), d = 1.0;
+      for(size_t k = A.indptr[i]; k < A.indptr[i + 1]; ++k) {
+        if(A.indices[k] == i) d = A.values[k];
+        else s -= A.values[k] * z(A.indices[k], 0);
+      }
+      z(i, 0) = (1.0 - omega) * z(i, 0) + omega * s / d;
+    };
+    for(size_t i = 0; i < n; ++i) { relax(i); }
+    for(size_t i = n; i-- > 0;) { relax(i); }
+    return z;
+  };
+}
+
+/**
+ * Incomplete LU factorization without fill-in, ILU(0).
+ *
+ * L (unit lower) and U share the sparsity pattern of A.
+ */
+class ILU0
+{
+public:
+  //! combined factors, strictly lower part holds L, upper part holds U
+  CSRMatrix<double> LU;
+  //! position of the diagonal element within every row
+  std::vector<size_t> diagonal;
+  //! false if a zero pivot occurred
+  bool isRegular = true;
+
+  /**
+   * Factorizes given matrix
+   * @param A sparse matrix, all diagonal elements have to be stored
+   */
+  explicit ILU0(const CSRMatrix<double>& A)
+    : LU(A)
+    , diagonal(A.rows()) {
+    size_t n = A.rows();
+    std::vector<size_t> position(n, size_t(-1));
+    for(size_t i = 0; i < n; ++i) {
+      size_t start = LU.indptr[i], end = LU.indptr[i + 1];
+      diagonal[i]  = size_t(-1);
+      for(size_t k = start; k < end; ++k) {
+        position[LU.indices[k]] = k;
+        if(LU.indices[k] == i) diagonal[i] = k;
+      }
+      if(diagonal[i] == size_t(-1)) {
+        std::cerr << "ILU0: missing diagonal element in row " << i << std::endl;
+        isRegular = false;
+        return;
+      }
+      for(size_t k = start; k < end && LU.indices[k] < i; ++k) {
+        size_t col    = LU.indices[k];
+        LU.values[k] /= LU.values[diagonal[col]];
+        for(size_t q = diagonal[col] + 1; q < LU.indptr[col + 1]; ++q) {
+          size_t p = position[LU.indices[q]];
+          if(p != size_t(-1)) LU.values[p] -= LU.values[k] * LU.values[q];
+        }
+      }
+      if(LU.values[diagonal[i]] == 0.0) isRegular = false;
+      for(size_t k = start; k < end; ++k) { position[LU.indices[k]] = size_t(-1); }
+    }
+  }
+
+  /**
+   * Solves L U z = r
+   * @param r right hand side, n x 1
+   * @returns z
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& r) const {
+    size_t n = LU.rows();
+    auto z   = r;
+    for(size_t i = 0; i < n; ++i) {
+      double s = z(i, 0);
+      for(size_t k = LU.indptr[i]; k < diagonal[i]; ++k) { s -= LU.values[k] * z(LU.indices[k], 0); }
+      z(i, 0) = s;
+    }
+    for(size_t i = n; i-- > 0;) {
+      double s = z(i, 0);
+      for(size_t k = diagonal[i] + 1; k < LU.indptr[i + 1]; ++k) { s -= LU.values[k] * z(LU.indices[k], 0); }
+      z(i, 0) = s / LU.values[diagonal[i]];
+    }
+    return z;
+  }
+};
+
+/**
+ * Incomplete Cholesky factorization without fill-in, IC(0).
+ *
+ * L shares the sparsity pattern of the lower triangle of A. If a non positive pivot occurs the
+ * factorization is restarted for $$A + \alpha\, \text{diag}(A)$$ with increasing shift α.
+ */
+class IC0
+{
+public:
+  //! lower triangular factor, diagonal stored last in every row
+  CSRMatrix<double> L;
+  //! applied diagonal shift
+  double shift = 0.0;
+
+  /**
+   * Factorizes given matrix
+   * @param A symmetric positive definite sparse matrix
+   */
+  explicit IC0(const CSRMatrix<double>& A) {
+    for(double alpha : { 0.0, 1e-3, 1e-2, 1e-1, 1.0 }) {
+      shift = alpha;
+      if(factorize(A, alpha)) return;
+    }
+    std::cerr << "IC0: factorization failed" << std::endl;
+  }
+
+  /**
+   * Solves L L^T z = r
+   * @param r right hand side, n x 1
+   * @returns z
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& r) const {
+    size_t n = L.rows();
+    auto z   = r;
+    for(size_t i = 0; i < n; ++i) {
+      double s     = z(i, 0);
+      size_t diagK = L.indptr[i + 1] - 1;
+      for(size_t k = L.indptr[i]; k < diagK; ++k) { s -= L.values[k] * z(L.indices[k], 0); }
+      z(i, 0) = s / L.values[diagK];
+    }
+    for(size_t i = n; i-- > 0;) {
+      size_t diagK = L.indptr[i + 1] - 1;
+      z(i, 0) /= L.values[diagK];
+      for(size_t k = L.indptr[i]; k < diagK; ++k) { z(L.indices[k], 0) -= L.values[k] * z(i, 0); }
+    }
+    return z;
+  }
+
+private:
+  /**
+   * row-wise IC(0) of A + alpha * diag(A)
+   * @returns false on a non positive pivot
+   */
+  bool factorize(const CSRMatrix<double>& A, double alpha) {
+    size_t n = A.rows();
+    L        = CSRMatrix<double>(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      bool hasDiagonal = false;
+      for(size_t k = A.indptr[i]; k < A.indptr[i + 1] && A.indices[k] <= i; ++k) {
+        L.indices.push_back(A.indices[k]);
+        L.values.push_back(A.indices[k] == i ? (1.0 + alpha) * A.values[k] : A.values[k]);
+        hasDiagonal = A.indices[k] == i;
+      }
+      if(!hasDiagonal) return false;
+      L.indptr[i + 1] = L.indices.size();
+    }
+
+    for(size_t i = 0; i < n; ++i) {
+      size_t start = L.indptr[i], diagK = L.indptr[i + 1] - 1;
+      for(size_t k = start; k <= diagK; ++k) {
+        size_t j = L.indices[k];
+        // s = sum_{c < j} L(i, c) * L(j, c), merged over the sorted rows i and j
+        double s = 0.0;
+        size_t a = start, b = L.indptr[j], bEnd = L.indptr[j + 1] - 1;
+        while(a < k && b < bEnd) {
+          if(L.indices[a] < L.indices[b]) ++a;
+          else if(L.indices[b] < L.indices[a]) ++b;
+          else s += L.values[a++] * L.values[b++];
+        }
+        if(j < i) {
+          L.values[k] = (L.values[k] - s) / L.values[L.indptr[j + 1] - 1];
+        } else {
+          double d = L.values[k] - s;
+          if(d <= 0.0) return false;
+          L.values[k] = std::sqrt(d);
+        }
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * ILU(0) preconditioner for general sparse matrices
+ * @param A sparse matrix, all diagonal elements have to be stored
+ * @returns preconditioner
+ */
+inline Preconditioner iluPreconditioner(const CSRMatrix<double>& A) {
+  auto factor = std::make_shared<ILU0>(A);
+  return [factor](const Matrix<double>& r) { return factor->solve(r); };
+}
+
+/**
+ * IC(0) preconditioner for symmetric positive definite sparse matrices, can be used with cg()
+ * @param A symmetric positive definite sparse matrix
+ * @returns preconditioner
+ */
+inline Preconditioner icPreconditioner(const CSRMatrix<double>& A) {
+  auto factor = std::make_shared<IC0>(A);
+  return [factor](const Matrix<double>& r) { return factor->solve(r); };
+}
+
+/**
+ * \example numerics/lin_alg/TestKrylov.cpp
+ * This is an example on how to use the Krylov solvers.
+ */
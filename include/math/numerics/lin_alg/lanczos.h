@@ -0,0 +1,300 @@
+/**
+ * @file lanczos.h
+ *
+ * Matrix-free thick-restart Lanczos method to approximate the k largest (or smallest)
+ * eigenpairs of a symmetric operator $$A\in\mathbf{R}^{n\times n}$$.
+ *
+ * The solver only requires a callback computing $$y = A\cdot x$$, therefore it works with
+ * dense matrices, sparse storage formats or implicit products such as $$X^T X$$ which never
+ * need to be formed. Memory requirements are O(n * m) with m the size of the Lanczos basis
+ * (defaults to roughly 2k).
+ *
+ * Usage:
+ * \code
+ * // 5 leading eigenpairs of X^T X without forming the Gram matrix
+ * auto res = lanczos(gramOperator(X), X.columns(), 5);
+ * // res.values: 5 x 1, res.vectors: X.columns() x 5
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/lanczos.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../../matrix_utils.h"
+#include "../utils.h"
+#include "LinearOperator.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+/**
+ * Option struct for the Lanczos eigensolver
+ */
+struct LanczosOption {
+  //! number of basis vectors per restart cycle, 0 selects min(n, max(2k + 1, k + 20))
+  size_t basisSize = 0;
+  //! tolerance of the Ritz residuals relative to the magnitude of the eigenvalue
+  double TOL = 1e-10;
+  //! max number of thick restarts
+  int maxRestarts = 300;
+  //! approximate the largest (true) or the smallest (false) eigenvalues
+  bool largest = true;
+};
+
+/**
+ * Representation of the result of an iterative eigensolver
+ */
+struct EigenResult {
+  //! eigenvalues in descending (largest) or ascending (smallest) order, k x 1
+  Matrix<double> values;
+  //! corresponding orthonormal eigenvectors stored column wise, n x k
+  Matrix<double> vectors;
+  //! number of performed restarts
+  int restarts = 0;
+  //! number of operator applications
+  size_t matvecs = 0;
+  //! true if all requested eigenpairs satisfy the tolerance
+  bool converged = false;
+};
+
+/**
+ * Cyclic Jacobi eigenvalue algorithm for small dense symmetric matrices.
+ *
+ * Used to diagonalize the projected matrix of the Lanczos method.
+ *
+ * @param S symmetric matrix
+ * @param maxSweeps maximum number of sweeps over all off-diagonal elements
+ * @returns { eigenvalues (n x 1), eigenvectors (column wise, n x n) }, unordered
+ */
+inline std::pair<Matrix<double>, Matrix<double>> jacobiEigen(const Matrix<double>& S, int maxSweeps = 100) {
+  size_t n = S.rows();
+  auto A   = S;
+  auto V   = eye(n);
+
+  for(int sweep = 0; sweep < maxSweeps; ++sweep) {
+    double off = 0.0, total = 0.0;
+    for(size_t p = 0; p < n; ++p) {
+      for(size_t q = 0; q < n; ++q) {
+        total += A(p, q) * A(p, q);
+        if(p != q) off += A(p, q) * A(p, q);
+      }
+    }
+    if(off <= 1e-30 * total || off == 0.0) break;
+
+    for(size_t p = 0; p < n; ++p) {
+      for(size_t q = p + 1; q < n; ++q) {
+        double apq = A(p, q);
+        if(std::abs(apq) < 1e-300) continue;
+        double theta = (A(q, q) - A(p, p)) / (2.0 * apq);
+        double t     = 1.0 / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        if(theta < 0) t = -t;
+        double c = 1.0 / std::sqrt(t * t + 1.0);
+        double s = t * c;
+
+        for(size_t r = 0; r < n; ++r) {
+          if(r == p || r == q) continue;
+          double arp = A(r, p), arq = A(r, q);
+          A(r, p) = A(p, r) = c * arp - s * arq;
+          A(r, q) = A(q, r) = s * arp + c * arq;
+        }
+        A(p, p) -= t * apq;
+        A(q, q) += t * apq;
+        A(p, q) = A(q, p) = 0.0;
+
+        for(size_t r = 0; r < n; ++r) {
+          double vrp = V(r, p), vrq = V(r, q);
+          V(r, p) = c * vrp - s * vrq;
+          V(r, q) = s * vrp + c * vrq;
+        }
+      }
+    }
+  }
+  return { diag_elements(A), V };
+}
+
+/**
+ * Implicit Gram operator $$x \mapsto X^T (X x)$$ which never forms $$X^T X$$.
+ *
+ * **Note** the operator references X, it has to outlive the returned operator.
+ *
+ * @param X data matrix with dimension n_samples x n_features
+ * @returns linear operator of dimension n_features x n_features
+ */
+inline LinearOperator gramOperator(const Matrix<double>& X) {
+  return [&X](const Matrix<double>& x) {
+    size_t n = X.rows(), m = X.columns();
+    std::vector<double> Xx(n, 0.0);
+    const double* data = &X(0, 0);
+    for(size_t i = 0; i < n; ++i) {
+      double s = 0.0;
+      for(size_t j = 0; j < m; ++j) { s += data[i * m + j] * x(j, 0); }
+      Xx[i] = s;
+    }
+    Matrix<double> y(0, m, 1);
+    double* out = &y(0, 0);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < m; ++j) { out[j] += data[i * m + j] * Xx[i]; }
+    }
+    return y;
+  };
+}
+
+/**
+ * Thick-restart Lanczos method for symmetric operators.
+ *
+ * Builds an orthonormal Krylov basis of size m (with full re-orthogonalization), computes Ritz pairs of
+ * the projected m x m matrix and restarts with the best Ritz vectors until the residuals
+ * $$\|A y_i - \theta_i y_i\| = |\beta_m s_{m,i}|$$ of the requested k pairs drop below the tolerance.
+ *
+ * @param A linear operator, has to be symmetric
+ * @param n dimension of the operator
+ * @param k number of requested eigenpairs
+ * @param option solver options
+ * @returns k approximated eigenpairs
+ */
+inline EigenResult lanczos(const LinearOperator& A, size_t n, size_t k, const LanczosOption& option = {}) {
+  EigenResult result;
+  if(k == 0 || n == 0) { return result; }
+  if(k > n) k = n;
+
+  size_t m = option.basisSize > 0 ? option.basisSize : std::max(2 * k + 1, k + 20);
+  m        = std::min(std::max(m, k + 1), n);
+
+  // basis vectors V_0, ..., V_m stored contiguously
+  std::vector<double> V((m + 1) * n, 0.0);
+  std::vector<double> w(n);
+  Matrix<double> T(0, m, m);
+  Matrix<double> x(0, n, 1);
+
+  auto dot = [n](const double* a, const double* b) {
+    double s = 0.0;
+    for(size_t i = 0; i < n; ++i) { s += a[i] * b[i]; }
+    return s;
+  };
+  auto randomUnitVector = [&](double* v, size_t orthogonalTo) {
+    for(int attempt = 0; attempt < 10; ++attempt) {
+      for(size_t i = 0; i < n; ++i) { v[i] = Random::Get(-1.0, 1.0); }
+      for(int pass = 0; pass < 2; ++pass) {
+        for(size_t i = 0; i < orthogonalTo; ++i) {
+          double h = dot(&V[i * n], v);
+          for(size_t l = 0; l < n; ++l) { v[l] -= h * V[i * n + l]; }
+        }
+      }
+      double nrm = std::sqrt(dot(v, v));
+      if(nrm > 1e-10) {
+        for(size_t l = 0; l < n; ++l) { v[l] /= nrm; }
+        return;
+      }
+    }
+  };
+
+  randomUnitVector(&V[0], 0);
+
+  size_t kept = 0;
+  double beta = 0.0;
+  Matrix<double> theta, S;
+  std::vector<size_t> order(m);
+
+  for(int restart = 0;; ++restart) {
+    // expand the basis from `kept` to m vectors
+    for(size_t j = kept; j < m; ++j) {
+      const double* vj = &V[j * n];
+      for(size_t i = 0; i < n; ++i) { x(i, 0) = vj[i]; }
+      auto Ax = A(x);
+      result.matvecs++;
+      for(size_t i = 0; i < n; ++i) { w[i] = Ax(i, 0); }
+
+      // modified Gram-Schmidt, applied twice for numerical orthogonality
+      for(int pass = 0; pass < 2; ++pass) {
+        for(size_t i = 0; i <= j; ++i) {
+          double h = dot(&V[i * n], w.data());
+          for(size_t l = 0; l < n; ++l) { w[l] -= h * V[i * n + l]; }
+          T(i, j) += h;
+        }
+      }
+      for(size_t i = 0; i < j; ++i) { T(j, i) = T(i, j); }
+
+      beta         = std::sqrt(dot(w.data(), w.data()));
+      double scale = std::abs(T(j, j)) > 1.0 ? std::abs(T(j, j)) : 1.0;
+      if(beta > 1e-12 * scale) {
+        for(size_t l = 0; l < n; ++l) { V[(j + 1) * n + l] = w[l] / beta; }
+      } else {
+        // invariant subspace found, continue with a fresh direction
+        beta = 0.0;
+        if(j + 1 < n) randomUnitVector(&V[(j + 1) * n], j + 1);
+      }
+    }
+
+    auto eig = jacobiEigen(T);
+    theta    = eig.first;
+    S        = eig.second;
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return option.largest ? theta(a, 0) > theta(b, 0) : theta(a, 0) < theta(b, 0);
+    });
+
+    bool converged = true;
+    for(size_t i = 0; i < k; ++i) {
+      double residual = std::abs(beta * S(m - 1, order[i]));
+      double scale    = std::abs(theta(order[i], 0)) > 1e-300 ? std::abs(theta(order[i], 0)) : 1.0;
+      if(residual > option.TOL * scale) { converged = false; }
+    }
+
+    if(converged || restart >= option.maxRestarts || m == n) {
+      result.converged = converged || m == n;
+      result.restarts  = restart;
+      break;
+    }
+
+    // thick restart: keep p Ritz vectors and the residual direction
+    size_t p = std::min(k + (m - k) / 2, m - 1);
+    std::vector<double> Y(p * n, 0.0);
+    for(size_t i = 0; i < p; ++i) {
+      for(size_t l = 0; l < m; ++l) {
+        double s = S(l, order[i]);
+        for(size_t r = 0; r < n; ++r) { Y[i * n + r] += s * V[l * n + r]; }
+      }
+    }
+    std::copy(V.begin() + m * n, V.begin() + (m + 1) * n, V.begin() + p * n);
+    std::copy(Y.begin(), Y.end(), V.begin());
+
+    T = Matrix<double>(0, m, m);
+    for(size_t i = 0; i < p; ++i) { T(i, i) = theta(order[i], 0); }
+    kept = p;
+  }
+
+  result.values  = Matrix<double>(0, k, 1);
+  result.vectors = Matrix<double>(0, n, k);
+  for(size_t i = 0; i < k; ++i) {
+    result.values(i, 0) = theta(order[i], 0);
+    for(size_t l = 0; l < m; ++l) {
+      double s = S(l, order[i]);
+      for(size_t r = 0; r < n; ++r) { result.vectors(r, i) += s * V[l * n + r]; }
+    }
+  }
+  return result;
+}
+
+/**
+ * Lanczos method for dense symmetric matrices.
+ *
+ * @param A symmetric matrix
+ * @param k number of requested eigenpairs
+ * @param option solver options
+ * @returns k approximated eigenpairs
+ */
+inline EigenResult lanczos(const Matrix<double>& A, size_t k, const LanczosOption& option = {}) {
+  assert(A.rows() == A.columns());
+  return lanczos(asOperator(A), A.rows(), k, option);
+}
+
+/**
+ * \example numerics/lin_alg/TestLanczos.cpp
+ * This is an example on how to use the lanczos method.
+ */
@@ -0,0 +1,136 @@
+/**
+ * @file mixedPrecision.h
+ *
+ * Mixed precision solver for dense systems $$Ax = b$$.
+ *
+ * A is factorized in single precision (half the memory traffic, twice the SIMD width), the solution
+ * is recovered to double precision accuracy by iterative refinement
+ * $$r = b - Ax, \quad A d = r, \quad x \leftarrow x + d$$
+ * with residuals in double precision and corrections by the single precision factors. The system
+ * is solved by a double precision LU decomposition instead if A or b exceed the float range, the
+ * single precision factors are not finite or the residual stops decreasing, e.g. if A is too
+ * ill-conditioned for the refinement to converge (roughly cond(A) > 1e7).
+ *
+ * Usage:
+ * \code
+ * auto res = mixedPrecisionSolve(A, b);
+ * if(res.fallback) { ... }  // single precision factors were insufficient
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/mixedPrecision.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../utils.h"
+#include "LU.h"
+#include "gemm.h"
+#include <cmath>
+#include <limits>
+
+/**
+ * Result of mixedPrecisionSolve
+ */
+struct RefinementResult {
+  //! solution
+  Matrix<double> x;
+  //! number of refinement steps
+  int iterations = 0;
+  //! true if the refinement reached double precision accuracy
+  bool converged = false;
+  //! true if the system was solved in double precision after single precision or the refinement failed
+  bool fallback = false;
+};
+
+/**
+ * Solves $$Ax = b$$ by single precision LU and double precision iterative refinement.
+ *
+ * Converged if $$\|r\| \le \|x\| \|A\| \varepsilon \sqrt{n}$$ holds for every right hand side
+ * (criterion of LAPACK's dsgesv). Falls back to double precision as soon as the float conversion or
+ * factorization produces non-finite values or the residual norm does not decrease.
+ *
+ * @param A square coefficient matrix
+ * @param b right hand side(s)
+ * @param maxIter maximum number of refinement steps
+ * @returns solution and refinement statistics
+ */
+inline RefinementResult mixedPrecisionSolve(const Matrix<double>& A, const Matrix<double>& b, int maxIter = 30) {
+  RefinementResult res;
+  size_t n = A.rows();
+  if(n != A.columns() || n != b.rows()) {
+    std::cerr << "mixedPrecisionSolve: dimension mismatch" << std::endl;
+    return res;
+  }
+  if(n == 0 || b.columns() == 0) {
+    res.x         = b;
+    res.converged = true;
+    return res;
+  }
+
+  // entries beyond the float range, overflow or a zero pivot in the single precision factors
+  // (checks of LAPACK's dsgesv) go to double precision right away
+  auto finite = [](const auto& M) {
+    for(size_t i = 0; i < M.rows(); ++i) {
+      for(size_t j = 0; j < M.columns(); ++j) {
+        if(!std::isfinite(M(i, j))) return false;
+      }
+    }
+    return true;
+  };
+  auto floatRange = [](const Matrix<double>& M) {
+    for(size_t i = 0; i < M.rows(); ++i) {
+      for(size_t j = 0; j < M.columns(); ++j) {
+        if(!(std::abs(M(i, j)) <= std::numeric_limits<float>::max())) return false;
+      }
+    }
+    return true;
+  };
+  std::pair<Matrix<float>, std::vector<unsigned int>> LRf;
+  if(floatRange(A) && floatRange(b)) {
+    LRf   = LU(Matrix<float>(A));
+    res.x = finite(LRf.first) ? Matrix<double>(luSolve(LRf, Matrix<float>(b))) : Matrix<double>();
+  }
+  double threshold = norm(A) * std::numeric_limits<double>::epsilon() * std::sqrt((double)n);
+
+  Matrix<double> r(0, n, b.columns());
+  double previous = std::numeric_limits<double>::infinity();
+  for(; res.x.rows() == n && finite(res.x) && res.iterations <= maxIter; ++res.iterations) {
+    // r = b - A x in double precision
+    r = b;
+    gemm<double>(n, b.columns(), n, -1.0, &A(0, 0), n, &res.x(0, 0), b.columns(), 1.0, &r(0, 0), b.columns());
+
+    bool converged = true;
+    double total   = 0;
+    for(size_t c = 0; c < b.columns(); ++c) {
+      double rNorm = 0, xNorm = 0;
+      for(size_t i = 0; i < n; ++i) {
+        rNorm += r(i, c) * r(i, c);
+        xNorm += res.x(i, c) * res.x(i, c);
+      }
+      converged = converged && std::sqrt(rNorm) <= std::sqrt(xNorm) * threshold;
+      total += rNorm;
+    }
+    if(converged) {
+      res.converged = true;
+      return res;
+    }
+    // stagnation or divergence of the refinement
+    if(res.iterations == maxIter || !(total < previous)) break;
+    previous = total;
+    if(!floatRange(r)) break;
+    res.x += Matrix<double>(luSolve(LRf, Matrix<float>(r)));
+  }
+
+  // refinement stagnated or single precision failed, double precision factorization
+  res.x        = luSolve(LU(A), b);
+  res.fallback = true;
+  return res;
+}
+
+/**
+ * \example numerics/lin_alg/TestMixedPrecision.cpp
+ * This is an example on how to use mixedPrecisionSolve.
+ */
@@ -0,0 +1,435 @@
+/**
+ * @file multigrid.h
+ *
+ * Geometric multigrid solver for the (shifted) Poisson equation
+ * $$-\Delta u + c\,u = f$$
+ * on 1D, 2D and 3D structured grids with n interior points per dimension and homogeneous Dirichlet
+ * boundary conditions, discretized by the standard 3/5/7 point stencil.
+ *
+ * Components:
+ * - smoothers: weighted Jacobi and red-black Gauss-Seidel
+ * - restriction: full weighting, prolongation: (multi-)linear interpolation
+ * - V- and W-cycles, full multigrid (FMG) start
+ * - preconditioner() for the Krylov solvers of krylov.h
+ *
+ * A cycle requires O(n^d) operations, grids with n = 2^k - 1 coarsen down to a single point.
+ * The coarsest grid is solved by cg().
+ *
+ * Usage:
+ * \code
+ * Multigrid mg(2, 127);
+ * auto res = mg.solve(f); // f: 127^2 x 1, row-major grid values
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/multigrid.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "SparseMatrix.h"
+#include "krylov.h"
+#include <cmath>
+#include <vector>
+
+/**
+ * Multigrid cycle type, the value equals the number of recursive coarse grid corrections
+ */
+enum MultigridCycle {
+  //! one coarse grid correction per level
+  V_CYCLE = 1,
+  //! two coarse grid corrections per level
+  W_CYCLE = 2
+};
+
+/**
+ * Smoothing method of the multigrid solver
+ */
+enum MultigridSmoother {
+  //! damped Jacobi with damping factor omega
+  JACOBI_SMOOTHER = 0,
+  //! red-black Gauss-Seidel, post smoothing in reversed color order keeps the cycle symmetric
+  RED_BLACK_SMOOTHER = 1
+};
+
+/**
+ * Option struct for the multigrid solver
+ */
+struct MultigridOption {
+  //! cycle type
+  MultigridCycle cycle = V_CYCLE;
+  //! smoothing method
+  MultigridSmoother smoother = RED_BLACK_SMOOTHER;
+  //! number of pre smoothing sweeps
+  size_t preSmooth = 2;
+  //! number of post smoothing sweeps
+  size_t postSmooth = 2;
+  //! damping factor of the Jacobi smoother
+  double omega = 2.0 / 3.0;
+  //! relative residual tolerance of solve()
+  double TOL = 1e-10;
+  //! max number of cycles of solve()
+  size_t maxCycles = 50;
+  //! start solve() with a full multigrid pass if no initial guess is given
+  bool fullMultigrid = true;
+};
+
+/**
+ * Geometric multigrid hierarchy for the shifted Poisson equation on the unit square/cube
+ */
+class Multigrid
+{
+public:
+  //! solver options
+  MultigridOption option;
+
+  /**
+   * Creates the grid hierarchy
+   * @param dimension spatial dimension, 1, 2 or 3
+   * @param n number of interior grid points per dimension
+   * @param shift non negative constant c of -Δu + c u
+   * @param h grid spacing, 0 selects 1 / (n + 1)
+   * @param _option solver options
+   */
+  Multigrid(size_t dimension, size_t n, double shift = 0.0, double h = 0.0, const MultigridOption& _option = {})
+    : option(_option)
+    , _dimension(dimension)
+    , _shift(shift) {
+    assert(dimension >= 1 && dimension <= 3 && n >= 1 && shift >= 0.0);
+    Level level { n, h > 0.0 ? h : 1.0 / double(n + 1) };
+    _levels.push_back(level);
+    while(level.n >= 3 && level.n % 2 == 1) {
+      level = { (level.n - 1) / 2, 2.0 * level.h };
+      _levels.push_back(level);
+    }
+  }
+
+  /**
+   * @returns number of grid levels
+   */
+  [[nodiscard]] size_t levels() const { return _levels.size(); }
+
+  /**
+   * @returns number of unknowns on the finest grid
+   */
+  [[nodiscard]] size_t unknowns() const { return size(0); }
+
+  /**
+   * Applies the discrete operator of the finest grid
+   * @param u grid values, unknowns() x 1
+   * @returns A u
+   */
+  [[nodiscard]] Matrix<double> apply(const Matrix<double>& u) const {
+    std::vector<double> x(&u(0, 0), &u(0, 0) + size(0)), y(size(0));
+    applyOperator(0, x, y);
+    return toMatrix(y);
+  }
+
+  /**
+   * Assembles the operator of the finest grid as sparse matrix
+   * @returns unknowns() x unknowns() matrix
+   */
+  [[nodiscard]] CSRMatrix<double> Assemble() const {
+    size_t N = size(0), n = _levels[0].n;
+    double invH2 = 1.0 / (_levels[0].h * _levels[0].h);
+    COOMatrix<double> coo(N, N);
+    coo.reserve(N * (2 * _dimension + 1));
+    for(size_t idx = 0; idx < N; ++idx) {
+      coo.add(idx, idx, 2.0 * _dimension * invH2 + _shift);
+      for(size_t d = 0, stride = 1; d < _dimension; ++d, stride *= n) {
+        size_t coordinate = (idx / stride) % n;
+        if(coordinate > 0) coo.add(idx, idx - stride, -invH2);
+        if(coordinate + 1 < n) coo.add(idx, idx + stride, -invH2);
+      }
+    }
+    return CSRMatrix<double>(coo);
+  }
+
+  /**
+   * Performs a single multigrid cycle
+   * @param u current approximation, unknowns() x 1
+   * @param f right hand side, unknowns() x 1
+   * @returns improved approximation
+   */
+  [[nodiscard]] Matrix<double> cycle(const Matrix<double>& u, const Matrix<double>& f) const {
+    std::vector<double> x(&u(0, 0), &u(0, 0) + size(0)), b(&f(0, 0), &f(0, 0) + size(0));
+    cycle(0, x, b);
+    return toMatrix(x);
+  }
+
+  /**
+   * Full multigrid: solves on the coarsest grid and interpolates the solution to the finer grids,
+   * followed by one cycle per level. Yields an approximation within the discretization error.
+   * @param f right hand side, unknowns() x 1
+   * @returns approximation of u
+   */
+  [[nodiscard]] Matrix<double> fullMultigrid(const Matrix<double>& f) const {
+    std::vector<std::vector<double>> rhs(levels());
+    rhs[0].assign(&f(0, 0), &f(0, 0) + size(0));
+    for(size_t l = 1; l < levels(); ++l) { rhs[l] = restriction(l - 1, rhs[l - 1]); }
+
+    std::vector<double> u(size(levels() - 1), 0.0);
+    coarseSolve(rhs[levels() - 1], u);
+    for(size_t l = levels() - 1; l-- > 0;) {
+      u = prolongation(l, u);
+      cycle(l, u, rhs[l]);
+    }
+    return toMatrix(u);
+  }
+
+  /**
+   * Iterates multigrid cycles until the relative residual drops below option.TOL
+   * @param f right hand side, unknowns() x 1
+   * @param x0 initial guess, full multigrid start (or zero) if empty
+   * @returns approximated solution and residual history
+   */
+  [[nodiscard]] KrylovResult solve(const Matrix<double>& f, const Matrix<double>& x0 = Matrix<double>()) const {
+    KrylovResult result;
+    size_t N = size(0);
+    std::vector<double> b(&f(0, 0), &f(0, 0) + N), x(N, 0.0), r(N);
+    if(x0.rows() == N) {
+      x.assign(&x0(0, 0), &x0(0, 0) + N);
+    } else if(option.fullMultigrid) {
+      auto start = fullMultigrid(f);
+      x.assign(&start(0, 0), &start(0, 0) + N);
+    }
+
+    double bNorm = std::sqrt(dot(b, b));
+    for(size_t it = 0;; ++it) {
+      residual(0, x, b, r);
+      double rNorm = std::sqrt(dot(r, r));
+      result.residuals.push_back(rNorm);
+      result.iterations = it;
+      if(rNorm <= option.TOL * bNorm) {
+        result.converged = true;
+        break;
+      }
+      if(it >= option.maxCycles) break;
+      cycle(0, x, b);
+    }
+    result.x = toMatrix(x);
+    return result;
+  }
+
+  /**
+   * One cycle starting at zero as preconditioner for cg(), bicgstab() or gmres().
+   *
+   * **Note** the preconditioner references this object, it has to outlive the returned preconditioner.
+   * @returns preconditioner approximating A^{-1}
+   */
+  [[nodiscard]] Preconditioner preconditioner() const {
+    return [this](const Matrix<double>& r) {
+      std::vector<double> x(size(0), 0.0), b(&r(0, 0), &r(0, 0) + size(0));
+      cycle(0, x, b);
+      return toMatrix(x);
+    };
+  }
+
+private:
+  /**
+   * grid level
+   */
+  struct Level {
+    //! interior points per dimension
+    size_t n;
+    //! grid spacing
+    double h;
+  };
+
+  //! spatial dimension
+  size_t _dimension;
+  //! constant c of -Δu + c u
+  double _shift;
+  //! grid hierarchy, finest first
+  std::vector<Level> _levels;
+
+  /**
+   * @returns number of unknowns on level l
+   */
+  [[nodiscard]] size_t size(size_t l) const {
+    size_t N = 1;
+    for(size_t d = 0; d < _dimension; ++d) { N *= _levels[l].n; }
+    return N;
+  }
+
+  static Matrix<double> toMatrix(const std::vector<double>& x) {
+    Matrix<double> out(0, x.size(), 1);
+    std::copy(x.begin(), x.end(), &out(0, 0));
+    return out;
+  }
+
+  static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double s = 0.0;
+    for(size_t i = 0; i < a.size(); ++i) { s += a[i] * b[i]; }
+    return s;
+  }
+
+  /**
+   * sum of the neighbouring values of grid point idx (zero outside the domain)
+   */
+  [[nodiscard]] inline double neighbours(size_t l, const std::vector<double>& u, size_t idx) const {
+    size_t n = _levels[l].n;
+    double s = 0.0;
+    for(size_t d = 0, stride = 1; d < _dimension; ++d, stride *= n) {
+      size_t coordinate = (idx / stride) % n;
+      if(coordinate > 0) s += u[idx - stride];
+      if(coordinate + 1 < n) s += u[idx + stride];
+    }
+    return s;
+  }
+
+  /**
+   * @returns diagonal element of the operator on level l
+   */
+  [[nodiscard]] inline double diagonal(size_t l) const {
+    return 2.0 * _dimension / (_levels[l].h * _levels[l].h) + _shift;
+  }
+
+  /**
+   * y = A_l u
+   */
+  void applyOperator(size_t l, const std::vector<double>& u, std::vector<double>& y) const {
+    double invH2 = 1.0 / (_levels[l].h * _levels[l].h), d = diagonal(l);
+    for(size_t idx = 0; idx < u.size(); ++idx) { y[idx] = d * u[idx] - invH2 * neighbours(l, u, idx); }
+  }
+
+  /**
+   * r = f - A_l u
+   */
+  void residual(size_t l, const std::vector<double>& u, const std::vector<double>& f, std::vector<double>& r) const {
+    applyOperator(l, u, r);
+    for(size_t idx = 0; idx < u.size(); ++idx) { r[idx] = f[idx] - r[idx]; }
+  }
+
+  /**
+   * @returns parity of the coordinate sum of grid point idx
+   */
+  [[nodiscard]] inline size_t color(size_t l, size_t idx) const {
+    size_t n = _levels[l].n, sum = 0;
+    for(size_t d = 0; d < _dimension; ++d, idx /= n) { sum += idx % n; }
+    return sum % 2;
+  }
+
+  /**
+   * smoothing sweeps on level l
+   * @param reverse process black before red points
+   */
+  void smooth(size_t l, std::vector<double>& u, const std::vector<double>& f, size_t sweeps, bool reverse) const {
+    double invH2 = 1.0 / (_levels[l].h * _levels[l].h), d = diagonal(l);
+    size_t N     = u.size();
+    for(size_t sweep = 0; sweep < sweeps; ++sweep) {
+      if(option.smoother == JACOBI_SMOOTHER) {
+        std::vector<double> old = u;
+        for(size_t idx = 0; idx < N; ++idx) {
+          u[idx] = (1.0 - option.omega) * old[idx] + option.omega * (f[idx] + invH2 * neighbours(l, old, idx)) / d;
+        }
+      } else {
+        for(size_t pass = 0; pass < 2; ++pass) {
+          size_t active = reverse ? 1 - pass : pass;
+          for(size_t idx = 0; idx < N; ++idx) {
+            if(color(l, idx) == active) u[idx] = (f[idx] + invH2 * neighbours(l, u, idx)) / d;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Full weighting restriction from level l to level l + 1, tensor product of the stencil [1/4, 1/2, 1/4]
+   */
+  [[nodiscard]] std::vector<double> restriction(size_t l, const std::vector<double>& fine) const {
+    size_t n = _levels[l].n, nc = _levels[l + 1].n;
+    std::vector<double> current = fine;
+    std::vector<size_t> extent(_dimension, n);
+    for(size_t axis = 0; axis < _dimension; ++axis) {
+      // axis 0 varies fastest
+      size_t inner = 1, outer = 1;
+      for(size_t d = 0; d < axis; ++d) { inner *= extent[d]; }
+      for(size_t d = axis + 1; d < _dimension; ++d) { outer *= extent[d]; }
+      std::vector<double> next(inner * nc * outer);
+      for(size_t o = 0; o < outer; ++o) {
+        for(size_t I = 0; I < nc; ++I) {
+          for(size_t i = 0; i < inner; ++i) {
+            auto at = [&](size_t k) { return current[(o * n + k) * inner + i]; };
+            next[(o * nc + I) * inner + i] = 0.25 * at(2 * I) + 0.5 * at(2 * I + 1) + 0.25 * at(2 * I + 2);
+          }
+        }
+      }
+      current      = std::move(next);
+      extent[axis] = nc;
+    }
+    return current;
+  }
+
+  /**
+   * Linear interpolation from level l + 1 to level l, tensor product of the stencil [1/2, 1, 1/2]
+   */
+  [[nodiscard]] std::vector<double> prolongation(size_t l, const std::vector<double>& coarse) const {
+    size_t n = _levels[l].n, nc = _levels[l + 1].n;
+    std::vector<double> current = coarse;
+    std::vector<size_t> extent(_dimension, nc);
+    for(size_t axis = 0; axis < _dimension; ++axis) {
+      size_t inner = 1, outer = 1;
+      for(size_t d = 0; d < axis; ++d) { inner *= extent[d]; }
+      for(size_t d = axis + 1; d < _dimension; ++d) { outer *= extent[d]; }
+      std::vector<double> next(inner * n * outer, 0.0);
+      for(size_t o = 0; o < outer; ++o) {
+        for(size_t I = 0; I < nc; ++I) {
+          for(size_t i = 0; i < inner; ++i) {
+            double v = current[(o * nc + I) * inner + i];
+            next[(o * n + 2 * I) * inner + i] += 0.5 * v;
+            next[(o * n + 2 * I + 1) * inner + i] += v;
+            next[(o * n + 2 * I + 2) * inner + i] += 0.5 * v;
+          }
+        }
+      }
+      current      = std::move(next);
+      extent[axis] = n;
+    }
+    return current;
+  }
+
+  /**
+   * solves the coarsest grid problem by cg()
+   */
+  void coarseSolve(const std::vector<double>& f, std::vector<double>& u) const {
+    size_t l          = levels() - 1;
+    LinearOperator op = [this, l](const Matrix<double>& x) {
+      std::vector<double> in(&x(0, 0), &x(0, 0) + x.rows()), out(x.rows());
+      applyOperator(l, in, out);
+      return toMatrix(out);
+    };
+    KrylovOption coarseOption;
+    coarseOption.TOL = 1e-14;
+    auto res         = cg(op, toMatrix(f), toMatrix(u), coarseOption);
+    u.assign(&res.x(0, 0), &res.x(0, 0) + u.size());
+  }
+
+  /**
+   * recursive multigrid cycle on level l
+   */
+  void cycle(size_t l, std::vector<double>& u, const std::vector<double>& f) const {
+    if(l + 1 == levels()) {
+      coarseSolve(f, u);
+      return;
+    }
+    smooth(l, u, f, option.preSmooth, false);
+
+    std::vector<double> r(u.size());
+    residual(l, u, f, r);
+    auto rc = restriction(l, r);
+    std::vector<double> ec(rc.size(), 0.0);
+    for(int i = 0; i < int(option.cycle); ++i) { cycle(l + 1, ec, rc); }
+    auto e = prolongation(l, ec);
+    for(size_t idx = 0; idx < u.size(); ++idx) { u[idx] += e[idx]; }
+
+    smooth(l, u, f, option.postSmooth, true);
+  }
+};
+
+/**
+ * \example numerics/lin_alg/TestMultigrid.cpp
+ * This is an example on how to use the multigrid solver.
+ */
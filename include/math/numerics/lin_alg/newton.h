@@ -11,18 +11,20 @@
 
 #pragma once
 #include "../utils.h"
+#include "finiteDifferences.h"
 #include "gaussSeidel.h"
+#include "sparseDirect.h"
 #include <functional>
 
 //! representation of jacobian
 using Jacobian = std::function<Matrix<double>(const Matrix<double>&)>;
-//! representation of linear equation
-using LinearEquation = std::function<Matrix<double>(const Matrix<double>&)>;
+//! representation of sparse jacobian
+using SparseJacobian = std::function<CSRMatrix<double>(const Matrix<double>&)>;
 
 /**
  * newton method to find roots of given function f
  * @param f linear equation
- * @param Df derivative of f
+ * @param Df derivative of f, nullptr for a finite difference jacobian
  * @param x0 start value
  * @param TOL desired tolerance of the method
  * @param maxIter maximum iterations for the method
@@ -40,8 +42,9 @@ newton(const LinearEquation& f, const Jacobian& Df, const Matrix<double>& x0, do
   double r = TOL + 1;
 
   while(r > TOL && iter < maxIter) {
-    auto D_F = Df(x);
-    auto F   = f(x) * -1.0;
+    auto fx  = f(x);
+    auto D_F = Df ? Df(x) : finiteDifferenceJacobian(f, x, fx);
+    auto F   = fx * -1.0;
 
     auto delta = gaussSeidel(D_F, F);
 
@@ -56,6 +59,52 @@ newton(const LinearEquation& f, const Jacobian& Df, const Matrix<double>& x0, do
   return { x, iter };
 }
 
+/**
+ * newton method for large systems with sparse jacobian.
+ *
+ * The newton steps are computed by SparseLU, the symbolic analysis of the first jacobian is reused
+ * as long as the sparsity pattern (indptr and indices) does not change.
+ *
+ * @param f linear equation
+ * @param Df sparse derivative of f
+ * @param x0 start value
+ * @param TOL desired tolerance of the method
+ * @param maxIter maximum iterations for the method
+ * @returns approximated values paired with required number iterations for given tolerance
+ */
+inline std::pair<Matrix<double>, int>
+sparseNewton(const LinearEquation& f, const SparseJacobian& Df, const Matrix<double>& x0, double TOL, int maxIter) {
+  auto x = x0;
+
+  int iter = 0;
+  double r = TOL + 1;
+  LUSymbolic symbolic;
+  // pattern of the analyzed jacobian
+  decltype(CSRMatrix<double>::indptr) indptr;
+  decltype(CSRMatrix<double>::indices) indices;
+
+  while(r > TOL && iter < maxIter) {
+    auto D_F = Df(x);
+    auto F   = f(x) * -1.0;
+
+    if(iter == 0 || D_F.indptr != indptr || D_F.indices != indices) {
+      symbolic = analyzeLU(D_F);
+      indptr   = D_F.indptr;
+      indices  = D_F.indices;
+    }
+    SparseLU lu(D_F, symbolic);
+    if(!lu.isRegular) break;
+    symbolic   = lu.symbolic;
+    auto delta = lu.solve(F);
+
+    x += delta;
+
+    r = norm(delta);
+    iter += 1;
+  }
+  return { x, iter };
+}
+
 /**
  * \example numerics/lin_alg/TestNewton.cpp
  * This is an example on how to use newton.
@@ -0,0 +1,617 @@
+/**
+ * @file sparseDirect.h
+ *
+ * Direct solvers for sparse systems of linear equations:
+ * - minimumDegreeOrdering(): fill-reducing symmetric ordering
+ * - SparseCholesky: up-looking Cholesky factorization $$P A P^T = L L^T$$
+ * - SparseLU: left-looking Gilbert-Peierls LU factorization $$P A Q = L U$$ with partial pivoting
+ * - sparseSolve(): sparse counterpart of gaussSeidel()
+ *
+ * Both factorizations split into a symbolic analysis (ordering, elimination tree, memory estimates)
+ * and a numeric factorization. The symbolic analysis only depends on the sparsity pattern and can be
+ * reused for matrices with the same pattern, e.g. the Jacobians of a Newton iteration.
+ *
+ * Usage:
+ * \code
+ * auto symbolic = analyzeCholesky(A);
+ * SparseCholesky chol(A, symbolic);
+ * auto x = chol.solve(b);
+ * chol.factorize(A2); // same pattern, symbolic analysis is reused
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/sparseDirect.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "SparseMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <set>
+#include <vector>
+
+/**
+ * Minimum degree ordering of the symmetric pattern of A + A^T.
+ *
+ * Uses a quotient graph representation (eliminated nodes become elements which absorb each other),
+ * therefore the memory requirements are bounded by O(nnz(A)) and no fill is formed explicitly.
+ *
+ * @param A square sparse matrix, only the pattern is used
+ * @returns permutation perm, row/column perm[k] of A becomes row/column k of the reordered matrix
+ */
+inline std::vector<size_t> minimumDegreeOrdering(const CSRMatrix<double>& A) {
+  assert(A.rows() == A.columns());
+  size_t n = A.rows();
+
+  // symmetric adjacency without diagonal
+  std::vector<std::vector<size_t>> adjacency(n);
+  for(size_t i = 0; i < n; ++i) {
+    for(size_t k = A.indptr[i]; k < A.indptr[i + 1]; ++k) {
+      size_t j = A.indices[k];
+      if(j == i) continue;
+      adjacency[i].push_back(j);
+      adjacency[j].push_back(i);
+    }
+  }
+  for(auto& adj : adjacency) {
+    std::sort(adj.begin(), adj.end());
+    adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
+  }
+
+  std::vector<std::vector<size_t>> elements(n), elementVariables(n);
+  std::vector<bool> eliminated(n, false), absorbed(n, false);
+  std::vector<size_t> degree(n), mark(n, 0), perm;
+  perm.reserve(n);
+  size_t stamp = 0;
+
+  std::set<std::pair<size_t, size_t>> queue;
+  for(size_t i = 0; i < n; ++i) {
+    degree[i] = adjacency[i].size();
+    queue.insert({ degree[i], i });
+  }
+
+  while(!queue.empty()) {
+    size_t p = queue.begin()->second;
+    queue.erase(queue.begin());
+    perm.push_back(p);
+    eliminated[p] = true;
+
+    // variables of the new element p: neighbours of p and of all elements adjacent to p
+    mark[p] = ++stamp;
+    std::vector<size_t> Lp;
+    for(size_t v : adjacency[p]) {
+      if(!eliminated[v] && mark[v] != stamp) {
+        mark[v] = stamp;
+        Lp.push_back(v);
+      }
+    }
+    for(size_t e : elements[p]) {
+      if(absorbed[e]) continue;
+      for(size_t v : elementVariables[e]) {
+        if(!eliminated[v] && mark[v] != stamp) {
+          mark[v] = stamp;
+          Lp.push_back(v);
+        }
+      }
+      absorbed[e] = true;
+      elementVariables[e].clear();
+      elementVariables[e].shrink_to_fit();
+    }
+    adjacency[p].clear();
+    elements[p].clear();
+    size_t elementStamp = stamp;
+
+    for(size_t i : Lp) {
+      auto& Ei = elements[i];
+      Ei.erase(std::remove_if(Ei.begin(), Ei.end(), [&](size_t e) { return absorbed[e]; }), Ei.end());
+      Ei.push_back(p);
+      // neighbours inside Lp are reachable through element p
+      auto& Ai = adjacency[i];
+      Ai.erase(std::remove_if(Ai.begin(), Ai.end(), [&](size_t v) { return eliminated[v] || mark[v] == elementStamp; }),
+               Ai.end());
+    }
+
+    for(size_t i : Lp) {
+      mark[i]    = ++stamp;
+      size_t deg = 0;
+      for(size_t v : adjacency[i]) {
+        if(mark[v] != stamp) {
+          mark[v] = stamp;
+          ++deg;
+        }
+      }
+      for(size_t e : elements[i]) {
+        for(size_t v : elementVariables[e]) {
+          if(!eliminated[v] && mark[v] != stamp) {
+            mark[v] = stamp;
+            ++deg;
+          }
+        }
+      }
+      queue.erase({ degree[i], i });
+      degree[i] = deg;
+      queue.insert({ deg, i });
+    }
+    elementVariables[p] = std::move(Lp);
+  }
+  return perm;
+}
+
+/**
+ * Symmetric permutation C = P A P^T, i.e. C(i, j) = A(perm[i], perm[j])
+ * @param A square sparse matrix
+ * @param perm permutation
+ * @returns permuted matrix
+ */
+inline CSRMatrix<double> permuteSymmetric(const CSRMatrix<double>& A, const std::vector<size_t>& perm) {
+  size_t n = A.rows();
+  std::vector<size_t> inverse(n);
+  for(size_t k = 0; k < n; ++k) { inverse[perm[k]] = k; }
+  COOMatrix<double> coo(n, n);
+  coo.reserve(A.nonZeros());
+  for(size_t i = 0; i < n; ++i) {
+    for(size_t k = A.indptr[i]; k < A.indptr[i + 1]; ++k) { coo.add(inverse[i], inverse[A.indices[k]], A.values[k]); }
+  }
+  return CSRMatrix<double>(coo);
+}
+
+/**
+ * Result of the symbolic analysis of a sparse Cholesky factorization
+ */
+struct CholeskySymbolic {
+  //! fill-reducing permutation
+  std::vector<size_t> perm;
+  //! elimination tree of the permuted matrix, parent[j] = n for roots
+  std::vector<size_t> parent;
+  //! column pointers of L, n + 1 entries
+  std::vector<size_t> columnPointers;
+};
+
+/**
+ * Computes the pattern of row k of L by traversing the elimination tree from the non zeros of C(k, 0:k-1).
+ * @param C symmetric (permuted) matrix
+ * @param k row index
+ * @param parent elimination tree
+ * @param stack output, the pattern is stored in stack[top], ..., stack[n - 1] in topological order
+ * @param mark work array, mark[i] == k for visited nodes
+ * @returns top
+ */
+inline size_t etreeReach(const CSRMatrix<double>& C, size_t k, const std::vector<size_t>& parent, std::vector<size_t>& stack,
+                         std::vector<size_t>& mark) {
+  size_t n   = C.rows(), top = n;
+  mark[k]    = k;
+  std::vector<size_t> path;
+  for(size_t p = C.indptr[k]; p < C.indptr[k + 1]; ++p) {
+    size_t i = C.indices[p];
+    if(i >= k) continue;
+    path.clear();
+    for(; mark[i] != k; i = parent[i]) {
+      path.push_back(i);
+      mark[i] = k;
+    }
+    while(!path.empty()) {
+      stack[--top] = path.back();
+      path.pop_back();
+    }
+  }
+  return top;
+}
+
+/**
+ * Symbolic analysis of the Cholesky factorization: ordering, elimination tree and column counts of L
+ * @param A symmetric sparse matrix, both triangles have to be stored
+ * @param reorder apply minimumDegreeOrdering(), identity permutation otherwise
+ * @returns symbolic factorization, reusable for all matrices with the same pattern
+ */
+inline CholeskySymbolic analyzeCholesky(const CSRMatrix<double>& A, bool reorder = true) {
+  assert(A.rows() == A.columns());
+  size_t n = A.rows();
+  CholeskySymbolic S;
+  if(reorder) {
+    S.perm = minimumDegreeOrdering(A);
+  } else {
+    S.perm.resize(n);
+    std::iota(S.perm.begin(), S.perm.end(), 0);
+  }
+  auto C = permuteSymmetric(A, S.perm);
+
+  // elimination tree with path compression
+  S.parent.assign(n, n);
+  std::vector<size_t> ancestor(n, n);
+  for(size_t k = 0; k < n; ++k) {
+    for(size_t p = C.indptr[k]; p < C.indptr[k + 1]; ++p) {
+      for(size_t i = C.indices[p]; i < k;) {
+        size_t next = ancestor[i];
+        ancestor[i] = k;
+        if(next == n) {
+          S.parent[i] = k;
+          break;
+        }
+        i = next;
+      }
+    }
+  }
+
+  // column counts: the pattern of row k of L contributes one element to every column in it
+  std::vector<size_t> counts(n, 1), stack(n), mark(n, n);
+  for(size_t k = 0; k < n; ++k) {
+    for(size_t top = etreeReach(C, k, S.parent, stack, mark); top < n; ++top) { counts[stack[top]]++; }
+  }
+  S.columnPointers.assign(n + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), S.columnPointers.begin() + 1);
+  return S;
+}
+
+/**
+ * Sparse Cholesky factorization $$P A P^T = L L^T$$ of symmetric positive definite matrices
+ */
+class SparseCholesky
+{
+public:
+  //! symbolic analysis
+  CholeskySymbolic symbolic;
+  //! lower triangular factor, diagonal stored first within every column
+  CSCMatrix<double> L;
+  //! false if a non positive pivot occurred
+  bool isPositiveDefinite = false;
+
+  /**
+   * Analyzes and factorizes given matrix
+   * @param A symmetric positive definite sparse matrix
+   */
+  explicit SparseCholesky(const CSRMatrix<double>& A)
+    : symbolic(analyzeCholesky(A)) {
+    factorize(A);
+  }
+
+  /**
+   * Factorizes given matrix using an existing symbolic analysis
+   * @param A symmetric positive definite sparse matrix
+   * @param S symbolic analysis of a matrix with the same pattern
+   */
+  SparseCholesky(const CSRMatrix<double>& A, const CholeskySymbolic& S)
+    : symbolic(S) {
+    factorize(A);
+  }
+
+  /**
+   * Numeric factorization (up-looking), reuses the symbolic analysis
+   * @param A symmetric positive definite matrix with the analyzed pattern
+   * @returns true if A is positive definite
+   */
+  bool factorize(const CSRMatrix<double>& A) {
+    size_t n = A.rows();
+    assert(symbolic.perm.size() == n);
+    auto C = permuteSymmetric(A, symbolic.perm);
+
+    L         = CSCMatrix<double>(n, n);
+    L.indptr  = symbolic.columnPointers;
+    L.indices.assign(L.indptr[n], 0);
+    L.values.assign(L.indptr[n], 0.0);
+    std::vector<size_t> next(L.indptr.begin(), L.indptr.end() - 1), stack(n), mark(n, n);
+    std::vector<double> x(n, 0.0);
+    isPositiveDefinite = true;
+
+    for(size_t k = 0; k < n; ++k) {
+      size_t top = etreeReach(C, k, symbolic.parent, stack, mark);
+      x[k]       = 0.0;
+      for(size_t p = C.indptr[k]; p < C.indptr[k + 1]; ++p) {
+        if(C.indices[p] <= k) x[C.indices[p]] = C.values[p];
+      }
+      double d = x[k];
+      x[k]     = 0.0;
+      // solve L(0:k-1, 0:k-1) * l_k = C(0:k-1, k) along the pattern of row k
+      for(; top < n; ++top) {
+        size_t i   = stack[top];
+        double lki = x[i] / L.values[L.indptr[i]];
+        x[i]       = 0.0;
+        for(size_t p = L.indptr[i] + 1; p < next[i]; ++p) { x[L.indices[p]] -= L.values[p] * lki; }
+        d -= lki * lki;
+        size_t p    = next[i]++;
+        L.indices[p] = k;
+        L.values[p]  = lki;
+      }
+      if(d <= 0.0) {
+        isPositiveDefinite = false;
+        return false;
+      }
+      size_t p     = next[k]++;
+      L.indices[p] = k;
+      L.values[p]  = std::sqrt(d);
+    }
+    return true;
+  }
+
+  /**
+   * Solves A x = b using the stored factorization
+   * @param b right hand side(s), n x m
+   * @returns x
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    size_t n = L.rows();
+    assert(b.rows() == n);
+    Matrix<double> out(0, n, b.columns());
+    std::vector<double> x(n);
+    for(size_t c = 0; c < b.columns(); ++c) {
+      for(size_t k = 0; k < n; ++k) { x[k] = b(symbolic.perm[k], c); }
+      for(size_t j = 0; j < n; ++j) {
+        x[j] /= L.values[L.indptr[j]];
+        for(size_t p = L.indptr[j] + 1; p < L.indptr[j + 1]; ++p) { x[L.indices[p]] -= L.values[p] * x[j]; }
+      }
+      for(size_t j = n; j-- > 0;) {
+        for(size_t p = L.indptr[j] + 1; p < L.indptr[j + 1]; ++p) { x[j] -= L.values[p] * x[L.indices[p]]; }
+        x[j] /= L.values[L.indptr[j]];
+      }
+      for(size_t k = 0; k < n; ++k) { out(symbolic.perm[k], c) = x[k]; }
+    }
+    return out;
+  }
+
+  /**
+   * @returns log of the determinant of A
+   */
+  [[nodiscard]] double logDet() const {
+    double s = 0.0;
+    for(size_t j = 0; j < L.columns(); ++j) { s += std::log(L.values[L.indptr[j]]); }
+    return 2.0 * s;
+  }
+};
+
+/**
+ * Result of the symbolic analysis of a sparse LU factorization
+ */
+struct LUSymbolic {
+  //! fill-reducing column permutation
+  std::vector<size_t> columnPerm;
+  //! expected number of non zeros of L, updated by every numeric factorization
+  size_t lnz = 0;
+  //! expected number of non zeros of U, updated by every numeric factorization
+  size_t unz = 0;
+};
+
+/**
+ * Symbolic analysis of the LU factorization
+ * @param A square sparse matrix
+ * @param reorder apply minimumDegreeOrdering() to the pattern of A + A^T, identity permutation otherwise
+ * @returns symbolic factorization, reusable for all matrices with the same pattern
+ */
+inline LUSymbolic analyzeLU(const CSRMatrix<double>& A, bool reorder = true) {
+  assert(A.rows() == A.columns());
+  LUSymbolic S;
+  if(reorder) {
+    S.columnPerm = minimumDegreeOrdering(A);
+  } else {
+    S.columnPerm.resize(A.rows());
+    std::iota(S.columnPerm.begin(), S.columnPerm.end(), 0);
+  }
+  S.lnz = S.unz = 4 * A.nonZeros() + A.rows();
+  return S;
+}
+
+/**
+ * Sparse LU factorization $$P A Q = L U$$ using the left-looking Gilbert-Peierls algorithm.
+ *
+ * Every column is computed by a sparse triangular solve whose pattern is found by a depth first
+ * search in the graph of L, so the work is proportional to the number of floating point operations.
+ * Rows are chosen by threshold partial pivoting, preferring the diagonal to preserve the ordering.
+ */
+class SparseLU
+{
+public:
+  //! symbolic analysis
+  LUSymbolic symbolic;
+  //! unit lower triangular factor, diagonal stored first within every column
+  CSCMatrix<double> L;
+  //! upper triangular factor, diagonal stored last within every column
+  CSCMatrix<double> U;
+  //! row permutation, row i of A becomes row rowPermInverse[i] of L U
+  std::vector<size_t> rowPermInverse;
+  //! the diagonal is kept as pivot if |a_kk| >= pivotTolerance * max |a_ik|
+  double pivotTolerance = 0.1;
+  //! false if the matrix is (numerically) singular
+  bool isRegular = false;
+
+  /**
+   * Analyzes and factorizes given matrix
+   * @param A square sparse matrix
+   */
+  explicit SparseLU(const CSRMatrix<double>& A)
+    : symbolic(analyzeLU(A)) {
+    factorize(A);
+  }
+
+  /**
+   * Factorizes given matrix using an existing symbolic analysis
+   * @param A square sparse matrix
+   * @param S symbolic analysis of a matrix with the same pattern
+   */
+  SparseLU(const CSRMatrix<double>& A, const LUSymbolic& S)
+    : symbolic(S) {
+    factorize(A);
+  }
+
+  /**
+   * Numeric factorization, reuses the column ordering and memory estimates of the symbolic analysis
+   * @param A square sparse matrix with the analyzed pattern
+   * @returns true if A is regular
+   */
+  bool factorize(const CSRMatrix<double>& A) {
+    size_t n = A.rows();
+    assert(symbolic.columnPerm.size() == n);
+    auto B = A.ToCSC();
+
+    L = CSCMatrix<double>(n, n);
+    U = CSCMatrix<double>(n, n);
+    L.indices.reserve(symbolic.lnz);
+    L.values.reserve(symbolic.lnz);
+    U.indices.reserve(symbolic.unz);
+    U.values.reserve(symbolic.unz);
+    rowPermInverse.assign(n, NONE);
+    isRegular = true;
+
+    std::vector<double> x(n, 0.0);
+    std::vector<size_t> reach(n), stack(n), position(n);
+    std::vector<bool> marked(n, false);
+
+    for(size_t k = 0; k < n; ++k) {
+      L.indptr[k] = L.indices.size();
+      U.indptr[k] = U.indices.size();
+      size_t col  = symbolic.columnPerm[k];
+
+      // x = L \ A(:, col)
+      size_t top = reachOf(B, col, reach, stack, position, marked);
+      for(size_t p = top; p < n; ++p) { x[reach[p]] = 0.0; }
+      for(size_t p = B.indptr[col]; p < B.indptr[col + 1]; ++p) { x[B.indices[p]] = B.values[p]; }
+      for(size_t p = top; p < n; ++p) {
+        size_t j = reach[p], J = rowPermInverse[j];
+        if(J == NONE) continue;
+        for(size_t q = L.indptr[J] + 1; q < L.indptr[J + 1]; ++q) { x[L.indices[q]] -= L.values[q] * x[j]; }
+      }
+
+      // pivot search among the rows which are not pivotal yet
+      size_t pivotRow = NONE;
+      double maxAbs   = -1.0;
+      for(size_t p = top; p < n; ++p) {
+        size_t i = reach[p];
+        if(rowPermInverse[i] == NONE) {
+          if(std::abs(x[i]) > maxAbs) {
+            maxAbs   = std::abs(x[i]);
+            pivotRow = i;
+          }
+        } else {
+          U.indices.push_back(rowPermInverse[i]);
+          U.values.push_back(x[i]);
+        }
+      }
+      if(pivotRow == NONE || maxAbs <= 0.0) {
+        isRegular = false;
+        std::cerr << "SparseLU: matrix is singular" << std::endl;
+        return false;
+      }
+      if(rowPermInverse[col] == NONE && std::abs(x[col]) >= pivotTolerance * maxAbs) pivotRow = col;
+
+      double pivot             = x[pivotRow];
+      rowPermInverse[pivotRow] = k;
+      U.indices.push_back(k);
+      U.values.push_back(pivot);
+      L.indices.push_back(pivotRow);
+      L.values.push_back(1.0);
+      for(size_t p = top; p < n; ++p) {
+        size_t i = reach[p];
+        if(rowPermInverse[i] == NONE) {
+          L.indices.push_back(i);
+          L.values.push_back(x[i] / pivot);
+        }
+        x[i] = 0.0;
+      }
+    }
+    L.indptr[n] = L.indices.size();
+    U.indptr[n] = U.indices.size();
+    for(auto& i : L.indices) { i = rowPermInverse[i]; }
+    sortColumns(L);
+    sortColumns(U);
+    symbolic.lnz = L.nonZeros();
+    symbolic.unz = U.nonZeros();
+    return true;
+  }
+
+  /**
+   * Solves A x = b using the stored factorization
+   * @param b right hand side(s), n x m
+   * @returns x
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    size_t n = L.rows();
+    assert(b.rows() == n);
+    Matrix<double> out(0, n, b.columns());
+    std::vector<double> x(n);
+    for(size_t c = 0; c < b.columns(); ++c) {
+      for(size_t i = 0; i < n; ++i) { x[rowPermInverse[i]] = b(i, c); }
+      for(size_t j = 0; j < n; ++j) {
+        for(size_t p = L.indptr[j] + 1; p < L.indptr[j + 1]; ++p) { x[L.indices[p]] -= L.values[p] * x[j]; }
+      }
+      for(size_t j = n; j-- > 0;) {
+        x[j] /= U.values[U.indptr[j + 1] - 1];
+        for(size_t p = U.indptr[j]; p + 1 < U.indptr[j + 1]; ++p) { x[U.indices[p]] -= U.values[p] * x[j]; }
+      }
+      for(size_t k = 0; k < n; ++k) { out(symbolic.columnPerm[k], c) = x[k]; }
+    }
+    return out;
+  }
+
+private:
+  //! marker of rows which are not pivotal yet
+  static constexpr size_t NONE = size_t(-1);
+
+  /**
+   * Non zero pattern of L \ B(:, col) by depth first search from the non zeros of B(:, col) in the graph of L
+   * @returns top, the pattern is stored in reach[top], ..., reach[n - 1] in topological order
+   */
+  size_t reachOf(const CSCMatrix<double>& B, size_t col, std::vector<size_t>& reach, std::vector<size_t>& stack,
+                 std::vector<size_t>& position, std::vector<bool>& marked) const {
+    size_t n = B.rows(), top = n;
+    for(size_t p = B.indptr[col]; p < B.indptr[col + 1]; ++p) {
+      if(marked[B.indices[p]]) continue;
+      size_t head = 0;
+      stack[0]    = B.indices[p];
+      while(true) {
+        size_t j = stack[head], J = rowPermInverse[j];
+        if(!marked[j]) {
+          marked[j]      = true;
+          position[head] = J == NONE ? 0 : L.indptr[J] + 1;
+        }
+        size_t end = J == NONE ? 0 : L.indptr[J + 1];
+        bool done  = true;
+        for(size_t q = position[head]; q < end; ++q) {
+          size_t i = L.indices[q];
+          if(marked[i]) continue;
+          position[head] = q + 1;
+          stack[++head]  = i;
+          done           = false;
+          break;
+        }
+        if(done) {
+          reach[--top] = j;
+          if(head == 0) break;
+          --head;
+        }
+      }
+    }
+    for(size_t p = top; p < n; ++p) { marked[reach[p]] = false; }
+    return top;
+  }
+
+  /**
+   * sorts the row indices within every column
+   */
+  static void sortColumns(CSCMatrix<double>& M) {
+    std::vector<std::pair<size_t, double>> column;
+    for(size_t j = 0; j < M.columns(); ++j) {
+      column.clear();
+      for(size_t p = M.indptr[j]; p < M.indptr[j + 1]; ++p) { column.emplace_back(M.indices[p], M.values[p]); }
+      std::sort(column.begin(), column.end());
+      for(size_t p = M.indptr[j], c = 0; p < M.indptr[j + 1]; ++p, ++c) {
+        M.indices[p] = column[c].first;
+        M.values[p]  = column[c].second;
+      }
+    }
+  }
+};
+
+/**
+ * Sparse direct solve of A x = b, sparse counterpart of gaussSeidel()
+ * @param A square sparse matrix
+ * @param b right hand side(s)
+ * @returns x
+ */
+inline Matrix<double> sparseSolve(const CSRMatrix<double>& A, const Matrix<double>& b) { return SparseLU(A).solve(b); }
+
+/**
+ * \example numerics/lin_alg/TestSparseDirect.cpp
+ * This is an example on how to use the sparse direct solvers.
+ */
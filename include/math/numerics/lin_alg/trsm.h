@@ -0,0 +1,139 @@
+/**
+ * @file trsm.h
+ *
+ * Blocked triangular solve with multiple right hand sides (TRSM)
+ * $$B \leftarrow op(T)^{-1} B, \quad op(T) \in \{T, T^T\}$$
+ * for lower/upper triangular T with unit or non-unit diagonal, computed in place on B.
+ *
+ * T is processed in diagonal blocks: after solving the rows of a block, the remaining rows are
+ * updated by a matrix-matrix product with the freshly solved block of B. All inner loops run over
+ * contiguous rows of B, hence many right hand sides are handled at once.
+ *
+ * Usage:
+ * \code
+ * auto X = B;
+ * trsm(L, X, LOWER_TRIANGULAR);                        // L X = B
+ * trsm(L, X, LOWER_TRIANGULAR, true);                  // L^T X = B
+ * trsm(LU, X, LOWER_TRIANGULAR, false, UNIT_DIAGONAL); // unit lower part of an LU factorization
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/lin_alg/trsm.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../../Matrix.h"
+#include "../parallel.h"
+#include <algorithm>
+
+/**
+ * Triangle of the coefficient matrix referenced by trsm()
+ */
+enum TriangularPart {
+  //! lower triangle including the diagonal
+  LOWER_TRIANGULAR = 0,
+  //! upper triangle including the diagonal
+  UPPER_TRIANGULAR = 1
+};
+
+/**
+ * Diagonal treatment of trsm()
+ */
+enum TriangularDiagonal {
+  //! divide by the stored diagonal
+  NON_UNIT_DIAGONAL = 0,
+  //! diagonal is assumed to be 1 and is never accessed
+  UNIT_DIAGONAL = 1
+};
+
+/**
+ * In-place blocked triangular solve on raw row-major buffers, single or double precision.
+ * @param T coefficient matrix, n x n with leading dimension ldt
+ * @param ldt row stride of T
+ * @param n dimension of T
+ * @param B right hand sides, n x nrhs with leading dimension ldb, overwritten by the solution
+ * @param ldb row stride of B
+ * @param nrhs number of right hand sides
+ * @param part referenced triangle of T
+ * @param transposed solve with T^T instead of T
+ * @param diag unit or non-unit diagonal
+ * @param blockSize size of the diagonal blocks
+ */
+template<typename S>
+void trsm(const S* T, size_t ldt, size_t n, S* B, size_t ldb, size_t nrhs, TriangularPart part, bool transposed = false,
+          TriangularDiagonal diag = NON_UNIT_DIAGONAL, size_t blockSize = 64) {
+  if(n == 0 || nrhs == 0) return;
+  if(blockSize == 0) blockSize = 1;
+  // element (i, j) of op(T)
+  auto at = [T, ldt, transposed](size_t i, size_t j) { return transposed ? T[j * ldt + i] : T[i * ldt + j]; };
+  // op(T) is lower triangular for (lower, not transposed) and (upper, transposed)
+  bool forward = (part == LOWER_TRIANGULAR) != transposed;
+
+  // B(row) -= sum_{j in [j0, j1)} op(T)(row, j) * B(j)
+  auto update = [&](size_t r0, size_t r1, size_t j0, size_t j1) {
+    parallelFor(
+        r0,
+        r1,
+        [&](size_t begin, size_t end) {
+          for(size_t i = begin; i < end; ++i) {
+            S* bi = B + i * ldb;
+            for(size_t j = j0; j < j1; ++j) {
+              S tij = at(i, j);
+              if(tij == S(0)) continue;
+              const S* bj = B + j * ldb;
+              for(size_t c = 0; c < nrhs; ++c) { bi[c] -= tij * bj[c]; }
+            }
+          }
+        },
+        std::max<size_t>(16, 65536 / std::max<size_t>(1, nrhs * (j1 - j0))));
+  };
+  auto scale = [&](size_t i) {
+    if(diag == UNIT_DIAGONAL) return;
+    S inv = S(1) / at(i, i);
+    S* bi = B + i * ldb;
+    for(size_t c = 0; c < nrhs; ++c) { bi[c] *= inv; }
+  };
+
+  if(forward) {
+    for(size_t k0 = 0; k0 < n; k0 += blockSize) {
+      size_t k1 = std::min(n, k0 + blockSize);
+      for(size_t i = k0; i < k1; ++i) {
+        update(i, i + 1, k0, i);
+        scale(i);
+      }
+      update(k1, n, k0, k1);
+    }
+  } else {
+    for(size_t k1 = n; k1 > 0;) {
+      size_t k0 = k1 > blockSize ? k1 - blockSize : 0;
+      for(size_t i = k1; i-- > k0;) {
+        update(i, i + 1, i + 1, k1);
+        scale(i);
+      }
+      update(0, k0, k0, k1);
+      k1 = k0;
+    }
+  }
+}
+
+/**
+ * In-place blocked triangular solve $$B \leftarrow op(T)^{-1} B$$
+ * @param T square coefficient matrix, only the referenced triangle is accessed
+ * @param B right hand side(s), overwritten by the solution
+ * @param part referenced triangle of T
+ * @param transposed solve with T^T instead of T
+ * @param diag unit or non-unit diagonal
+ */
+inline void trsm(const Matrix<double>& T, Matrix<double>& B, TriangularPart part, bool transposed = false,
+                 TriangularDiagonal diag = NON_UNIT_DIAGONAL) {
+  assert(T.rows() == T.columns() && T.rows() == B.rows() && T.elements() == 1 && B.elements() == 1);
+  if(B.rows() == 0 || B.columns() == 0) return;
+  trsm(&T(0, 0), T.columns(), T.rows(), &B(0, 0), B.columns(), B.columns(), part, transposed, diag);
+}
+
+/**
+ * \example numerics/lin_alg/TestTrsm.cpp
+ * This is an example on how to use trsm.
+ */
@@ -3,5 +3,11 @@
 #include "ode/ExplicitEuler.h"
 #include "ode/ode.h"
 #include "ode/ode45.h"
+#include "ode/odeAdams.h"
+#include "ode/odeBDF.h"
 #include "ode/odeBDF2.h"
+#include "ode/odeExponential.h"
+#include "ode/odeRosenbrock.h"
+#include "ode/ensemble.h"
+#include "ode/observers.h"
 #include "ode/odeTrapez.h"
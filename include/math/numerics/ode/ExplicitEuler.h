@@ -12,18 +12,52 @@
 
 #include "../utils.h"
 #include "ode.h"
+#include <algorithm>
 #include <functional>
 #include <vector>
 
 /**
- * implementation of explicit euler method
+ * implementation of explicit euler method on an in place ode, streaming every step to an observer.
+ * Memory usage is O(dim) regardless of the number of steps.
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h stepwith,  $$h = t_{i+1} - t_i$$
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODEExpEuler(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h,
+                      const ODEObserver& observer) {
+  size_t dim       = tInterval.size();
+  size_t elem_size = y0.columns();
+  if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000; }
+  size_t n = ((tInterval[dim - 1] - tInterval[0]) / h) + 1;
+
+  double t = tInterval[0];
+  std::vector<double> y(elem_size), fun_value(elem_size);
+  for(unsigned long i = 0; i < y0.columns(); ++i) y[i] = y0(0, i);
+  observer(t, y.data());
+
+  for(size_t i = 1; i < n; i++) {
+    fun(t, y.data(), fun_value.data());
+    for(size_t j = 0; j < elem_size; ++j) { y[j] += fun_value[j] * h; }
+    t += h;
+    observer(t, y.data());
+  }
+  return odeFinalState(t, y.data(), elem_size);
+}
+
+/**
+ * implementation of explicit euler method on an in place ode, the only allocations are the result
+ * and one workspace vector
  * @param fun ode to approximate
  * @param tInterval interval to perform approximation on
  * @param y0 start value
  * @param h stepwith,  $$h = t_{i+1} - t_i$$
  * @returns
  */
-ODEResult ODEExpEuler(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
+ODEResult
+ODEExpEuler(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
   size_t dim       = tInterval.size();
   size_t elem_size = y0.columns();
   if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000; }
@@ -34,19 +68,38 @@ ODEResult ODEExpEuler(const ODE& fun, const std::vector<double>& tInterval, cons
   size_t n = result_dim;
   auto y   = zeros(n, elem_size);
 
-  t(0, 0) = tInterval[0];
-  for(unsigned long i = 0; i < y0.columns(); ++i) y(0, i) = y0(0, i);
+  size_t row = 0;
+  ODEExpEuler(fun, tInterval, y0, h, [&](double ti, const double* yi) {
+    t(row, 0) = ti;
+    std::copy(yi, yi + elem_size, &y(row++, 0));
+  });
+  return { y, t };
+}
 
-  for(size_t i = 1; i < n; i++) {
-    auto cur_t               = t(i - 1, 0);
-    Matrix<double> cur_y     = y(i - 1);
-    Matrix<double> fun_value = fun(cur_t, cur_y);
+/**
+ * implementation of explicit euler method
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h stepwith,  $$h = t_{i+1} - t_i$$
+ * @returns
+ */
+ODEResult ODEExpEuler(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
+  return ODEExpEuler(odeInPlace(fun, y0.columns()), tInterval, y0, h);
+}
 
-    auto yi = cur_y + fun_value * h;
-    y.SetRow(i, yi.GetSlice(0, 0, 0, elem_size - 1));
-    t(i, 0) = cur_t + h;
-  }
-  return { y, t };
+/**
+ * implementation of explicit euler method, streaming every step to an observer
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h stepwith,  $$h = t_{i+1} - t_i$$
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODEExpEuler(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h,
+                      const ODEObserver& observer) {
+  return ODEExpEuler(odeInPlace(fun, y0.columns()), tInterval, y0, h, observer);
 }
 
 /**
@@ -13,7 +13,11 @@
 #include "ExplicitEuler.h"
 #include "ode.h"
 #include "ode45.h"
+#include "odeAdams.h"
+#include "odeBDF.h"
 #include "odeBDF2.h"
+#include "odeExponential.h"
+#include "odeRosenbrock.h"
 #include "odeTrapez.h"
 
 /**
@@ -36,17 +40,42 @@ public:
     return ODEExpEuler(fun, tInterval, y0, option.h);
   }
   /**
-   * proxy to ODE45
+   * proxy to the adaptive ODE45, option.h is the initial step width
    * @param fun ode to approximate
    * @param tInterval interval to perform approximation on
    * @param y0 start value
    * @param option solver options
-   * @returns ::ODE45(fun, tInterval, y0, option.h)
+   * @returns ::ODE45(fun, tInterval, y0, option)
    */
   static ODEResult
   ode45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+    return ODE45(fun, tInterval, y0, option);
+  }
+  /**
+   * proxy to ODE45 with the fixed step width option.h, tolerances and events are not supported
+   * @param fun ode to approximate
+   * @param tInterval interval to perform approximation on
+   * @param y0 start value
+   * @param option solver options
+   * @returns ::ODE45(fun, tInterval, y0, option.h)
+   */
+  static ODEResult
+  ode45Fixed(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+    if(!option.events.empty()) { std::cerr << "ODE45: events are ignored with a fixed step width" << std::endl; }
     return ODE45(fun, tInterval, y0, option.h);
   }
+  /**
+   * proxy to ODEAdams
+   * @param fun ode to approximate
+   * @param tInterval interval to perform approximation on
+   * @param y0 start value
+   * @param option solver options
+   * @returns ::ODEAdams(fun, tInterval, y0, option)
+   */
+  static ODEResult
+  odeAdams(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+    return ODEAdams(fun, tInterval, y0, option);
+  }
   /**
    * proxy to ODETrapez
    * @param fun ode to approximate
@@ -71,4 +100,41 @@ public:
   odeBDF2(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
     return ODEBDF2(fun, tInterval, y0, option);
   }
-};
\ No newline at end of file
+  /**
+   * proxy to ODEBDF
+   * @param fun ode to approximate
+   * @param tInterval interval to perform approximation on
+   * @param y0 start value
+   * @param option solver options
+   * @returns ODEBDF(fun, tInterval, y0, option)
+   */
+  static ODEResult
+  odeBDF(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+    return ODEBDF(fun, tInterval, y0, option);
+  }
+  /**
+   * proxy to ODERosenbrock
+   * @param fun ode to approximate
+   * @param tInterval interval to perform approximation on
+   * @param y0 start value
+   * @param option solver options
+   * @returns ODERosenbrock(fun, tInterval, y0, option)
+   */
+  static ODEResult odeRosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                                 const ODEOption& option) {
+    return ODERosenbrock(fun, tInterval, y0, option);
+  }
+  /**
+   * proxy to ODEExpRosenbrock
+   * @param fun ode to approximate
+   * @param tInterval interval to perform approximation on
+   * @param y0 start value
+   * @param option solver options
+   * @returns ODEExpRosenbrock(fun, tInterval, y0, option)
+   */
+  static ODEResult
+  odeExpRosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                   const ODEOption& option) {
+    return ODEExpRosenbrock(fun, tInterval, y0, option);
+  }
+};
@@ -0,0 +1,444 @@
+/**
+ * @file ensemble.h
+ *
+ * Ensemble integration of one ode for many initial values and parameter vectors, e.g. parameter
+ * sweeps or uncertainty propagation.
+ *
+ * - Trajectories are integrated in batches by the adaptive Dormand-Prince method (see ode45.h), every
+ *   trajectory has its own time and step width. Within a batch the states are stored interleaved
+ *   (component i of trajectory s at i * lanes + s), so a batched right hand side loops over
+ *   contiguous lanes and vectorizes. Batches are distributed over threads by parallelFor().
+ * - Only the cross sections at the output times are aggregated while integrating: mean and variance
+ *   (merged across batches by Chan's formula) and, if requested, quantiles. The trajectories
+ *   themselves are never stored, the final states are returned per trajectory.
+ * - Quantiles are estimated by a mergeable summary per output time and component
+ *   (ensemble::QuantileSketch), merged under the same lock as mean and variance. It needs
+ *   O(quantileCapacity * log(N / quantileCapacity)) values instead of the N values of a cross
+ *   section, and it is exact for up to quantileCapacity trajectories. Beyond that the estimate may
+ *   depend on the order in which the batches finish.
+ *
+ * Usage:
+ * \code
+ * // y' = -p y, batched over lanes
+ * auto fun = [](const double* t, const double* y, const double* p, double* dydt, size_t lanes) {
+ *   for(size_t s = 0; s < lanes; ++s) { dydt[s] = -p[s] * y[s]; }
+ * };
+ * EnsembleOption option;
+ * option.quantiles = { 0.05, 0.5, 0.95 };
+ * auto res = ODEEnsemble(fun, linspace(0, 1, 11), Y0, P, option);  // Y0: N x dim, P: N x parameters
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/ensemble.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../parallel.h"
+#include "ode45.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+/**
+ * Batched right hand side f(t, y, p, dydt, lanes), all arrays are interleaved by lanes:
+ * t[s], y[i * lanes + s], p[j * lanes + s], dydt[i * lanes + s]
+ */
+using ODEEnsembleFun = std::function<void(const double*, const double*, const double*, double*, size_t)>;
+
+//! right hand side of a single trajectory f(t, y, p, dydt)
+using ODEParameterFun = std::function<void(double, const double*, const double*, double*)>;
+
+/**
+ * Options of ODEEnsemble
+ */
+struct EnsembleOption {
+  //! relative tolerance per trajectory
+  double rtol = 1e-6;
+  //! absolute tolerance per trajectory
+  double atol = 1e-9;
+  //! number of trajectories integrated together
+  size_t batch = 64;
+  //! quantiles of the cross sections to compute, e.g. { 0.05, 0.5, 0.95 }
+  std::vector<double> quantiles = {};
+  //! values per level of the quantile summaries, the quantiles are exact up to this number of trajectories
+  size_t quantileCapacity = 256;
+  //! maximum number of steps per trajectory
+  size_t maxSteps = 100000;
+};
+
+/**
+ * Result of ODEEnsemble
+ */
+struct EnsembleResult {
+  //! output times
+  Matrix<double> T;
+  //! mean of all trajectories per output time (rows) and component (columns)
+  Matrix<double> mean;
+  //! sample variance per output time and component
+  Matrix<double> variance;
+  //! one matrix per requested quantile, layout as mean, see EnsembleOption::quantileCapacity
+  std::vector<Matrix<double>> quantiles;
+  //! final state of every trajectory
+  Matrix<double> Y;
+  //! number of accepted steps of all trajectories
+  size_t steps = 0;
+  //! number of rejected steps of all trajectories
+  size_t rejected = 0;
+  //! number of trajectories that did not reach the end (step width underflow or maxSteps)
+  size_t failed = 0;
+};
+
+namespace ensemble {
+  /**
+   * Mergeable quantile summary of a stream of values (compactor hierarchy of Munro and Paterson).
+   *
+   * Level l holds values of weight 2^l. A level exceeding the capacity is sorted and every second
+   * value is promoted to the next level, alternating between the even and odd positions. The total
+   * weight, the minimum and the maximum are kept exactly. For n values the summary stores
+   * O(capacity * log(n / capacity)) values and the rank error is of the order
+   * n * log2(n / capacity) / capacity, it is exact as long as at most capacity values were added.
+   */
+  class QuantileSketch
+  {
+  public:
+    /**
+     * @param capacity values per level
+     */
+    explicit QuantileSketch(size_t capacity = 256)
+      : _capacity(std::max<size_t>(2, capacity)) { }
+
+    /**
+     * Adds one value
+     * @param x value
+     */
+    void add(double x) {
+      if(_levels.empty()) _levels.emplace_back();
+      _levels[0].push_back(x);
+      _min = std::min(_min, x);
+      _max = std::max(_max, x);
+      _count++;
+      compact();
+    }
+
+    /**
+     * Adds all values of another summary, the result summarizes both streams
+     * @param other summary with the same capacity
+     */
+    void merge(const QuantileSketch& other) {
+      if(_levels.size() < other._levels.size()) _levels.resize(other._levels.size());
+      for(size_t l = 0; l < other._levels.size(); ++l) {
+        _levels[l].insert(_levels[l].end(), other._levels[l].begin(), other._levels[l].end());
+      }
+      _min = std::min(_min, other._min);
+      _max = std::max(_max, other._max);
+      _count += other._count;
+      compact();
+    }
+
+    //! number of summarized values
+    [[nodiscard]] size_t count() const { return _count; }
+
+    /**
+     * Quantiles with linear interpolation between the order statistics
+     * @param qs quantiles in [0, 1]
+     * @returns one value per quantile, NaN if the summary is empty
+     */
+    [[nodiscard]] std::vector<double> quantiles(const std::vector<double>& qs) const {
+      std::vector<double> result(qs.size(), std::nan(""));
+      if(_count == 0) return result;
+      // (value, weight) sorted by value
+      std::vector<std::pair<double, double>> items;
+      for(size_t l = 0; l < _levels.size(); ++l) {
+        for(double v : _levels[l]) { items.emplace_back(v, std::ldexp(1.0, int(l))); }
+      }
+      std::sort(items.begin(), items.end());
+      double last = double(_count - 1);
+      // value of the order statistic with (0-based) rank r
+      auto rank = [&](double r) {
+        if(r <= 0) return _min;
+        if(r >= last) return _max;
+        double cumulative = 0;
+        for(const auto& [v, w] : items) {
+          cumulative += w;
+          if(r < cumulative) return v;
+        }
+        return _max;
+      };
+      for(size_t q = 0; q < qs.size(); ++q) {
+        double pos = qs[q] * last, lo = std::floor(pos);
+        double vLo = rank(lo);
+        result[q]  = vLo + (pos - lo) * (rank(lo + 1) - vLo);
+      }
+      return result;
+    }
+
+  private:
+    //! values per level
+    size_t _capacity;
+    //! values of weight 2^l per level l
+    std::vector<std::vector<double>> _levels;
+    //! number of summarized values
+    size_t _count = 0;
+    //! exact extremes
+    double _min = std::numeric_limits<double>::infinity(), _max = -std::numeric_limits<double>::infinity();
+    //! alternates the promoted positions between compactions
+    size_t _offset = 0;
+
+    //! promotes every second value of the levels exceeding the capacity
+    void compact() {
+      for(size_t l = 0; l < _levels.size(); ++l) {
+        if(_levels[l].size() <= _capacity) continue;
+        if(l + 1 == _levels.size()) _levels.emplace_back();
+        auto& level = _levels[l];
+        std::sort(level.begin(), level.end());
+        size_t pairs = level.size() / 2;
+        for(size_t i = 0; i < pairs; ++i) { _levels[l + 1].push_back(level[2 * i + _offset]); }
+        _offset = 1 - _offset;
+        // an odd value out keeps its weight on this level
+        if(level.size() % 2) {
+          level[0] = level.back();
+          level.resize(1);
+        } else {
+          level.clear();
+        }
+      }
+    }
+  };
+} // namespace ensemble
+
+/**
+ * Adapter of a single trajectory right hand side to the batched interface (no vectorization)
+ * @param f right hand side of one trajectory
+ * @param dim dimension of the system
+ * @param parameters number of parameters per trajectory
+ * @returns batched right hand side
+ */
+inline ODEEnsembleFun ensembleFunction(const ODEParameterFun& f, size_t dim, size_t parameters) {
+  return [f, dim, parameters](const double* t, const double* y, const double* p, double* dydt, size_t lanes) {
+    std::vector<double> ys(dim), ps(parameters), fs(dim);
+    for(size_t s = 0; s < lanes; ++s) {
+      for(size_t i = 0; i < dim; ++i) { ys[i] = y[i * lanes + s]; }
+      for(size_t j = 0; j < parameters; ++j) { ps[j] = p[j * lanes + s]; }
+      f(t[s], ys.data(), ps.data(), fs.data());
+      for(size_t i = 0; i < dim; ++i) { dydt[i * lanes + s] = fs[i]; }
+    }
+  };
+}
+
+/**
+ * Integrates all trajectories Y0(s) with parameters P(s) from tOut[0] to the last output time
+ * @param fun batched right hand side
+ * @param tOut increasing output times, the first one is the start time
+ * @param Y0 start values, one row per trajectory
+ * @param P parameters, one row per trajectory (may have zero columns)
+ * @param option tolerances, batch size and quantiles
+ * @returns statistics at the output times and final states
+ */
+inline EnsembleResult ODEEnsemble(const ODEEnsembleFun& fun, const std::vector<double>& tOut, const Matrix<double>& Y0,
+                                  const Matrix<double>& P, const EnsembleOption& option = EnsembleOption()) {
+  using namespace dormand_prince;
+  size_t N = Y0.rows(), dim = Y0.columns(), np = P.columns(), nt = tOut.size();
+  assert(nt >= 1 && (np == 0 || P.rows() == N));
+  EnsembleResult res;
+  res.T        = Matrix<double>(0, nt, 1);
+  res.mean     = Matrix<double>(0, nt, dim);
+  res.variance = Matrix<double>(0, nt, dim);
+  res.Y        = Matrix<double>(0, N, dim);
+  for(size_t j = 0; j < nt; ++j) { res.T(j, 0) = tOut[j]; }
+  if(N == 0) return res;
+
+  // quantile summaries of the cross sections, [output time][component]
+  std::vector<ensemble::QuantileSketch> sketches(option.quantiles.empty() ? 0 : nt * dim,
+                                                 ensemble::QuantileSketch(option.quantileCapacity));
+  std::vector<double> count(nt, 0.0);
+  std::mutex merge;
+
+  size_t B      = std::max<size_t>(1, option.batch);
+  size_t blocks = (N + B - 1) / B;
+  parallelFor(
+      0,
+      blocks,
+      [&](size_t blockBegin, size_t blockEnd) {
+        for(size_t block = blockBegin; block < blockEnd; ++block) {
+          size_t first = block * B, L = std::min(B, N - first);
+          std::vector<double> y(dim * L), stage(dim * L), out(dim), p(std::max<size_t>(1, np * L));
+          std::vector<std::vector<double>> k(7, std::vector<double>(dim * L));
+          std::vector<double> t(L, tOut.front()), tt(L), h(L), hs(L), errOld(L, 1e-4), err(L);
+          std::vector<size_t> next(L, 1), steps(L, 0);
+          std::vector<char> active(L, 1);
+          size_t rejected = 0, failed = 0, accepted = 0;
+          // local statistics, merged at the end
+          std::vector<double> mean(nt * dim, 0.0), M2(nt * dim, 0.0), n(nt, 0.0);
+          std::vector<ensemble::QuantileSketch> local(sketches.size(),
+                                                      ensemble::QuantileSketch(option.quantileCapacity));
+          auto record = [&](size_t j, const double* v, size_t stride) {
+            for(size_t i = 0; i < dim; ++i) {
+              double x     = v[i * stride];
+              double delta = x - mean[j * dim + i];
+              mean[j * dim + i] += delta / (n[j] + 1);
+              M2[j * dim + i] += delta * (x - mean[j * dim + i]);
+              if(!local.empty()) local[j * dim + i].add(x);
+            }
+            n[j] += 1;
+          };
+
+          for(size_t s = 0; s < L; ++s) {
+            for(size_t i = 0; i < dim; ++i) { y[i * L + s] = Y0(first + s, i); }
+            for(size_t q = 0; q < np; ++q) { p[q * L + s] = P(first + s, q); }
+            record(0, &y[s], L);
+          }
+          double tEnd = tOut.back();
+          fun(t.data(), y.data(), p.data(), k[0].data(), L);
+
+          // initial step widths (Hairer, Norsett, Wanner)
+          for(size_t s = 0; s < L; ++s) {
+            double d0 = 0, d1 = 0;
+            for(size_t i = 0; i < dim; ++i) {
+              double sk = option.atol + option.rtol * std::abs(y[i * L + s]);
+              d0 += (y[i * L + s] / sk) * (y[i * L + s] / sk);
+              d1 += (k[0][i * L + s] / sk) * (k[0][i * L + s] / sk);
+            }
+            d0   = std::sqrt(d0 / double(dim));
+            d1   = std::sqrt(d1 / double(dim));
+            h[s] = std::min((d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1, tEnd - t[s]);
+            for(size_t i = 0; i < dim; ++i) { stage[i * L + s] = y[i * L + s] + h[s] * k[0][i * L + s]; }
+            tt[s] = t[s] + h[s];
+            if(!(tEnd > t[s])) active[s] = 0;
+          }
+          fun(tt.data(), stage.data(), p.data(), k[1].data(), L);
+          for(size_t s = 0; s < L; ++s) {
+            double d1 = 0, d2 = 0;
+            for(size_t i = 0; i < dim; ++i) {
+              double sk = option.atol + option.rtol * std::abs(y[i * L + s]);
+              double e  = (k[1][i * L + s] - k[0][i * L + s]) / h[s];
+              d1 += (k[0][i * L + s] / sk) * (k[0][i * L + s] / sk);
+              d2 += (e / sk) * (e / sk);
+            }
+            double m  = std::max(std::sqrt(d1 / double(dim)), std::sqrt(d2 / double(dim)));
+            double h1 = m <= 1e-15 ? std::max(1e-6, h[s] * 1e-3) : std::pow(0.01 / m, 0.2);
+            h[s]      = std::min(100 * h[s], h1);
+          }
+
+          const double beta = 0.04, expo = 0.2 - 0.75 * beta, safety = 0.9;
+          size_t remaining = std::count(active.begin(), active.end(), 1);
+          while(remaining > 0) {
+            for(size_t s = 0; s < L; ++s) { hs[s] = active[s] ? std::min(h[s], tEnd - t[s]) : 0.0; }
+            for(size_t st = 1; st < 7; ++st) {
+              for(size_t i = 0; i < dim; ++i) {
+                for(size_t s = 0; s < L; ++s) {
+                  double sum = 0;
+                  for(size_t j = 0; j < st; ++j) { sum += a[st][j] * k[j][i * L + s]; }
+                  stage[i * L + s] = y[i * L + s] + hs[s] * sum;
+                }
+              }
+              for(size_t s = 0; s < L; ++s) { tt[s] = t[s] + c[st] * hs[s]; }
+              fun(tt.data(), stage.data(), p.data(), k[st].data(), L);
+            }
+            // error norms per lane
+            std::fill(err.begin(), err.end(), 0.0);
+            for(size_t i = 0; i < dim; ++i) {
+              for(size_t s = 0; s < L; ++s) {
+                double sum = 0;
+                for(size_t j = 0; j < 7; ++j) { sum += e[j] * k[j][i * L + s]; }
+                double sk = option.atol
+                            + option.rtol * std::max(std::abs(y[i * L + s]), std::abs(stage[i * L + s]));
+                double ei = hs[s] * sum / sk;
+                err[s] += ei * ei;
+              }
+            }
+
+            for(size_t s = 0; s < L; ++s) {
+              if(!active[s]) continue;
+              double error = std::sqrt(err[s] / double(dim));
+              double fac11 = std::pow(std::max(error, 1e-300), expo);
+              if(error > 1.0 || std::isnan(error)) {
+                h[s] /= std::isnan(error) ? 10.0 : std::min(5.0, fac11 / safety);
+                rejected++;
+                if(h[s] < 16 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(t[s]))) {
+                  active[s] = 0;
+                  remaining--;
+                  failed++;
+                }
+                continue;
+              }
+              bool last   = hs[s] >= tEnd - t[s];
+              double tNew = last ? tEnd : t[s] + hs[s];
+              // dense output at the passed output times
+              while(next[s] < nt && tOut[next[s]] <= tNew) {
+                double theta = (tOut[next[s]] - t[s]) / hs[s], theta1 = 1 - theta;
+                for(size_t i = 0; i < dim; ++i) {
+                  size_t x  = i * L + s;
+                  double r2 = stage[x] - y[x];
+                  double r3 = hs[s] * k[0][x] - r2;
+                  double r4 = r2 - hs[s] * k[6][x] - r3;
+                  double r5 = 0;
+                  for(size_t j = 0; j < 7; ++j) { r5 += d[j] * k[j][x]; }
+                  r5 *= hs[s];
+                  out[i]    = tOut[next[s]] == tNew ? stage[x]
+                                                        : y[x] + theta * (r2 + theta1 * (r3 + theta * (r4 + theta1 * r5)));
+                }
+                record(next[s]++, out.data(), 1);
+              }
+              t[s] = tNew;
+              for(size_t i = 0; i < dim; ++i) {
+                y[i * L + s]    = stage[i * L + s];
+                k[0][i * L + s] = k[6][i * L + s];
+              }
+              accepted++;
+              double fac = std::max(0.1, std::min(5.0, fac11 / std::pow(errOld[s], beta) / safety));
+              errOld[s]  = std::max(error, 1e-4);
+              h[s] /= fac;
+              if(last || ++steps[s] >= option.maxSteps) {
+                if(!last) failed++;
+                active[s] = 0;
+                remaining--;
+              }
+            }
+          }
+
+          for(size_t s = 0; s < L; ++s) {
+            for(size_t i = 0; i < dim; ++i) { res.Y(first + s, i) = y[i * L + s]; }
+          }
+          // merge the block statistics (Chan et al.)
+          std::lock_guard<std::mutex> lock(merge);
+          res.steps += accepted;
+          res.rejected += rejected;
+          res.failed += failed;
+          for(size_t j = 0; j < nt; ++j) {
+            if(n[j] == 0) continue;
+            double total = count[j] + n[j];
+            for(size_t i = 0; i < dim; ++i) {
+              double delta = mean[j * dim + i] - res.mean(j, i);
+              res.mean(j, i) += delta * n[j] / total;
+              res.variance(j, i) += M2[j * dim + i] + delta * delta * count[j] * n[j] / total;
+            }
+            count[j] = total;
+          }
+          for(size_t l = 0; l < local.size(); ++l) { sketches[l].merge(local[l]); }
+        }
+      },
+      1);
+
+  // sums of squares to sample variances
+  for(size_t j = 0; j < nt; ++j) {
+    for(size_t i = 0; i < dim; ++i) { res.variance(j, i) = count[j] > 1 ? res.variance(j, i) / (count[j] - 1) : 0.0; }
+  }
+  // failed trajectories only contributed to the output times they reached
+  res.quantiles.assign(option.quantiles.size(), Matrix<double>(0, nt, dim));
+  for(size_t l = 0; l < sketches.size(); ++l) {
+    if(sketches[l].count() == 0) continue;
+    auto values = sketches[l].quantiles(option.quantiles);
+    for(size_t q = 0; q < values.size(); ++q) { res.quantiles[q](l / dim, l % dim) = values[q]; }
+  }
+  return res;
+}
+
+/**
+ * \example numerics/ode/TestODEEnsemble.cpp
+ * This is an example on how to integrate ensembles of odes.
+ */
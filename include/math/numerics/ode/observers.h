@@ -0,0 +1,186 @@
+/**
+ * @file observers.h
+ *
+ * Observers for the streaming overloads of the ode solvers (ODEObserver), the trajectory is passed
+ * on step by step instead of being stored, hence the memory usage of a solver is O(dim).
+ *
+ * - everyKSteps(): decimation, forwards every k-th step (and always the first one).
+ * - atTimes(): forwards the state at given output times, interpolated linearly between the two
+ *   surrounding steps. ODE45 with an option and output times interpolates with its own 4th order
+ *   continuous extension instead.
+ * - ODEBinarySink: streams t and y as raw doubles into a buffered binary file, readODEBinary()
+ *   loads such a file.
+ *
+ * Usage:
+ * \code
+ * ODEBinarySink sink("trajectory.bin", 3);
+ * ODEExpEuler(fun, { 0, 1e3 }, y0, 1e-4, everyKSteps(100, std::ref(sink)));
+ * sink.close();
+ * auto data = readODEBinary("trajectory.bin", 3); // rows (t, y_1, y_2, y_3)
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/observers.h>
+ * \endcode
+ */
+#pragma once
+
+#include "ode.h"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Decimating observer
+ * @param k forward every k-th step
+ * @param observer receiver of the forwarded steps
+ * @returns observer forwarding steps 0, k, 2k, ...
+ */
+inline ODEObserver everyKSteps(size_t k, ODEObserver observer) {
+  assert(k > 0);
+  return [k, observer = std::move(observer), step = size_t(0)](double t, const double* y) mutable {
+    if(step++ % k == 0) observer(t, y);
+  };
+}
+
+/**
+ * Observer reporting the state at given times, linear interpolation between the surrounding steps
+ * @param times increasing output times
+ * @param dim dimension of the system
+ * @param observer receiver of the interpolated states
+ * @returns observer of the solver
+ */
+inline ODEObserver atTimes(std::vector<double> times, size_t dim, ODEObserver observer) {
+  struct State {
+    std::vector<double> times, previous, out;
+    double tPrevious = 0;
+    size_t next      = 0;
+    bool first       = true;
+  };
+  auto state      = std::make_shared<State>();
+  state->times    = std::move(times);
+  state->previous = std::vector<double>(dim);
+  state->out      = std::vector<double>(dim);
+  return [state, dim, observer = std::move(observer)](double t, const double* y) {
+    auto& s = *state;
+    while(s.next < s.times.size() && s.times[s.next] <= t) {
+      double tOut = s.times[s.next++];
+      if(tOut == t) {
+        observer(tOut, y);
+        continue;
+      }
+      // output times before the start value are skipped
+      if(s.first) continue;
+      double theta = (tOut - s.tPrevious) / (t - s.tPrevious);
+      for(size_t i = 0; i < dim; ++i) { s.out[i] = s.previous[i] + theta * (y[i] - s.previous[i]); }
+      observer(tOut, s.out.data());
+    }
+    std::copy(y, y + dim, s.previous.begin());
+    s.tPrevious = t;
+    s.first     = false;
+  };
+}
+
+/**
+ * Observer writing every step as dim + 1 raw doubles (t, y_1, ..., y_dim) into a binary file
+ */
+class ODEBinarySink
+{
+public:
+  /**
+   * Opens (truncates) the file
+   * @param path file path
+   * @param dim dimension of the system
+   * @param bufferSteps number of steps buffered before writing
+   */
+  ODEBinarySink(const std::string& path, size_t dim, size_t bufferSteps = 4096)
+    : _file(path, std::ios::binary | std::ios::trunc)
+    , _dim(dim)
+    , _capacity(bufferSteps * (dim + 1)) {
+    if(!_file) { std::cerr << "ODEBinarySink: unable to open " << path << std::endl; }
+    _buffer.reserve(_capacity);
+  }
+
+  ODEBinarySink(const ODEBinarySink&)            = delete;
+  ODEBinarySink& operator=(const ODEBinarySink&) = delete;
+
+  ~ODEBinarySink() { close(); }
+
+  /**
+   * Appends one step
+   * @param t time
+   * @param y state
+   */
+  void operator()(double t, const double* y) {
+    _buffer.push_back(t);
+    _buffer.insert(_buffer.end(), y, y + _dim);
+    _steps++;
+    if(_buffer.size() >= _capacity) flush();
+  }
+
+  /**
+   * Writes the buffered steps
+   */
+  void flush() {
+    if(_file && !_buffer.empty()) {
+      _file.write(reinterpret_cast<const char*>(_buffer.data()), std::streamsize(_buffer.size() * sizeof(double)));
+    }
+    _buffer.clear();
+    if(_file) _file.flush();
+  }
+
+  /**
+   * Flushes and closes the file
+   */
+  void close() {
+    if(_file.is_open()) {
+      flush();
+      _file.close();
+    }
+  }
+
+  /**
+   * @returns number of written steps
+   */
+  [[nodiscard]] size_t steps() const { return _steps; }
+
+private:
+  //! output file
+  std::ofstream _file;
+  //! dimension of the system
+  size_t _dim;
+  //! buffer size in doubles
+  size_t _capacity;
+  //! buffered steps
+  std::vector<double> _buffer;
+  //! number of steps
+  size_t _steps = 0;
+};
+
+/**
+ * Reads a trajectory written by ODEBinarySink
+ * @param path file path
+ * @param dim dimension of the system
+ * @returns matrix with rows (t, y_1, ..., y_dim)
+ */
+inline Matrix<double> readODEBinary(const std::string& path, size_t dim) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if(!file) {
+    std::cerr << "readODEBinary: unable to open " << path << std::endl;
+    return Matrix<double>();
+  }
+  size_t rows = size_t(file.tellg()) / (sizeof(double) * (dim + 1));
+  Matrix<double> out(0, rows, dim + 1);
+  file.seekg(0);
+  if(rows > 0) file.read(reinterpret_cast<char*>(&out(0, 0)), std::streamsize(rows * (dim + 1) * sizeof(double)));
+  return out;
+}
+
+/**
+ * \example numerics/ode/TestODEObserver.cpp
+ * This is an example on how to stream ode solutions to observers.
+ */
@@ -10,7 +10,13 @@
  */
 
 #pragma once
+#include "../lin_alg/finiteDifferences.h"
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 //! alias for ODE
@@ -19,6 +25,42 @@ using ODE = std::function<Matrix<double>(double, Matrix<double>)>;
 //! alias for Jacobian-Matrix of ODE
 using ODEJac = std::function<Matrix<double>(double, Matrix<double>)>;
 
+//! alias for a sparse Jacobian-Matrix of ODE, the sparsity pattern has to be the same for every call
+using ODESparseJac = std::function<CSRMatrix<double>(double, Matrix<double>)>;
+
+//! alias for an ODE evaluated in place, f(t, y, dydt) writes the derivative of y into dydt
+using ODEInPlace = std::function<void(double, const double*, double*)>;
+
+//! observer of a solver, called with t and the state y (dim values) of every step, see observers.h
+using ODEObserver = std::function<void(double, const double*)>;
+
+//! event function g(t, y) with the state y, events are located at the zeros of g
+using ODEEventFunction = std::function<double(double, const double*)>;
+
+/**
+ * Sign changes of an event function which trigger the event
+ */
+enum EventDirection {
+  //! g changes from positive to negative
+  EVENT_DECREASING = -1,
+  //! every sign change
+  EVENT_ANY = 0,
+  //! g changes from negative to positive
+  EVENT_INCREASING = 1
+};
+
+/**
+ * Event of the adaptive solvers, see ODEOption::events
+ */
+struct ODEEvent {
+  //! event function
+  ODEEventFunction g;
+  //! sign changes which trigger the event
+  EventDirection direction = EVENT_ANY;
+  //! stops the integration at the first occurrence
+  bool terminal = false;
+};
+
 /**
  * Representation of ODE result
  */
@@ -29,6 +71,12 @@ struct ODEResult {
   Matrix<double> T;
   //! number iterations per time step
   Matrix<int> Iterations;
+  //! times of the events (column vector), see ODEOption::events
+  Matrix<double> TE;
+  //! states at the events, one row per event
+  Matrix<double> YE;
+  //! indices of the events in ODEOption::events (column vector)
+  Matrix<int> IE;
 
   /**
    * Constructor without iterations
@@ -60,6 +108,287 @@ struct ODEOption {
   double TOL = 1e-7;
   //! max iterations for integrated newton steps
   int maxIter = 50;
-  //! jacobian matrix of given function
+  //! jacobian matrix of given function, nullptr for finite differences (see autodiffODEJacobian())
   ODEJac Jac = nullptr;
-};
\ No newline at end of file
+  //! relative tolerance of adaptive solvers
+  double rtol = 1e-6;
+  //! absolute tolerance of adaptive solvers
+  double atol = 1e-9;
+  //! sparse jacobian for banded and sparse iteration matrices, nullptr for finite differences
+  ODESparseJac SparseJac = nullptr;
+  //! events located by the adaptive solvers ODE45, ODEAdams, ODEBDF and ODERosenbrock
+  std::vector<ODEEvent> events = {};
+  //! evaluate the columns of finite difference jacobians concurrently, the ode has to be thread safe
+  bool parallelJacobian = false;
+};
+
+/**
+ * Detection of the events of ODEOption::events during an integration. Every accepted step is
+ * checked for sign changes of the event functions, their zeros are located on the dense output of
+ * the solver by the Illinois variant of regula falsi. Terminal events end the integration at the
+ * located time.
+ */
+class ODEEvents
+{
+public:
+  //! time of the terminal event if step() returned true
+  double stopTime = 0;
+  //! state at the terminal event
+  std::vector<double> stopState;
+
+  /**
+   * @param events events to detect
+   */
+  explicit ODEEvents(const std::vector<ODEEvent>& events)
+    : _events(events) { }
+
+  /**
+   * @returns true if there are no events to detect
+   */
+  [[nodiscard]] bool empty() const { return _events.empty(); }
+
+  /**
+   * Evaluates the event functions at the start value
+   * @param t start time
+   * @param y start value
+   * @param dim dimension of the system
+   */
+  void start(double t, const double* y, size_t dim) {
+    _dim = dim;
+    _y.resize(dim);
+    _g.resize(_events.size());
+    for(size_t i = 0; i < _events.size(); ++i) { _g[i] = _events[i].g(t, y); }
+  }
+
+  /**
+   * Checks an accepted step for events and records them
+   * @param t0 start of the step
+   * @param t1 end of the step
+   * @param y1 state at t1
+   * @param interpolate interpolate(t, y) writes the dense output at t between t0 and t1 into y
+   * @returns true if a terminal event occurred, the integration ends at stopTime
+   */
+  template<typename Interpolation>
+  bool step(double t0, double t1, const double* y1, Interpolation&& interpolate) {
+    if(_events.empty()) return false;
+    _found.clear();
+    for(size_t i = 0; i < _events.size(); ++i) {
+      double g0 = _g[i], g1 = _events[i].g(t1, y1);
+      _g[i]     = g1;
+      bool up   = g0 < 0 && g1 >= 0;
+      bool down = g0 > 0 && g1 <= 0;
+      if((up && _events[i].direction >= 0) || (down && _events[i].direction <= 0)) {
+        _found.emplace_back(_locate(i, t0, g0, t1, g1, interpolate), i);
+      }
+    }
+    // record in the order of occurrence up to the first terminal event
+    std::sort(_found.begin(), _found.end(), [t0](const auto& a, const auto& b) {
+      return std::abs(a.first - t0) < std::abs(b.first - t0);
+    });
+    bool stop = false;
+    for(const auto& [te, i] : _found) {
+      if(stop && te != stopTime) break;
+      if(te == t1) {
+        std::copy(y1, y1 + _dim, _y.begin());
+      } else {
+        interpolate(te, _y.data());
+      }
+      _te.push_back(te);
+      _ye.insert(_ye.end(), _y.begin(), _y.end());
+      _ie.push_back(int(i));
+      if(_events[i].terminal && !stop) {
+        stop      = true;
+        stopTime  = te;
+        stopState = _y;
+      }
+    }
+    return stop;
+  }
+
+  /**
+   * Stores the recorded events in TE, YE and IE of a result
+   * @param result result of the solver
+   */
+  void store(ODEResult& result) const {
+    if(_te.empty()) return;
+    size_t k  = _te.size();
+    result.TE = Matrix<double>(0, k, 1);
+    result.YE = Matrix<double>(0, k, _dim);
+    result.IE = Matrix<int>(0, k, 1);
+    for(size_t l = 0; l < k; ++l) {
+      result.TE(l, 0) = _te[l];
+      result.IE(l, 0) = _ie[l];
+      std::copy(&_ye[l * _dim], &_ye[l * _dim] + _dim, &result.YE(l, 0));
+    }
+  }
+
+private:
+  //! events
+  std::vector<ODEEvent> _events;
+  //! dimension of the system
+  size_t _dim = 0;
+  //! event functions at the end of the last step
+  std::vector<double> _g;
+  //! interpolated state
+  std::vector<double> _y;
+  //! located zeros of the current step and the index of their event
+  std::vector<std::pair<double, size_t>> _found;
+  //! recorded event times
+  std::vector<double> _te;
+  //! recorded states, rows stored contiguously
+  std::vector<double> _ye;
+  //! recorded event indices
+  std::vector<int> _ie;
+
+  /**
+   * Illinois algorithm on the dense output
+   * @returns time at the zero, on the side of the sign change towards t1
+   */
+  template<typename Interpolation>
+  double _locate(size_t i, double a, double ga, double b, double gb, Interpolation& interpolate) {
+    double tol = 4 * std::numeric_limits<double>::epsilon() * std::max({ 1.0, std::abs(a), std::abs(b) });
+    int side   = 0;
+    for(size_t iter = 0; iter < 100 && gb != 0 && std::abs(b - a) > tol; ++iter) {
+      double c = b - gb * (b - a) / (gb - ga);
+      if(!(std::min(a, b) < c && c < std::max(a, b))) c = 0.5 * (a + b);
+      interpolate(c, _y.data());
+      double gc = _events[i].g(c, _y.data());
+      if(gc == 0) return c;
+      if((gc > 0) == (gb > 0)) {
+        b  = c;
+        gb = gc;
+        if(side == 1) ga *= 0.5;
+        side = 1;
+      } else {
+        a  = c;
+        ga = gc;
+        if(side == -1) gb *= 0.5;
+        side = -1;
+      }
+    }
+    return b;
+  }
+};
+
+/**
+ * Result of the streaming solvers, which only keep the final state
+ * @param t final time
+ * @param y final value
+ * @param dim dimension of the system
+ * @returns ODEResult with a single row
+ */
+inline ODEResult odeFinalState(double t, const double* y, size_t dim) {
+  Matrix<double> Y(0, 1, dim);
+  std::copy(y, y + dim, &Y(0, 0));
+  return { Y, Matrix<double>(t, 1, 1) };
+}
+
+/**
+ * Adapter of an ODE to the in place interface, allocates on every call like the ODE itself
+ * @param fun ode
+ * @param dim dimension of the system
+ * @param column true if fun expects a column vector, false for a row vector
+ * @returns fun evaluated in place
+ */
+inline ODEInPlace odeInPlace(const ODE& fun, size_t dim, bool column = false) {
+  return [fun, dim, column](double t, const double* y, double* dydt) {
+    Matrix<double> in(0, column ? dim : 1, column ? 1 : dim);
+    std::copy(y, y + dim, &in(0, 0));
+    auto out = fun(t, in);
+    std::copy(&out(0, 0), &out(0, 0) + dim, dydt);
+  };
+}
+
+/**
+ * Integration backwards in time for solvers which step forward only. For tEnd < t0 the problem is
+ * solved in s = -t,
+ * $$z'(s) = -f(-s, z), \quad s \in [-t_0, -t_{End}]$$
+ * with negated jacobians and the event functions evaluated at -s (their sign changes keep the
+ * order of the integration, hence EventDirection is unchanged). The times T and TE of the result
+ * are mapped back to t.
+ * @param fun ode, ODE or ODEInPlace
+ * @param dim dimension of the system
+ * @param tInterval interval or output times, increasing or decreasing
+ * @param option solver options
+ * @param solve solve(fun, tInterval, option, direction) runs the forward solver, direction is -1 if
+ * the times it reports are s = -t
+ * @returns result of solve in the original time
+ */
+template<typename Fun, typename Solve>
+ODEResult odeTimeReversal(const Fun& fun, size_t dim, const std::vector<double>& tInterval, const ODEOption& option,
+                          Solve&& solve) {
+  if(tInterval.size() < 2 || !(tInterval.back() < tInterval.front())) return solve(fun, tInterval, option, 1.0);
+  std::vector<double> sInterval(tInterval.size());
+  for(size_t l = 0; l < tInterval.size(); ++l) { sInterval[l] = -tInterval[l]; }
+  Fun reversed;
+  if constexpr(std::is_same_v<Fun, ODEInPlace>) {
+    reversed = [fun, dim](double s, const double* z, double* dzds) {
+      fun(-s, z, dzds);
+      for(size_t i = 0; i < dim; ++i) { dzds[i] = -dzds[i]; }
+    };
+  } else {
+    reversed = [fun](double s, const Matrix<double>& z) { return -1.0 * fun(-s, z); };
+  }
+  ODEOption reversedOption = option;
+  if(option.Jac) {
+    reversedOption.Jac = [Jac = option.Jac](double s, const Matrix<double>& z) { return -1.0 * Jac(-s, z); };
+  }
+  if(option.SparseJac) {
+    reversedOption.SparseJac = [Jac = option.SparseJac](double s, const Matrix<double>& z) {
+      auto J = Jac(-s, z);
+      for(auto& v : J.values) { v = -v; }
+      return J;
+    };
+  }
+  for(auto& event : reversedOption.events) {
+    event.g = [g = event.g](double s, const double* z) { return g(-s, z); };
+  }
+  auto result = solve(reversed, sInterval, reversedOption, -1.0);
+  for(size_t l = 0; l < result.T.rows(); ++l) { result.T(l, 0) = -result.T(l, 0); }
+  for(size_t l = 0; l < result.TE.rows(); ++l) { result.TE(l, 0) = -result.TE(l, 0); }
+  return result;
+}
+
+/**
+ * Change of the step width of backward differences, used by the multistep solvers. The differences
+ * nabla^1, ..., nabla^k of the interpolation polynomial
+ * $$p(t + sh) = y + \sum_j \frac{s (s + 1) \cdots (s + j - 1)}{j!} \nabla^j y$$
+ * on the grid of step width h become differences on the grid of step width rho h.
+ * @param k number of differences
+ * @param rho ratio of the new and the old step width
+ * @returns T with $$\nabla_{new}^i = \sum_j T_{ij} \nabla^j$$, indices from 0 for nabla^1
+ */
+inline Matrix<double> odeDifferenceRescaling(size_t k, double rho) {
+  auto c = [](size_t j, double s) {
+    double out = 1;
+    for(size_t m = 1; m <= j; ++m) { out *= (s + double(m) - 1) / double(m); }
+    return out;
+  };
+  Matrix<double> T(0, k, k);
+  for(size_t i = 1; i <= k; ++i) {
+    for(size_t j = 1; j <= k; ++j) {
+      // i-th difference of c_j on the new grid -l rho, l = 0, ..., i
+      double binomial = 1;
+      for(size_t l = 0; l <= i; ++l) {
+        T(i - 1, j - 1) += (l % 2 == 0 ? 1.0 : -1.0) * binomial * c(j, -double(l) * rho);
+        binomial = binomial * double(i - l) / double(l + 1);
+      }
+    }
+  }
+  return T;
+}
+
+/**
+ * Jacobian used by the implicit solvers
+ * @param fun ode
+ * @param Jac user supplied jacobian or nullptr
+ * @param parallel evaluate the finite differences concurrently (ODEOption::parallelJacobian)
+ * @returns Jac if given, otherwise a forward difference jacobian of fun with respect to y
+ */
+inline ODEJac odeJacobian(const ODE& fun, const ODEJac& Jac, bool parallel = false) {
+  if(Jac) return Jac;
+  return [fun, parallel](double t, const Matrix<double>& y) {
+    return finiteDifferenceJacobian([&fun, t](const Matrix<double>& x) { return fun(t, x); }, y, fun(t, y), 0,
+                                    parallel);
+  };
+}
\ No newline at end of file
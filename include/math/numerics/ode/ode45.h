@@ -5,12 +5,17 @@
  * implementation based on Dormand-Prince Method to solve ordinary differential equations
  * https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
  *
- * Current state:
- * - implemented 7 function evaluations
- * - using 6/7 evaluations for 5th order RK
- *
- * TODO: use calculated error of 5th order - 4th order to alter step width `h` dynamically to fully implement dp-method.
+ * - ODE45(fun, tInterval, y0, h): fixed step width h, 5th order solution of 6 stages.
+ * - ODE45(fun, tInterval, y0, option): adaptive step width. The difference of the embedded 4th and
+ *   5th order solutions is controlled by option.rtol/option.atol with a PI step size controller, the
+ *   last stage is reused as first stage of the next step (FSAL, 6 evaluations per accepted step).
+ *   Values at the requested times are interpolated by the 4th order continuous extension, hence the
+ *   number of evaluations depends on the solution, not on the number of output times. The zeros of
+ *   event functions (ODEOption::events) are located on the same continuous extension.
  *
+ * Both accept an in place right hand side (ODEInPlace), all stages live in one workspace allocated
+ * per call, hence no allocations happen per step. The ODE overloads are adapters to these. Passing
+ * an ODEObserver streams the steps instead of storing the trajectory (O(dim) memory).
  *
  * Requires:
  * \code
@@ -21,18 +26,232 @@
 
 #include "../utils.h"
 #include "ode.h"
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iostream>
+#include <limits>
 #include <vector>
 
+namespace dormand_prince {
+//! nodes
+const double c[7] = { 0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 };
+//! runge kutta matrix, the last row equals the 5th order weights (FSAL)
+const double a[7][6] = { { 0, 0, 0, 0, 0, 0 },
+                         { 1.0 / 5.0, 0, 0, 0, 0, 0 },
+                         { 3.0 / 40.0, 9.0 / 40.0, 0, 0, 0, 0 },
+                         { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0, 0, 0 },
+                         { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0, 0 },
+                         { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0 },
+                         { 35.0 / 384.0, 0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 } };
+//! difference of the 5th and 4th order weights
+const double e[7] = { 71.0 / 57600.0,      0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0,
+                      22.0 / 525.0,        -1.0 / 40.0 };
+//! weights of the continuous extension (Hairer, Norsett, Wanner)
+const double d[7] = { -12715105075.0 / 11282082432.0, 0,
+                      87487479700.0 / 32700410799.0,  -10690763975.0 / 1880347072.0,
+                      701980252875.0 / 199316789632.0, -1453857185.0 / 822651844.0,
+                      69997945.0 / 29380423.0 };
+
 /**
- * Implementation of 5th order Runge-Kutta-Method
+ * weighted root mean square norm used for the error control
+ */
+inline double errorNorm(const std::vector<double>& e, const std::vector<double>& y0, const std::vector<double>& y1,
+                        double rtol, double atol) {
+  double sum = 0;
+  for(size_t i = 0; i < e.size(); ++i) {
+    double sk = atol + rtol * std::max(std::abs(y0[i]), std::abs(y1[i]));
+    sum += (e[i] / sk) * (e[i] / sk);
+  }
+  return e.empty() ? 0.0 : std::sqrt(sum / double(e.size()));
+}
+
+/**
+ * Adaptive Dormand-Prince integration, emit(t, y, rejected) is called with the start value, every
+ * output time (dense) or every accepted step and the number of rejected steps since the last call.
+ * A terminal event ends the integration with an additional output at the event.
+ * @returns final time
+ */
+template<typename Output>
+double adaptive(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                const ODEOption& option, ODEEvents& events, std::vector<double>& y, Output&& emit) {
+  size_t dim    = y0.columns();
+  double t      = tInterval.front();
+  double tEnd   = tInterval.back();
+  bool dense    = tInterval.size() > 2;
+  double rtol   = option.rtol;
+  double atol   = option.atol;
+  auto evaluate = [&fun](double tk, const std::vector<double>& v, std::vector<double>& out) {
+    fun(tk, v.data(), out.data());
+  };
+
+  // workspace of all steps
+  y.assign(dim, 0.0);
+  std::vector<double> yNew(dim), err(dim), stage(dim), yi(dim);
+  std::vector<std::vector<double>> k(7, std::vector<double>(dim));
+  std::vector<double> r2(dim), r3(dim), r4(dim), r5(dim);
+  for(size_t i = 0; i < dim; ++i) { y[i] = y0(0, i); }
+  evaluate(t, y, k[0]);
+
+  double direction = tEnd >= t ? 1.0 : -1.0;
+
+  // initial step width (Hairer, Norsett, Wanner: Solving ODEs I, II.4), probed towards tEnd
+  double h = std::abs(option.h);
+  if(h == 0) {
+    double d0 = errorNorm(y, y, y, rtol, atol);
+    double d1 = errorNorm(k[0], y, y, rtol, atol);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+    h0        = std::min(h0, std::abs(tEnd - t));
+    for(size_t i = 0; i < dim; ++i) { stage[i] = y[i] + direction * h0 * k[0][i]; }
+    evaluate(t + direction * h0, stage, k[1]);
+    for(size_t i = 0; i < dim; ++i) { err[i] = (k[1][i] - k[0][i]) / h0; }
+    double d2 = errorNorm(err, y, y, rtol, atol);
+    double h1 = std::max(d1, d2) <= 1e-15 ? std::max(1e-6, h0 * 1e-3) : std::pow(0.01 / std::max(d1, d2), 0.2);
+    h         = std::min(100 * h0, h1);
+  }
+
+  emit(t, y.data(), 0);
+  events.start(t, y.data(), dim);
+  size_t nextOut = 1;
+
+  // PI controller of DOPRI5
+  const double beta = 0.04, expo = 0.2 - 0.75 * beta, safety = 0.9;
+  double errOld     = 1e-4;
+  int rejected      = 0;
+  while(direction * (tEnd - t) > 0) {
+    if(h < 16 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(t))) {
+      std::cerr << "ODE45: step width too small at t = " << t << std::endl;
+      break;
+    }
+    bool last = h >= std::abs(tEnd - t);
+    if(last) h = std::abs(tEnd - t);
+    double hs = direction * h;
+
+    for(size_t s = 1; s < 7; ++s) {
+      for(size_t i = 0; i < dim; ++i) {
+        double sum = 0;
+        for(size_t j = 0; j < s; ++j) { sum += a[s][j] * k[j][i]; }
+        stage[i] = y[i] + hs * sum;
+      }
+      evaluate(t + c[s] * hs, stage, k[s]);
+    }
+    // the last stage was evaluated at the 5th order solution
+    yNew = stage;
+    for(size_t i = 0; i < dim; ++i) {
+      double sum = 0;
+      for(size_t j = 0; j < 7; ++j) { sum += e[j] * k[j][i]; }
+      err[i] = hs * sum;
+    }
+    double error = errorNorm(err, y, yNew, rtol, atol);
+
+    double fac11 = std::pow(std::max(error, 1e-300), expo);
+    if(error > 1.0 || std::isnan(error)) {
+      h /= std::isnan(error) ? 10.0 : std::min(5.0, fac11 / safety);
+      rejected++;
+      continue;
+    }
+
+    // continuous extension of the accepted step
+    double tNew = last ? tEnd : t + hs;
+    if(dense || !events.empty()) {
+      for(size_t i = 0; i < dim; ++i) {
+        r2[i]      = yNew[i] - y[i];
+        r3[i]      = hs * k[0][i] - r2[i];
+        r4[i]      = r2[i] - hs * k[6][i] - r3[i];
+        double sum = 0;
+        for(size_t j = 0; j < 7; ++j) { sum += d[j] * k[j][i]; }
+        r5[i] = hs * sum;
+      }
+    }
+    auto interpolate = [&](double ti, double* out) {
+      double theta = (ti - t) / hs, theta1 = 1 - theta;
+      for(size_t i = 0; i < dim; ++i) {
+        out[i] = y[i] + theta * (r2[i] + theta1 * (r3[i] + theta * (r4[i] + theta1 * r5[i])));
+      }
+    };
+    bool stop = events.step(t, tNew, yNew.data(), interpolate);
+    if(stop) tNew = events.stopTime;
+    if(dense) {
+      while(nextOut < tInterval.size() && direction * (tInterval[nextOut] - tNew) <= 0) {
+        if(nextOut + 1 == tInterval.size() && !stop) {
+          yi = yNew;
+        } else {
+          interpolate(tInterval[nextOut], yi.data());
+        }
+        emit(tInterval[nextOut++], yi.data(), rejected);
+        rejected = 0;
+      }
+    }
+    if(stop) yNew = events.stopState;
+    if(!dense || (stop && tInterval[nextOut - 1] != tNew)) {
+      emit(tNew, yNew.data(), rejected);
+      rejected = 0;
+    }
+
+    t = tNew;
+    y = yNew;
+    if(stop) break;
+    std::swap(k[0], k[6]);
+    double fac = std::max(0.1, std::min(5.0, fac11 / std::pow(errOld, beta) / safety));
+    errOld     = std::max(error, 1e-4);
+    h /= fac;
+  }
+  return t;
+}
+} // namespace dormand_prince
+
+
+/**
+ * Implementation of 5th order Runge-Kutta-Method on an in place ode, streaming every step to an
+ * observer. Memory usage is O(dim) regardless of the number of steps.
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h step width for time values
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODE45(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h,
+                const ODEObserver& observer) {
+  using namespace dormand_prince;
+  size_t dim       = tInterval.size();
+  size_t elem_size = y0.columns();
+  if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000; }
+  size_t n = int((tInterval[dim - 1] - tInterval[0]) / h) + 1;
+
+  // workspace: state, 6 stages and the stage value
+  std::vector<double> y(elem_size), k(6 * elem_size), y_k(elem_size);
+  for(size_t elem = 0; elem < elem_size; elem++) { y[elem] = y0(0, elem); }
+  double t = tInterval[0];
+  observer(t, y.data());
+  for(size_t l = 0; l < n - 1; l++) {
+    for(size_t i_k = 0; i_k < 6; i_k++) {
+      y_k = y;
+      for(size_t j = 0; j < i_k; j++) {
+        for(size_t elem = 0; elem < elem_size; elem++) { y_k[elem] += h * a[i_k][j] * k[j * elem_size + elem]; }
+      }
+      fun(t + c[i_k] * h, y_k.data(), &k[i_k * elem_size]);
+    }
+    for(size_t elem = 0; elem < elem_size; elem++) {
+      double sum = 0;
+      for(size_t j = 0; j < 6; j++) { sum += a[6][j] * k[j * elem_size + elem]; }
+      y[elem] += sum * h;
+    }
+    t += h;
+    observer(t, y.data());
+  }
+  return odeFinalState(t, y.data(), elem_size);
+}
+
+/**
+ * Implementation of 5th order Runge-Kutta-Method on an in place ode
  * @param fun ode to approximate
  * @param tInterval interval to perform approximation on
  * @param y0 start value
  * @param h step width for time values
  * @returns approximated values
  */
-ODEResult ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
+ODEResult ODE45(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
   size_t dim       = tInterval.size();
   size_t elem_size = y0.columns();
   if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000; }
@@ -42,39 +261,134 @@ ODEResult ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matr
   size_t n         = result_dim;
   Matrix<double> y = zeros(n, elem_size);
 
-  Matrix<double> a({ { 0, 0, 0, 0, 0, 0, 0 },
-                     { 1.0 / 5.0, 0, 0, 0, 0, 0, 0 },
-                     { 3.0 / 40.0, 9.0 / 40.0, 0, 0, 0, 0, 0 },
-                     { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0, 0, 0, 0 },
-                     { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0, 0, 0 },
-                     { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0, 0 },
-                     { 35.0 / 384.0, 0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0 } });
-
-  Matrix<double> c({ { 0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 } });
+  size_t row = 0;
+  ODE45(fun, tInterval, y0, h, [&](double tl, const double* yl) {
+    t(row, 0) = tl;
+    std::copy(yl, yl + elem_size, &y(row++, 0));
+  });
+  return { y, t };
+}
 
-  Matrix<double> b5({ { 35.0 / 384.0, 0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 } });
-  [[maybe_unused]] Matrix<double> b4(
-  { { 5179.0 / 57600.0, 0, 7571.0 / 16695.0, 393.0 / 640.0, -92097.0 / 339200.0, 187.0 / 2100.0, 1.0 / 40.0 } });
+/**
+ * Implementation of 5th order Runge-Kutta-Method
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h step width for time values
+ * @returns approximated values
+ */
+ODEResult ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h = 0.0) {
+  return ODE45(odeInPlace(fun, y0.columns()), tInterval, y0, h);
+}
 
+/**
+ * Implementation of 5th order Runge-Kutta-Method, streaming every step to an observer
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param h step width for time values
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, double h,
+                const ODEObserver& observer) {
+  return ODE45(odeInPlace(fun, y0.columns()), tInterval, y0, h, observer);
+}
 
-  y.SetRow(0, y0);
-  t(0, 0) = tInterval[0];
-  for(size_t l = 0; l < n - 1; l++) {
-    t(l + 1, 0) = t(l, 0) + h;
-    auto k      = zeros(6, elem_size);
-    for(size_t i_k = 0; i_k < 6; i_k++) {
-      Matrix<double> y_k = y(l);
+/**
+ * Adaptive Dormand-Prince method with embedded error control and dense output.
+ *
+ * Output times: if tInterval holds more than two values the solution is reported at exactly these
+ * (increasing) times, otherwise at every accepted step. The number of rejected steps until each
+ * output is stored in Iterations. The events of option.events are stored in TE, YE and IE, a
+ * terminal event ends the integration with a last output at the event.
+ *
+ * @param fun ode to approximate in place
+ * @param tInterval interval to perform approximation on, or all output times
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @returns approximated values
+ */
+inline ODEResult
+ODE45(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+  size_t dim = y0.columns();
+  // output, rows of yOut are stored contiguously
+  std::vector<double> tOut, yOut, y;
+  std::vector<int> rejectedOut;
+  if(tInterval.size() > 2) {
+    tOut.reserve(tInterval.size());
+    yOut.reserve(tInterval.size() * dim);
+    rejectedOut.reserve(tInterval.size());
+  }
+  ODEEvents events(option.events);
+  dormand_prince::adaptive(fun, tInterval, y0, option, events, y, [&](double t, const double* yt, int rejected) {
+    tOut.push_back(t);
+    yOut.insert(yOut.end(), yt, yt + dim);
+    rejectedOut.push_back(rejected);
+  });
 
-      for(size_t j = 0; j < i_k; j++) {
-        for(size_t elem = 0; elem < elem_size; elem++) { y_k(0, elem) += h * a(i_k, j) * k(j, elem); }
-      }
-      k.SetRow(i_k, fun(t(l, 0) + c(0, i_k) * h, y_k));
-    }
-    auto y_l = y(l) + (b5 * k) * h;
-    y.SetRow(l + 1, y_l);
+  Matrix<double> T(0, tOut.size(), 1);
+  Matrix<double> Y(0, tOut.size(), dim);
+  Matrix<int> iter(0, tOut.size(), 1);
+  for(size_t l = 0; l < tOut.size(); ++l) {
+    T(l, 0)    = tOut[l];
+    iter(l, 0) = rejectedOut[l];
+    for(size_t i = 0; i < dim; ++i) { Y(l, i) = yOut[l * dim + i]; }
   }
-  return { y, t };
+  ODEResult result(Y, T, iter);
+  events.store(result);
+  return result;
+}
+
+/**
+ * Adaptive Dormand-Prince method streaming to an observer, see
+ * ODE45(const ODEInPlace&, const std::vector<double>&, const Matrix<double>&, const ODEOption&)
+ * @param fun ode to approximate in place
+ * @param tInterval interval to perform approximation on, or all output times
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @param observer called with t and y of the start value and every output time or accepted step
+ * @returns final time and value
+ */
+inline ODEResult ODE45(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                       const ODEOption& option, const ODEObserver& observer) {
+  std::vector<double> y;
+  ODEEvents events(option.events);
+  double t    = dormand_prince::adaptive(fun, tInterval, y0, option, events, y,
+                                         [&observer](double ti, const double* yi, int) { observer(ti, yi); });
+  auto result = odeFinalState(t, y.data(), y.size());
+  events.store(result);
+  return result;
+}
+
+/**
+ * Adaptive Dormand-Prince method with embedded error control and dense output, see
+ * ODE45(const ODEInPlace&, const std::vector<double>&, const Matrix<double>&, const ODEOption&)
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on, or all output times
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @returns approximated values
+ */
+inline ODEResult
+ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+  return ODE45(odeInPlace(fun, y0.columns()), tInterval, y0, option);
+}
+
+/**
+ * Adaptive Dormand-Prince method streaming to an observer
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on, or all output times
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @param observer called with t and y of the start value and every output time or accepted step
+ * @returns final time and value
+ */
+inline ODEResult ODE45(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                       const ODEOption& option, const ODEObserver& observer) {
+  return ODE45(odeInPlace(fun, y0.columns()), tInterval, y0, option, observer);
 }
+
 /**
  * \example numerics/ode/TestODE45.cpp
  * This is an example on how to use ODE45.
@@ -0,0 +1,403 @@
+/**
+ * @file odeAdams.h
+ *
+ * Variable step, variable order (1 - 12) Adams-Bashforth-Moulton method in PECE mode for non-stiff
+ * odes with expensive right hand sides. Every step costs two evaluations of f (predict, evaluate,
+ * correct, evaluate) compared to six of ODE45().
+ *
+ * - The history of f is kept as backward differences; the predictor is Adams-Bashforth of order k,
+ *   the corrector Adams-Moulton of order k + 1 (local extrapolation), the difference of the
+ *   Adams-Moulton formulas of order k and k + 1 estimates the local error.
+ * - Step width changes interpolate the differences (see odeDifferenceRescaling()), the step is
+ *   halved on demand and doubled if the error allows. The order is lowered if the next lower order
+ *   has a smaller error estimate and raised after k + 2 steps of constant width if the next higher
+ *   order has a smaller one.
+ * - The method is started by three steps of the Dormand-Prince method with order 4.
+ * - Dense output integrates the interpolation polynomial of f, hence it has the order of the method.
+ * - Decreasing output times integrate backwards in time by odeTimeReversal().
+ *
+ * Usage:
+ * \code
+ * ODEOption option;
+ * option.rtol = 1e-8;
+ * auto res = ODEAdams(fun, linspace(0, 10, 101), y0, option);
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/odeAdams.h>
+ * \endcode
+ */
+#pragma once
+
+#include "ode.h"
+#include "ode45.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace adams {
+//! highest order
+const size_t maxOrder = 12;
+
+/**
+ * Coefficients of the Adams methods in backward difference form
+ */
+struct Coefficients {
+  //! Adams-Bashforth: $$y_{n+1} = y_n + h \sum_{j<k} \gamma_j \nabla^j f_n$$
+  double explicitGamma[maxOrder + 2];
+  //! Adams-Moulton: $$y_{n+1} = y_n + h \sum_{j<k} \gamma^*_j \nabla^j f_{n+1}$$
+  double implicitGamma[maxOrder + 2];
+};
+
+/**
+ * @returns coefficients computed from $$\sum_{i \le j} \gamma_i / (j + 1 - i) = 1$$ and
+ * $$\sum_{i \le j} \gamma^*_i / (j + 1 - i) = 0$$ for j > 0
+ */
+inline const Coefficients& coefficients() {
+  static const Coefficients out = [] {
+    Coefficients c{};
+    for(size_t j = 0; j < maxOrder + 2; ++j) {
+      c.explicitGamma[j] = 1;
+      c.implicitGamma[j] = j == 0 ? 1 : 0;
+      for(size_t i = 0; i < j; ++i) {
+        c.explicitGamma[j] -= c.explicitGamma[i] / double(j + 1 - i);
+        c.implicitGamma[j] -= c.implicitGamma[i] / double(j + 1 - i);
+      }
+    }
+    return c;
+  }();
+  return out;
+}
+
+/**
+ * Adaptive Adams PECE integration, emit(t, y, rejected) is called with the start value, every
+ * output time (dense) or every accepted step and the number of rejected steps since the last call.
+ * A terminal event ends the integration with an additional output at the event.
+ * @returns final time
+ */
+template<typename Output>
+double integrate(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                 const ODEOption& option, ODEEvents& events, std::vector<double>& y, Output&& emit) {
+  const auto& gamma = coefficients();
+  size_t dim        = y0.columns();
+  double t          = tInterval.front();
+  double tEnd       = tInterval.back();
+  bool dense        = tInterval.size() > 2;
+  double rtol       = option.rtol;
+  double atol       = option.atol;
+  auto norm         = [&](const std::vector<double>& e, const std::vector<double>& y1) {
+    return dormand_prince::errorNorm(e, y, y1, rtol, atol);
+  };
+
+  // D[0] = f_n, D[j] = nabla^j f_n
+  y.assign(dim, 0.0);
+  std::vector<std::vector<double>> D(maxOrder + 2, std::vector<double>(dim, 0.0)), Dn = D;
+  std::vector<double> yNew(dim), f(dim), E(dim), sum(dim), yi(dim), yOld(dim);
+  for(size_t i = 0; i < dim; ++i) { y[i] = y0(0, i); }
+  fun(t, y.data(), D[0].data());
+  emit(t, y.data(), 0);
+  events.start(t, y.data(), dim);
+  if(!(tEnd > t)) return t; // tEnd < t is mapped to forward integration by odeTimeReversal()
+  size_t nextOut = 1;
+
+  // initial step width (Hairer, Norsett, Wanner) for order 4
+  double h = std::abs(option.h);
+  if(h == 0) {
+    double d0 = norm(y, y), d1 = norm(D[0], y);
+    double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+    h0        = std::min(h0, tEnd - t);
+    for(size_t i = 0; i < dim; ++i) { yNew[i] = y[i] + h0 * D[0][i]; }
+    fun(t + h0, yNew.data(), f.data());
+    for(size_t i = 0; i < dim; ++i) { E[i] = (f[i] - D[0][i]) / h0; }
+    double d2 = norm(E, y);
+    double h1 = std::max(d1, d2) <= 1e-15 ? std::max(1e-6, h0 * 1e-3) : std::pow(0.01 / std::max(d1, d2), 0.2);
+    h         = std::min(100 * h0, h1);
+  }
+  h = std::min(h, (tEnd - t) / 4);
+
+  // update of the differences by a new value of f, Dn[j] = nabla^j f_{n+1}
+  auto differences = [&](const std::vector<double>& fNew, size_t count) {
+    Dn[0] = fNew;
+    for(size_t j = 1; j <= count; ++j) {
+      for(size_t i = 0; i < dim; ++i) { Dn[j][i] = Dn[j - 1][i] - D[j - 1][i]; }
+    }
+    for(size_t j = 0; j <= count; ++j) { std::swap(D[j], Dn[j]); }
+  };
+  // y(t + s h) = y + h sum_{j <= k} W_j(s) nabla^j f with W_j(s) the integral of c_j from 0 to s
+  std::vector<double> poly, W(maxOrder + 2);
+  auto interpolate = [&](double s, size_t k) {
+    poly.assign(1, 1.0);
+    for(size_t j = 0; j <= k; ++j) {
+      if(j > 0) {
+        // multiply by (u + j - 1) / j
+        poly.push_back(0.0);
+        for(size_t p = poly.size() - 1; p > 0; --p) { poly[p] = (poly[p - 1] + (double(j) - 1) * poly[p]) / double(j); }
+        poly[0] *= (double(j) - 1) / double(j);
+      }
+      double w = 0, sp = s;
+      for(size_t p = 0; p < poly.size(); ++p, sp *= s) { w += poly[p] * sp / double(p + 1); }
+      W[j] = w;
+    }
+    for(size_t i = 0; i < dim; ++i) {
+      double v = 0;
+      for(size_t j = 0; j <= k; ++j) { v += W[j] * D[j][i]; }
+      yi[i] = y[i] + h * v;
+    }
+  };
+
+  // start values by the Dormand-Prince method, the differences reach order 4
+  size_t k  = 1;
+  bool stop = false;
+  std::vector<std::vector<double>> stages(6, std::vector<double>(dim));
+  for(; k < 4 && !stop; ++k) {
+    stages[0] = D[0];
+    yOld      = y;
+    for(size_t s = 1; s < 6; ++s) {
+      for(size_t i = 0; i < dim; ++i) {
+        double v = 0;
+        for(size_t j = 0; j < s; ++j) { v += dormand_prince::a[s][j] * stages[j][i]; }
+        yNew[i] = y[i] + h * v;
+      }
+      fun(t + dormand_prince::c[s] * h, yNew.data(), stages[s].data());
+    }
+    for(size_t i = 0; i < dim; ++i) {
+      double v = 0;
+      for(size_t j = 0; j < 6; ++j) { v += dormand_prince::a[6][j] * stages[j][i]; }
+      y[i] += h * v;
+    }
+    t += h;
+    fun(t, y.data(), f.data());
+    differences(f, k);
+    // events on the cubic Hermite interpolation of the step
+    stop = events.step(t - h, t, y.data(), [&](double ti, double* out) {
+      double s = (ti - t) / h + 1;
+      for(size_t i = 0; i < dim; ++i) {
+        out[i] = (1 + 2 * s) * (1 - s) * (1 - s) * yOld[i] + s * (1 - s) * (1 - s) * h * stages[0][i]
+                 + s * s * (3 - 2 * s) * y[i] + s * s * (s - 1) * h * f[i];
+      }
+    });
+    if(!dense && !stop) emit(t, y.data(), 0);
+  }
+  double tStep = t;
+  if(stop) t = events.stopTime;
+  if(dense) {
+    while(nextOut < tInterval.size() && tInterval[nextOut] <= t) {
+      interpolate((tInterval[nextOut] - tStep) / h, k - 1);
+      emit(tInterval[nextOut++], yi.data(), 0);
+    }
+  }
+  if(stop) {
+    y = events.stopState;
+    if(!dense || tInterval[nextOut - 1] != t) emit(t, y.data(), 0);
+    return t;
+  }
+
+  size_t constant = k, failures = 0;
+  int rejected    = 0;
+  auto rescale    = [&](double rho) {
+    if(rho == 1.0) return;
+    // the differences nabla^1 ... nabla^k
+    auto T = odeDifferenceRescaling(k, rho);
+    for(size_t i = 0; i < k; ++i) {
+      for(size_t c = 0; c < dim; ++c) {
+        double v = 0;
+        for(size_t j = 0; j < k; ++j) { v += T(i, j) * D[j + 1][c]; }
+        Dn[i + 1][c] = v;
+      }
+    }
+    for(size_t i = 1; i <= k; ++i) { std::swap(D[i], Dn[i]); }
+    h *= rho;
+    constant = 0;
+  };
+
+  while(t < tEnd) {
+    if(h < 16 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(t))) {
+      std::cerr << "ODEAdams: step width too small at t = " << t << std::endl;
+      break;
+    }
+    bool last = 1.1 * h >= tEnd - t;
+    if(last) rescale((tEnd - t) / h);
+    double tNew = last ? tEnd : t + h;
+
+    // predict (Adams-Bashforth of order k) and evaluate
+    std::fill(sum.begin(), sum.end(), 0.0);
+    for(size_t j = 0; j < k; ++j) {
+      for(size_t i = 0; i < dim; ++i) { sum[i] += gamma.explicitGamma[j] * D[j][i]; }
+    }
+    for(size_t i = 0; i < dim; ++i) { yNew[i] = y[i] + h * sum[i]; }
+    fun(tNew, yNew.data(), f.data());
+
+    // correct (Adams-Moulton of order k + 1), E = nabla^k f_{n+1} with the predicted f
+    for(size_t i = 0; i < dim; ++i) {
+      double extrapolated = 0;
+      for(size_t j = 0; j < k; ++j) { extrapolated += D[j][i]; }
+      E[i] = f[i] - extrapolated;
+      yNew[i] += h * gamma.explicitGamma[k] * E[i];
+    }
+    double error = std::abs(h * gamma.implicitGamma[k]) * norm(E, yNew);
+    if(error > 1.0 || std::isnan(error)) {
+      rejected++;
+      failures++;
+      // lower the order if the formula of order k has the smaller error, nabla^(k-1) f_{n+1} = D[k-1] + E
+      if(k > 1) {
+        for(size_t i = 0; i < dim; ++i) { sum[i] = D[k - 1][i] + E[i]; }
+        if(std::isnan(error) || std::abs(h * gamma.implicitGamma[k - 1]) * norm(sum, yNew) <= error) k--;
+      }
+      // repeated failures restart with the lowest order
+      double ratio = std::isnan(error) ? 0.25 : std::max(0.1, 0.9 * std::pow(error, -1.0 / double(k + 1)));
+      if(failures >= 3) {
+        k     = 1;
+        ratio = 0.25;
+      }
+      rescale(ratio);
+      continue;
+    }
+    failures = 0;
+
+    // evaluate and update the history
+    fun(tNew, yNew.data(), f.data());
+    differences(f, k + 1);
+    std::swap(y, yNew);
+    tStep = tNew;
+    stop  = events.step(t, tNew, y.data(), [&](double ti, double* out) {
+      interpolate((ti - tStep) / h, k);
+      std::copy(yi.begin(), yi.end(), out);
+    });
+    if(stop) tNew = events.stopTime;
+    if(dense) {
+      while(nextOut < tInterval.size() && tInterval[nextOut] <= tNew) {
+        bool final = ++nextOut == tInterval.size() && !stop;
+        if(!final) interpolate((tInterval[nextOut - 1] - tStep) / h, k);
+        emit(tInterval[nextOut - 1], final ? y.data() : yi.data(), rejected);
+        rejected = 0;
+      }
+    }
+    if(stop) y = events.stopState;
+    if(!dense || (stop && tInterval[nextOut - 1] != tNew)) {
+      emit(tNew, y.data(), rejected);
+      rejected = 0;
+    }
+    t = tNew;
+    constant++;
+    if(last || stop) break;
+
+    // order and step width of the next step
+    auto estimate = [&](size_t order) {
+      return std::abs(h * gamma.implicitGamma[order]) * dormand_prince::errorNorm(D[order], y, y, rtol, atol);
+    };
+    double errk = estimate(k);
+    if(k > 1 && estimate(k - 1) <= errk) {
+      k--;
+      errk     = estimate(k);
+      constant = 0;
+    } else if(k < maxOrder && constant >= k + 2 && estimate(k + 1) < errk) {
+      k++;
+      errk     = estimate(k);
+      constant = 0;
+    }
+    double ratio = 0.9 * std::pow(std::max(errk, 1e-16), -1.0 / double(k + 1));
+    if(ratio >= 2.0) {
+      rescale(2.0);
+    } else if(ratio < 1.0) {
+      rescale(std::max(0.5, ratio));
+    }
+  }
+  return t;
+}
+} // namespace adams
+
+/**
+ * Adaptive Adams-Bashforth-Moulton PECE method on an in place ode
+ * @param fun ode to approximate in place
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @returns approximated values, the number of rejected steps in Iterations and the events in TE, YE and IE
+ */
+inline ODEResult ODEAdams(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                          const ODEOption& option) {
+  size_t dim = y0.columns();
+  return odeTimeReversal(fun, dim, tInterval, option,
+                         [&](const ODEInPlace& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           // output, rows of yOut are stored contiguously
+                           std::vector<double> tOut, yOut, y;
+                           std::vector<int> rejectedOut;
+                           ODEEvents events(o.events);
+                           adams::integrate(f, ti, y0, o, events, y, [&](double t, const double* yt, int rejected) {
+                             tOut.push_back(t);
+                             yOut.insert(yOut.end(), yt, yt + dim);
+                             rejectedOut.push_back(rejected);
+                           });
+
+                           Matrix<double> T(0, tOut.size(), 1);
+                           Matrix<double> Y(0, tOut.size(), dim);
+                           Matrix<int> iter(0, tOut.size(), 1);
+                           for(size_t l = 0; l < tOut.size(); ++l) {
+                             T(l, 0)    = tOut[l];
+                             iter(l, 0) = rejectedOut[l];
+                             for(size_t i = 0; i < dim; ++i) { Y(l, i) = yOut[l * dim + i]; }
+                           }
+                           ODEResult result(Y, T, iter);
+                           events.store(result);
+                           return result;
+                         });
+}
+
+/**
+ * Adaptive Adams-Bashforth-Moulton PECE method streaming to an observer
+ * @param fun ode to approximate in place
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @param observer called with t and y of the start value and every output time or accepted step
+ * @returns final time and value
+ */
+inline ODEResult ODEAdams(const ODEInPlace& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                          const ODEOption& option, const ODEObserver& observer) {
+  return odeTimeReversal(
+      fun, y0.columns(), tInterval, option,
+      [&](const ODEInPlace& f, const std::vector<double>& ti, const ODEOption& o, double direction) {
+        std::vector<double> y;
+        ODEEvents events(o.events);
+        double t    = adams::integrate(f, ti, y0, o, events, y, [&](double s, const double* yi, int) {
+          observer(direction * s, yi);
+        });
+        auto result = odeFinalState(t, y.data(), y.size());
+        events.store(result);
+        return result;
+      });
+}
+
+/**
+ * Adaptive Adams-Bashforth-Moulton PECE method
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @returns approximated values, the number of rejected steps in Iterations and the events in TE, YE and IE
+ */
+inline ODEResult
+ODEAdams(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+  return ODEAdams(odeInPlace(fun, y0.columns()), tInterval, y0, option);
+}
+
+/**
+ * Adaptive Adams-Bashforth-Moulton PECE method streaming to an observer
+ * @param fun ode to approximate, called with row vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, events and h as initial step width (0 chooses automatically)
+ * @param observer called with t and y of the start value and every output time or accepted step
+ * @returns final time and value
+ */
+inline ODEResult ODEAdams(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                          const ODEOption& option, const ODEObserver& observer) {
+  return ODEAdams(odeInPlace(fun, y0.columns()), tInterval, y0, option, observer);
+}
+
+/**
+ * \example numerics/ode/TestODEAdams.cpp
+ * This is an example on how to use the Adams-Bashforth-Moulton solver.
+ */
@@ -0,0 +1,617 @@
+/**
+ * @file odeBDF.h
+ *
+ * Variable step, variable order (1 - 5) BDF method for stiff odes in backward difference form
+ * (Shampine, Reichelt: "The MATLAB ODE Suite"), in contrast to ODEBDF2() with error control.
+ *
+ * - The step width is adapted by the local error estimate, the order is raised or lowered whenever
+ *   a neighbouring order allows a larger step. Step changes interpolate the backward differences.
+ * - The iteration matrix $$I - \gamma J$$ of the Newton iteration is factorized once and reused
+ *   across steps as long as $$\gamma = h / G_k$$ changes by less than 30% (the newton update is
+ *   scaled by $$2 / (1 + \gamma / \gamma_{LU})$$ in between, as in CVODE). The jacobian is only
+ *   reevaluated if the Newton iteration fails to converge with an outdated one, hence stiff
+ *   problems need a few jacobians and factorizations per thousand steps (see BDFStatistics).
+ * - Dense, banded (BandedLU) or sparse (SparseLU, symbolic analysis done once) iteration matrices.
+ *   Banded and sparse jacobians are approximated by finite differences on the known pattern with
+ *   column coloring, e.g. kl + ku + 1 evaluations of f for banded ones. The colors are evaluated
+ *   sequentially unless ODEOption::parallelJacobian is set, f must then be thread safe.
+ * - tEnd < t0 integrates backwards in time, the step control runs forward in s = -t (odeTimeReversal()).
+ *
+ * Usage:
+ * \code
+ * BDFStatistics stats;
+ * auto res  = ODEBDF(fun, { 0, 100 }, y0, option, &stats);          // dense, option.Jac or finite differences
+ * auto res2 = ODEBDF(fun, { 0, 100 }, y0, option, 1, 1);            // tridiagonal jacobian
+ * auto res3 = ODEBDF(fun, linspace(0, 100, 101), y0, option, pattern); // sparse jacobian, dense output
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/odeBDF.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../lin_alg/BandedMatrix.h"
+#include "../lin_alg/LU.h"
+#include "../lin_alg/finiteDifferences.h"
+#include "../lin_alg/sparseDirect.h"
+#include "../utils.h"
+#include "ode.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+/**
+ * Work counters of the stiff solvers ODEBDF and ODERosenbrock
+ */
+struct BDFStatistics {
+  //! accepted steps
+  size_t steps = 0;
+  //! steps rejected by the error test
+  size_t rejected = 0;
+  //! Newton iterations
+  size_t newtonIterations = 0;
+  //! Newton iterations without convergence
+  size_t newtonFailures = 0;
+  //! evaluations of f, including finite differences
+  size_t functionEvaluations = 0;
+  //! jacobian evaluations
+  size_t jacobians = 0;
+  //! LU factorizations of the iteration matrix
+  size_t factorizations = 0;
+};
+
+namespace bdf {
+//! highest order
+const size_t maxOrder = 5;
+//! G_k = 1 + 1/2 + ... + 1/k, the BDF of order k is sum_j G_j nabla^j y = h f with leading coefficient G_k
+const double G[maxOrder + 2] = { 0, 1.0, 3.0 / 2.0, 11.0 / 6.0, 25.0 / 12.0, 137.0 / 60.0, 49.0 / 20.0 };
+
+/**
+ * Storage of the iteration matrix
+ */
+enum IterationStorage {
+  //! dense LU
+  DENSE_ITERATION = 0,
+  //! BandedLU
+  BANDED_ITERATION = 1,
+  //! SparseLU
+  SPARSE_ITERATION = 2
+};
+
+/**
+ * Jacobian and factorized iteration matrix $$I - \gamma J$$
+ */
+class IterationMatrix
+{
+public:
+  /**
+   * Dense iteration matrix
+   * @param fun ode
+   * @param Jac jacobian of fun, nullptr for finite differences
+   * @param parallel evaluate the finite differences concurrently
+   */
+  IterationMatrix(const ODE& fun, const ODEJac& Jac, bool parallel = false)
+    : _fun(fun)
+    , _Jac(Jac)
+    , _parallel(parallel) { }
+
+  /**
+   * Banded iteration matrix, finite difference jacobian
+   * @param fun ode
+   * @param n dimension of the system
+   * @param kl number of sub-diagonals of the jacobian
+   * @param ku number of super-diagonals of the jacobian
+   * @param Jac jacobian of fun inside the band, nullptr for finite differences
+   * @param parallel evaluate the finite differences concurrently
+   */
+  IterationMatrix(const ODE& fun, size_t n, size_t kl, size_t ku, const ODESparseJac& Jac = nullptr,
+                  bool parallel = false)
+    : _fun(fun)
+    , _sparseJac(Jac)
+    , _parallel(parallel)
+    , _storage(BANDED_ITERATION)
+    , _kl(kl)
+    , _ku(ku) {
+    COOMatrix<double> band(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = i > kl ? i - kl : 0; j <= std::min(n - 1, i + ku); ++j) { band.add(i, j, 1.0); }
+    }
+    _pattern = CSRMatrix<double>(band);
+    _colors  = jacobianColoring(_pattern);
+  }
+
+  /**
+   * Sparse iteration matrix, finite difference jacobian
+   * @param fun ode
+   * @param pattern sparsity pattern of the jacobian, the values are ignored
+   * @param Jac jacobian of fun with the given pattern, nullptr for finite differences
+   * @param parallel evaluate the finite differences concurrently
+   */
+  IterationMatrix(const ODE& fun, const CSRMatrix<double>& pattern, const ODESparseJac& Jac = nullptr,
+                  bool parallel = false)
+    : _fun(fun)
+    , _sparseJac(Jac)
+    , _parallel(parallel)
+    , _storage(SPARSE_ITERATION)
+    , _pattern(pattern)
+    , _colors(jacobianColoring(pattern)) { }
+
+  /**
+   * Evaluates the jacobian
+   * @param t time
+   * @param y state (column vector)
+   * @param stats work counters
+   */
+  void evaluate(double t, const Matrix<double>& y, BDFStatistics& stats) {
+    stats.jacobians++;
+    auto f = [this, t](const Matrix<double>& x) { return _fun(t, x); };
+    if(_storage == DENSE_ITERATION) {
+      if(_Jac) {
+        _J = _Jac(t, y);
+      } else {
+        _J = finiteDifferenceJacobian(f, y, _fun(t, y), 0, _parallel);
+        stats.functionEvaluations += y.rows() + 1;
+      }
+      return;
+    }
+    if(_sparseJac) {
+      _sparseJ = _sparseJac(t, y);
+      return;
+    }
+    _sparseJ = finiteDifferenceJacobian(f, y, _fun(t, y), _pattern, _colors, 0, _parallel);
+    size_t colors = 0;
+    for(auto c : _colors) { colors = std::max(colors, c + 1); }
+    stats.functionEvaluations += colors + 1;
+  }
+
+  /**
+   * Factorizes $$I - \gamma J$$ with the last evaluated jacobian
+   * @param gamma step width divided by the leading coefficient
+   * @param stats work counters
+   * @returns false if the matrix is singular
+   */
+  bool factorize(double gamma, BDFStatistics& stats) {
+    stats.factorizations++;
+    if(_storage == DENSE_ITERATION) {
+      size_t n = _J.rows();
+      auto M   = eye(n) - gamma * _J;
+      _lu      = LU(M);
+      for(size_t i = 0; i < n; ++i) {
+        if(_lu.first(i, i) == 0.0) return false;
+      }
+      return true;
+    }
+    if(_storage == BANDED_ITERATION) {
+      BandedMatrix<double> M(_sparseJ.rows(), _kl, _ku);
+      for(size_t i = 0; i < _sparseJ.rows(); ++i) {
+        for(size_t p = _sparseJ.indptr[i]; p < _sparseJ.indptr[i + 1]; ++p) {
+          M(i, _sparseJ.indices[p]) = -gamma * _sparseJ.values[p];
+        }
+        M(i, i) += 1.0;
+      }
+      return _bandedLU.factorize(M);
+    }
+    // the pattern of I - gamma J is constant, the symbolic analysis is done once
+    auto M = CSRMatrix<double>::Identity(_sparseJ.rows()) - gamma * _sparseJ;
+    if(_sparseLU) {
+      _sparseLU->factorize(M);
+    } else {
+      _sparseLU.emplace(M);
+    }
+    return _sparseLU->isRegular;
+  }
+
+  /**
+   * Solves $$(I - \gamma J) x = b$$ with the last factorization
+   * @param b right hand side (column vector)
+   * @returns x
+   */
+  [[nodiscard]] Matrix<double> solve(const Matrix<double>& b) const {
+    if(_storage == DENSE_ITERATION) return luSolve(_lu, b);
+    if(_storage == BANDED_ITERATION) return _bandedLU.solve(b);
+    return _sparseLU->solve(b);
+  }
+
+private:
+  //! ode
+  ODE _fun;
+  //! dense jacobian, nullptr for finite differences
+  ODEJac _Jac = nullptr;
+  //! banded or sparse jacobian, nullptr for finite differences
+  ODESparseJac _sparseJac = nullptr;
+  //! evaluate finite difference jacobians concurrently
+  bool _parallel = false;
+  //! storage of the iteration matrix
+  IterationStorage _storage = DENSE_ITERATION;
+  //! number of sub-diagonals
+  size_t _kl = 0;
+  //! number of super-diagonals
+  size_t _ku = 0;
+  //! sparsity pattern of banded and sparse jacobians
+  CSRMatrix<double> _pattern;
+  //! column coloring of the pattern
+  std::vector<size_t> _colors;
+  //! dense jacobian
+  Matrix<double> _J;
+  //! banded or sparse jacobian
+  CSRMatrix<double> _sparseJ;
+  //! dense LU factorization with pivots
+  std::pair<Matrix<double>, std::vector<unsigned int>> _lu;
+  //! banded LU factorization
+  BandedLU _bandedLU;
+  //! sparse LU factorization
+  std::optional<SparseLU> _sparseLU;
+};
+
+/**
+ * root mean square of v / (atol + rtol |y|)
+ */
+inline double weightedNorm(const Matrix<double>& v, const Matrix<double>& y, double rtol, double atol) {
+  double sum = 0;
+  for(size_t i = 0; i < v.rows(); ++i) {
+    double w = v(i, 0) / (atol + rtol * std::abs(y(i, 0)));
+    sum += w * w;
+  }
+  return v.rows() == 0 ? 0.0 : std::sqrt(sum / double(v.rows()));
+}
+
+/**
+ * Backward differences nabla^1 ... nabla^k (dif[0] ... dif[k - 1]) of step width h to step width rho h,
+ * see odeDifferenceRescaling()
+ */
+inline void rescale(std::vector<Matrix<double>>& dif, size_t k, double rho) {
+  if(rho == 1.0) return;
+  auto T = odeDifferenceRescaling(k, rho);
+  std::vector<Matrix<double>> out(k, zeros(dif[0].rows(), 1));
+  for(size_t i = 0; i < k; ++i) {
+    for(size_t j = 0; j < k; ++j) {
+      if(T(i, j) != 0.0) out[i] += T(i, j) * dif[j];
+    }
+  }
+  for(size_t i = 0; i < k; ++i) { dif[i] = out[i]; }
+}
+
+/**
+ * Variable order BDF integration, emit(t, y, iterations) is called with the start value, every
+ * output time (dense) or every accepted step and the Newton iterations of the step, y is a column
+ * vector. A terminal event ends the integration with an additional output at the event.
+ * @returns final time and value
+ */
+template<typename Output>
+std::pair<double, Matrix<double>> integrate(const ODE& fun, const std::vector<double>& tInterval,
+                                            const Matrix<double>& y0, const ODEOption& option, IterationMatrix& M,
+                                            BDFStatistics& stats, ODEEvents& events, Output&& emit) {
+  size_t n     = y0.columns();
+  double t     = tInterval.front();
+  double tEnd  = tInterval.back();
+  bool dense   = tInterval.size() > 2;
+  double rtol  = option.rtol;
+  double atol  = option.atol;
+  double eps   = std::numeric_limits<double>::epsilon();
+  auto F       = [&](double tk, const Matrix<double>& v) {
+    stats.functionEvaluations++;
+    return fun(tk, v);
+  };
+
+  auto y = y0.Transpose();
+  emit(t, y, 0);
+  events.start(t, &y(0, 0), n);
+  if(!(tEnd > t)) return { t, y }; // tEnd < t is mapped to forward integration by odeTimeReversal()
+  size_t nextOut = 1;
+
+  // initial step: one tolerance unit of change of y
+  auto f0  = F(t, y);
+  double h = std::abs(option.h);
+  if(h == 0) {
+    double r = weightedNorm(f0, y, rtol, atol);
+    h        = r > 0 ? std::min(tEnd - t, 1.0 / r) : tEnd - t;
+  }
+  h = std::min(h, tEnd - t);
+
+  // backward differences nabla^1 ... nabla^{k + 2}
+  std::vector<Matrix<double>> dif(maxOrder + 2, zeros(n, 1));
+  dif[0]        = h * f0;
+  size_t k      = 1;
+  size_t constH = 0;
+  M.evaluate(t, y, stats);
+  bool currentJ  = true;
+  double gammaLU = 0, rate = 0;
+  bool haveRate  = false;
+  // Newton iterations converge if the estimated error is below kappa tolerance units
+  const double kappa = 0.05;
+
+  bool last = false;
+  while(!last) {
+    int failures = 0, iterations = 0;
+    Matrix<double> yNew, difkp1;
+    double err = 0;
+    while(true) {
+      double hmin = 16 * eps * std::max(1.0, std::abs(t));
+      last        = 1.1 * h >= tEnd - t;
+      if(last) {
+        rescale(dif, k, (tEnd - t) / h);
+        h = tEnd - t;
+      }
+      double tNew = last ? tEnd : t + h;
+
+      // predictor and history term
+      auto yPred = y;
+      auto psi   = zeros(n, 1);
+      for(size_t j = 1; j <= k; ++j) {
+        yPred += dif[j - 1];
+        psi += G[j] * dif[j - 1];
+      }
+      psi *= 1.0 / G[k];
+      double gamma = h / G[k];
+
+      if(gammaLU == 0 || std::abs(gamma / gammaLU - 1) > 0.3) {
+        if(!M.factorize(gamma, stats)) {
+          std::cerr << "ODEBDF: singular iteration matrix at t = " << t << std::endl;
+          return { t, y };
+        }
+        gammaLU  = gamma;
+        haveRate = false;
+      }
+      double scaling = 2.0 / (1.0 + gamma / gammaLU);
+
+      // simplified Newton iteration on difkp1 = nabla^{k + 1} y_{n + 1}
+      yNew           = yPred;
+      difkp1         = zeros(n, 1);
+      bool converged = false;
+      double oldNorm = 0;
+      for(iterations = 1; iterations <= 4; ++iterations) {
+        auto rhs = gamma * F(tNew, yNew) - psi - difkp1;
+        auto del = scaling * M.solve(rhs);
+        difkp1 += del;
+        yNew += del;
+        stats.newtonIterations++;
+        double newNorm = weightedNorm(del, yNew, rtol, atol);
+        if(newNorm <= 100 * eps * weightedNorm(yNew, yNew, rtol, atol)) {
+          converged = true;
+          break;
+        }
+        if(iterations > 1) {
+          rate     = std::max(0.9 * rate, newNorm / oldNorm);
+          haveRate = true;
+        }
+        if(haveRate && rate < 1 && newNorm * rate / (1 - rate) <= kappa) {
+          converged = true;
+          break;
+        }
+        if(iterations > 1 && rate > 0.9) break;
+        oldNorm = newNorm;
+      }
+
+      if(!converged || std::isnan(weightedNorm(yNew, yNew, rtol, atol))) {
+        stats.newtonFailures++;
+        haveRate = false;
+        if(!currentJ) {
+          // retry with a fresh jacobian
+          M.evaluate(t, y, stats);
+          currentJ = true;
+          gammaLU  = 0;
+          continue;
+        }
+        if(h <= hmin) {
+          std::cerr << "ODEBDF: step width too small at t = " << t << std::endl;
+          return { t, y };
+        }
+        double hNew = std::max(hmin, 0.3 * h);
+        rescale(dif, k, hNew / h);
+        h      = hNew;
+        constH = 0;
+        continue;
+      }
+
+      // local error estimate nabla^{k + 1} y_{n + 1} / (k + 1)
+      err = weightedNorm(difkp1, yNew, rtol, atol) / double(k + 1);
+      if(err > 1.0) {
+        stats.rejected++;
+        if(h <= hmin) {
+          std::cerr << "ODEBDF: step width too small at t = " << t << std::endl;
+          return { t, y };
+        }
+        double hNew;
+        if(++failures == 1) {
+          hNew = h * std::max(0.1, 0.833 * std::pow(err, -1.0 / double(k + 1)));
+          if(k > 1) {
+            double errkm1 = weightedNorm(dif[k - 1] + difkp1, yNew, rtol, atol) / double(k);
+            double hkm1   = h * std::max(0.1, 0.769 * std::pow(errkm1, -1.0 / double(k)));
+            if(hkm1 > hNew) {
+              hNew = std::min(h, hkm1);
+              k--;
+            }
+          }
+        } else {
+          hNew = 0.5 * h;
+        }
+        hNew = std::max(hmin, hNew);
+        rescale(dif, k, hNew / h);
+        h      = hNew;
+        constH = 0;
+        continue;
+      }
+      break;
+    }
+
+    // update of the differences to the new point
+    dif[k + 1] = difkp1 - dif[k];
+    dif[k]     = difkp1;
+    for(size_t j = k; j-- > 0;) { dif[j] += dif[j + 1]; }
+    double tNew = last ? tEnd : t + h;
+    stats.steps++;
+
+    // interpolation polynomial through the last k + 1 values
+    double tStep     = tNew;
+    auto interpolate = [&](double ti) {
+      double s = (ti - tStep) / h, c = 1;
+      auto yi  = yNew;
+      for(size_t j = 1; j <= k; ++j) {
+        c *= (s + double(j) - 1) / double(j);
+        yi += c * dif[j - 1];
+      }
+      return yi;
+    };
+    bool stop = events.step(t, tNew, &yNew(0, 0), [&](double ti, double* out) {
+      auto yi = interpolate(ti);
+      std::copy(&yi(0, 0), &yi(0, 0) + n, out);
+    });
+    if(stop) tNew = events.stopTime;
+    if(dense) {
+      while(nextOut < tInterval.size() && tInterval[nextOut] <= tNew) {
+        bool final = ++nextOut == tInterval.size() && !stop;
+        emit(tInterval[nextOut - 1], final ? yNew : interpolate(tInterval[nextOut - 1]), iterations);
+      }
+    }
+    if(stop) std::copy(events.stopState.begin(), events.stopState.end(), &yNew(0, 0));
+    if(!dense || (stop && tInterval[nextOut - 1] != tNew)) emit(tNew, yNew, iterations);
+    t        = tNew;
+    y        = yNew;
+    currentJ = false;
+    if(last || stop) break;
+
+    // step width and order of the next step, only changed after k + 2 steps of constant h and k
+    if(++constH < k + 2) continue;
+    double temp = 1.2 * std::pow(err, 1.0 / double(k + 1));
+    double hopt = temp > 0.1 ? h / temp : 10 * h;
+    size_t kopt = k;
+    if(k > 1) {
+      double errkm1 = weightedNorm(dif[k - 1], y, rtol, atol) / double(k);
+      temp          = 1.3 * std::pow(errkm1, 1.0 / double(k));
+      double hkm1   = temp > 0.1 ? h / temp : 10 * h;
+      if(hkm1 > hopt) {
+        hopt = hkm1;
+        kopt = k - 1;
+      }
+    }
+    if(k < maxOrder) {
+      double errkp1 = weightedNorm(dif[k + 1], y, rtol, atol) / double(k + 2);
+      temp          = 1.4 * std::pow(errkp1, 1.0 / double(k + 2));
+      double hkp1   = temp > 0.1 ? h / temp : 10 * h;
+      if(hkp1 > hopt) {
+        hopt = hkp1;
+        kopt = k + 1;
+      }
+    }
+    if(hopt > h) {
+      hopt = std::min(hopt, tEnd - t);
+      k    = kopt;
+      rescale(dif, k, hopt / h);
+      h      = hopt;
+      constH = 0;
+    }
+  }
+  return { t, y };
+}
+
+/**
+ * Collects the output of a stiff integrator in an ODEResult, run(stats, emit) performs the
+ * integration with emit(t, y, iterations) as in integrate()
+ */
+template<typename Integrator>
+ODEResult collect(size_t dim, BDFStatistics* statistics, Integrator&& run) {
+  BDFStatistics stats;
+  // output, rows of yOut are stored contiguously
+  std::vector<double> tOut, yOut;
+  std::vector<int> iterOut;
+  run(stats, [&](double t, const Matrix<double>& y, int iterations) {
+    tOut.push_back(t);
+    yOut.insert(yOut.end(), &y(0, 0), &y(0, 0) + dim);
+    iterOut.push_back(iterations);
+  });
+  if(statistics) *statistics = stats;
+
+  Matrix<double> T(0, tOut.size(), 1);
+  Matrix<double> Y(0, tOut.size(), dim);
+  Matrix<int> iter(0, tOut.size(), 1);
+  for(size_t l = 0; l < tOut.size(); ++l) {
+    T(l, 0)    = tOut[l];
+    iter(l, 0) = iterOut[l];
+    for(size_t i = 0; i < dim; ++i) { Y(l, i) = yOut[l * dim + i]; }
+  }
+  return { Y, T, iter };
+}
+
+/**
+ * Variable order BDF integration collected in an ODEResult
+ */
+inline ODEResult solve(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                       const ODEOption& option, IterationMatrix& M, BDFStatistics* statistics) {
+  ODEEvents events(option.events);
+  auto result = collect(y0.columns(), statistics, [&](BDFStatistics& stats, auto&& emit) {
+    integrate(fun, tInterval, y0, option, M, stats, events, emit);
+  });
+  events.store(result);
+  return result;
+}
+} // namespace bdf
+
+/**
+ * Variable step, variable order BDF solver with dense iteration matrix
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, Jac (finite differences if not set), events and h
+ * as initial step width (0 chooses automatically)
+ * @param statistics work counters, optional
+ * @returns approximated values and Newton iterations per step
+ */
+inline ODEResult ODEBDF(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                        const ODEOption& option, BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, o.Jac, o.parallelJacobian);
+                           return bdf::solve(f, ti, y0, o, M, statistics);
+                         });
+}
+
+/**
+ * Variable step, variable order BDF solver with banded finite difference jacobian
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, SparseJac (finite differences if not set), events and
+ * h as initial step width
+ * @param kl number of sub-diagonals of the jacobian
+ * @param ku number of super-diagonals of the jacobian
+ * @param statistics work counters, optional
+ * @returns approximated values and Newton iterations per step
+ */
+inline ODEResult ODEBDF(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                        const ODEOption& option, size_t kl, size_t ku, BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, y0.columns(), kl, ku, o.SparseJac, o.parallelJacobian);
+                           return bdf::solve(f, ti, y0, o, M, statistics);
+                         });
+}
+
+/**
+ * Variable step, variable order BDF solver with sparse finite difference jacobian
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, SparseJac (finite differences if not set), events and
+ * h as initial step width
+ * @param pattern sparsity pattern of the jacobian, the values are ignored
+ * @param statistics work counters, optional
+ * @returns approximated values and Newton iterations per step
+ */
+inline ODEResult ODEBDF(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                        const ODEOption& option, const CSRMatrix<double>& pattern,
+                        BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, pattern, o.SparseJac, o.parallelJacobian);
+                           return bdf::solve(f, ti, y0, o, M, statistics);
+                         });
+}
+
+/**
+ * \example numerics/ode/TestODEBDF.cpp
+ * This is an example on how to use the variable order BDF solver.
+ */
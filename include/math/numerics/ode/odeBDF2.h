@@ -18,61 +18,107 @@
 #include <iostream>
 
 
+namespace bdf2 {
 /**
- * BDF(2) solver implementation
- * @param fun ode to approximate
- * @param tInterval interval to perform approximation on
- * @param y0 start value
- * @param option solver options
- * @returns approximated values
+ * BDF(2) method started by one trapezoid step, emit(t, y, iterations) is called with the start
+ * value and every step, y is a column vector
+ * @returns final time and value
  */
-ODEResult
-ODEBDF2(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+template<typename Output>
+std::pair<double, Matrix<double>> integrate(const ODE& fun, const std::vector<double>& tInterval,
+                                            const Matrix<double>& y0, const ODEOption& option, Output&& emit) {
   size_t tDim      = tInterval.size();
   size_t elem_size = y0.columns();
   auto h           = option.h;
   auto TOL         = option.TOL;
   auto maxIter     = option.maxIter;
-  auto Jac         = option.Jac;
+  auto Jac         = odeJacobian(fun, option.Jac, option.parallelJacobian);
   if(h == 0) { h = (tInterval[tDim - 1] - tInterval[0]) / 1000.0; }
+  size_t n = ((tInterval[tDim - 1] - tInterval[0]) / h) + 1;
 
-  //    % initialize result vectors
-  size_t result_dim = ((tInterval[tDim - 1] - tInterval[0]) / h) + 1;
-  Matrix<double> t(0, result_dim, 1, 1);
-  size_t n = result_dim;
-  auto y   = zeros(n, elem_size);
-  Matrix<int> iter(0, n, 1);
-
-  t(0, 0) = tInterval[0];
-  t(1, 0) = t(0, 0) + h;
+  double t    = tInterval[0];
+  auto y_prev = y0.Transpose();
+  emit(t, y_prev, 0);
+  if(n < 2) return { t, y_prev };
 
-  auto y1 = ODETrapez(fun, { t(0, 0), t(1, 0) }, y0, option).Y;
-  y.SetRow(0, y1(0));
-  y.SetRow(1, y1(1));
+  // second start value by the trapezoid rule with the same step width
+  ODEOption start = option;
+  start.h         = h;
+  auto y_cur      = trapez::integrate(fun, { t, t + h }, y0, start, [](double, const Matrix<double>&, int) {}).second;
+  t               = t + h;
+  emit(t, y_cur, 0);
   auto E = eye(elem_size);
 
   for(size_t l = 1; l < n - 1; l++) {
-    auto y_act = y(l - 1).Transpose();
+    auto y_act = y_prev;
     auto k     = 0;
     auto delta = ones(elem_size);
 
     while(norm(delta) > TOL && k < maxIter) {
-      auto current_fun = fun(t(l, 0) + h, y_act);
-      auto F =
-      -1.0 * ((-1.0 / 2.0) * y(l - 1).Transpose() + h * current_fun + 2.0 * y(l).Transpose() - 3.0 / 2.0 * y_act);
-      auto J = h * Jac(t(l, 0), y_act) - (3.0 / 2.0) * E;
-      delta  = gaussSeidel(J, F);
+      auto current_fun = fun(t + h, y_act);
+      auto F           = -1.0 * ((-1.0 / 2.0) * y_prev + h * current_fun + 2.0 * y_cur - 3.0 / 2.0 * y_act);
+      auto J           = h * Jac(t, y_act) - (3.0 / 2.0) * E;
+      delta            = gaussSeidel(J, F);
       y_act += delta;
       k += 1;
     }
     if(k >= maxIter) { std::cout << "Warning: Max number iterations reached." << std::endl; }
-    iter(l, 0)  = k;
-    t(l + 1, 0) = t(l, 0) + h;
-    y.SetRow(l + 1, y_act);
+    t      = t + h;
+    y_prev = y_cur;
+    y_cur  = y_act;
+    emit(t, y_cur, k);
   }
+  return { t, y_cur };
+}
+} // namespace bdf2
+
+/**
+ * BDF(2) solver implementation
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options
+ * @returns approximated values
+ */
+ODEResult
+ODEBDF2(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+  size_t tDim      = tInterval.size();
+  size_t elem_size = y0.columns();
+  auto h           = option.h;
+  if(h == 0) { h = (tInterval[tDim - 1] - tInterval[0]) / 1000.0; }
+
+  //    % initialize result vectors
+  size_t result_dim = ((tInterval[tDim - 1] - tInterval[0]) / h) + 1;
+  Matrix<double> t(0, result_dim, 1, 1);
+  size_t n = result_dim;
+  auto y   = zeros(n, elem_size);
+  Matrix<int> iter(0, n, 1);
+
+  size_t l = 0;
+  bdf2::integrate(fun, tInterval, y0, option, [&](double tl, const Matrix<double>& yl, int k) {
+    t(l, 0)    = tl;
+    iter(l, 0) = k;
+    y.SetRow(l++, yl);
+  });
   return { y, t, iter };
 }
 
+/**
+ * BDF(2) solver streaming every step to an observer
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODEBDF2(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                  const ODEOption& option, const ODEObserver& observer) {
+  auto [t, y] = bdf2::integrate(fun, tInterval, y0, option,
+                                [&observer](double tl, const Matrix<double>& yl, int) { observer(tl, &yl(0, 0)); });
+  return odeFinalState(t, &y(0, 0), y.rows());
+}
+
 /**
  * \example numerics/ode/TestODEBDF2.cpp
  * This is an example on how to use ODEBDF2.
@@ -0,0 +1,113 @@
+/**
+ * @file odeExponential.h
+ *
+ * Exponential integrators, the stiff linear part of the ode is propagated exactly by matrix
+ * exponentials, hence the step width is only limited by the accuracy of the nonlinear part.
+ *
+ * - ODEETD(): semilinear odes $$y' = Ay + N(t, y)$$ by the exponential time differencing scheme
+ *   ETDRK2 of Cox and Matthews. The phi-functions of hA are computed once for all steps, linear
+ *   problems (N = nullptr) are solved exactly.
+ * - ODEExpRosenbrock(): general odes by the exponential Rosenbrock-Euler method
+ *   $$y_{k+1} = y_k + h \varphi_1(h J_k) f(t_k, y_k)$$
+ *   with the jacobian J_k of f (second order, exact for linear autonomous odes).
+ *
+ * Usage:
+ * \code
+ * auto res = ODEETD(A, N, { 0, 10 }, y0, { 0.1 });
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/odeExponential.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../lin_alg/expm.h"
+#include "../utils.h"
+#include "ode.h"
+
+/**
+ * Exponential time differencing (ETDRK2) for semilinear odes $$y' = Ay + N(t, y)$$
+ * @param A linear part
+ * @param N nonlinear part, nullptr for linear odes
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options, only h is used
+ * @returns approximated values
+ */
+inline ODEResult ODEETD(const Matrix<double>& A, const ODE& N, const std::vector<double>& tInterval,
+                        const Matrix<double>& y0, const ODEOption& option) {
+  size_t dim       = tInterval.size();
+  size_t elem_size = y0.columns();
+  auto h           = option.h;
+  if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000.0; }
+  int n = int((tInterval[dim - 1] - tInterval[0]) / h) + 1;
+
+  auto t = Matrix<double>(0, n, 1, 1);
+  auto y = zeros(n, elem_size);
+
+  t(0, 0) = tInterval[0];
+  y.SetRow(0, y0);
+  auto phis = phi(A * h, N ? 2 : 0);
+
+  for(int i = 1; i < n; ++i) {
+    auto y_act = y(i - 1).Transpose();
+    t(i, 0)    = t(i - 1, 0) + h;
+    auto next  = phis[0] * y_act;
+    if(N) {
+      auto N0 = N(t(i - 1, 0), y_act);
+      auto a  = next + h * (phis[1] * N0);
+      next    = a + h * (phis[2] * (N(t(i, 0), a) - N0));
+    }
+    y.SetRow(i, next);
+  }
+  return { y, t };
+}
+
+/**
+ * Exponential Rosenbrock-Euler method
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options, uses h and Jac (finite differences if not set)
+ * @returns approximated values
+ */
+inline ODEResult ODEExpRosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                                  const ODEOption& option) {
+  size_t dim       = tInterval.size();
+  size_t elem_size = y0.columns();
+  auto h           = option.h;
+  auto Jac         = odeJacobian(fun, option.Jac, option.parallelJacobian);
+  if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000.0; }
+  int n = int((tInterval[dim - 1] - tInterval[0]) / h) + 1;
+
+  auto t = Matrix<double>(0, n, 1, 1);
+  auto y = zeros(n, elem_size);
+
+  t(0, 0) = tInterval[0];
+  y.SetRow(0, y0);
+
+  for(int i = 1; i < n; ++i) {
+    auto y_act = y(i - 1).Transpose();
+    t(i, 0)    = t(i - 1, 0) + h;
+    auto f     = fun(t(i - 1, 0), y_act);
+    auto J     = Jac(t(i - 1, 0), y_act);
+
+    // h phi_1(hJ) f is the last column of exp([[hJ, hf], [0, 0]])
+    Matrix<double> M(0, elem_size + 1, elem_size + 1);
+    for(size_t r = 0; r < elem_size; ++r) {
+      for(size_t c = 0; c < elem_size; ++c) { M(r, c) = h * J(r, c); }
+      M(r, elem_size) = h * f(r, 0);
+    }
+    auto E = expm(M);
+    for(size_t r = 0; r < elem_size; ++r) { y_act(r, 0) += E(r, elem_size); }
+    y.SetRow(i, y_act);
+  }
+  return { y, t };
+}
+
+/**
+ * \example numerics/ode/TestODEExponential.cpp
+ * This is an example on how to use the exponential integrators.
+ */
@@ -0,0 +1,246 @@
+/**
+ * @file odeRosenbrock.h
+ *
+ * Rosenbrock (linearly implicit Runge-Kutta) method for moderately stiff odes, the 4th order
+ * A-stable scheme of Shampine ("Implementation of Rosenbrock methods", 1982) with embedded 3rd
+ * order error estimate:
+ * $$(I - \gamma h J) g_i = \gamma h \left(f(t + \alpha_i h, y + \sum_j a_{ij} g_j)
+ *   + \frac{1}{h}\sum_j c_{ij} g_j + \gamma_i h f_t\right)$$
+ *
+ * Every step needs exactly one jacobian, one LU factorization (shared by the four stage solves)
+ * and three evaluations of f plus one for the time derivative $$f_t$$, there is no Newton
+ * iteration. Rejected steps reuse the jacobian and only refactorize. The iteration matrix is
+ * dense, banded or sparse as for ODEBDF(). Output times in between steps are interpolated by
+ * cubic Hermite polynomials. Decreasing times integrate backwards (see odeTimeReversal()).
+ *
+ * Usage:
+ * \code
+ * BDFStatistics stats;
+ * auto res = ODERosenbrock(fun, { 0, 10 }, y0, option, &stats); // stats.jacobians == stats.steps
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/ode/odeRosenbrock.h>
+ * \endcode
+ */
+#pragma once
+
+#include "odeBDF.h"
+
+namespace rosenbrock {
+//! diagonal coefficient
+const double diagonal = 1.0 / 2.0;
+//! stage coefficients of y
+const double a21 = 2.0, a31 = 48.0 / 25.0, a32 = 6.0 / 25.0;
+//! stage coefficients of the previous increments
+const double c21 = -8.0, c31 = 372.0 / 25.0, c32 = 12.0 / 5.0;
+const double c41 = -112.0 / 125.0, c42 = -54.0 / 125.0, c43 = -2.0 / 5.0;
+//! weights
+const double b[4] = { 19.0 / 9.0, 1.0 / 2.0, 25.0 / 108.0, 125.0 / 108.0 };
+//! difference of the 4th and 3rd order weights
+const double e[4] = { 17.0 / 54.0, 7.0 / 36.0, 0.0, 125.0 / 108.0 };
+//! coefficients of the time derivative
+const double cx[4] = { 1.0 / 2.0, -3.0 / 2.0, 121.0 / 50.0, 29.0 / 250.0 };
+//! nodes of the stages 2 and 3 (stage 4 reuses f of stage 3)
+const double alpha2 = 1.0, alpha3 = 3.0 / 5.0;
+
+/**
+ * Adaptive Rosenbrock integration, emit(t, y, rejected) is called with the start value, every
+ * output time (dense) or every accepted step and the number of rejected steps, y is a column vector.
+ * A terminal event ends the integration with an additional output at the event.
+ * @returns final time and value
+ */
+template<typename Output>
+std::pair<double, Matrix<double>> integrate(const ODE& fun, const std::vector<double>& tInterval,
+                                            const Matrix<double>& y0, const ODEOption& option,
+                                            bdf::IterationMatrix& M, BDFStatistics& stats, ODEEvents& events,
+                                            Output&& emit) {
+  size_t n    = y0.columns();
+  double t    = tInterval.front();
+  double tEnd = tInterval.back();
+  bool dense  = tInterval.size() > 2;
+  double rtol = option.rtol;
+  double atol = option.atol;
+  double eps  = std::numeric_limits<double>::epsilon();
+  auto F      = [&](double tk, const Matrix<double>& v) {
+    stats.functionEvaluations++;
+    return fun(tk, v);
+  };
+
+  auto y = y0.Transpose();
+  emit(t, y, 0);
+  events.start(t, &y(0, 0), n);
+  if(!(tEnd > t)) return { t, y }; // tEnd < t is mapped to forward integration by odeTimeReversal()
+  size_t nextOut = 1;
+
+  auto f   = F(t, y);
+  double h = std::abs(option.h);
+  if(h == 0) {
+    // change of one tolerance unit in the first step
+    double r = bdf::weightedNorm(f, y, rtol, atol);
+    h        = r > 0 ? std::min(tEnd - t, 1.0 / r) : tEnd - t;
+  }
+
+  bool currentJ = false;
+  int rejected  = 0;
+  while(t < tEnd) {
+    if(h < 16 * eps * std::max(1.0, std::abs(t))) {
+      std::cerr << "ODERosenbrock: step width too small at t = " << t << std::endl;
+      break;
+    }
+    bool last = h >= tEnd - t;
+    if(last) h = tEnd - t;
+
+    // one jacobian per step, rejected steps only refactorize
+    if(!currentJ) M.evaluate(t, y, stats);
+    currentJ = true;
+    if(!M.factorize(diagonal * h, stats)) {
+      std::cerr << "ODERosenbrock: singular iteration matrix at t = " << t << std::endl;
+      break;
+    }
+    double delta = std::sqrt(eps) * std::max(1.0, std::abs(t));
+    auto ft      = (1.0 / delta) * (F(t + delta, y) - f);
+
+    // stages (I - diagonal h J) g = diagonal h rhs
+    double gh = diagonal * h;
+    auto g1   = M.solve(gh * (f + (h * cx[0]) * ft));
+    auto f2   = F(t + alpha2 * h, y + a21 * g1);
+    auto g2   = M.solve(gh * (f2 + (h * cx[1]) * ft + (c21 / h) * g1));
+    auto f3   = F(t + alpha3 * h, y + a31 * g1 + a32 * g2);
+    auto g3   = M.solve(gh * (f3 + (h * cx[2]) * ft + (1.0 / h) * (c31 * g1 + c32 * g2)));
+    auto g4   = M.solve(gh * (f3 + (h * cx[3]) * ft + (1.0 / h) * (c41 * g1 + c42 * g2 + c43 * g3)));
+    auto yNew = y + b[0] * g1 + b[1] * g2 + b[2] * g3 + b[3] * g4;
+    auto err  = e[0] * g1 + e[1] * g2 + e[3] * g4;
+
+    double error = 0;
+    for(size_t i = 0; i < n; ++i) {
+      double sk = atol + rtol * std::max(std::abs(y(i, 0)), std::abs(yNew(i, 0)));
+      error += (err(i, 0) / sk) * (err(i, 0) / sk);
+    }
+    error = std::sqrt(error / double(n));
+    if(error > 1.0 || std::isnan(error)) {
+      h *= std::isnan(error) ? 0.1 : std::max(0.2, 0.9 * std::pow(error, -1.0 / 3.0));
+      stats.rejected++;
+      rejected++;
+      continue;
+    }
+
+    double tNew = last ? tEnd : t + h;
+    auto fNew   = F(tNew, yNew);
+    // cubic Hermite interpolation with the derivatives at both ends
+    auto interpolate = [&](double ti) {
+      double s  = (ti - t) / h;
+      double h0 = (1 + 2 * s) * (1 - s) * (1 - s), h1 = s * (1 - s) * (1 - s) * h;
+      double h2 = s * s * (3 - 2 * s), h3 = s * s * (s - 1) * h;
+      return h0 * y + h1 * f + h2 * yNew + h3 * fNew;
+    };
+    bool stop = events.step(t, tNew, &yNew(0, 0), [&](double ti, double* out) {
+      auto yi = interpolate(ti);
+      std::copy(&yi(0, 0), &yi(0, 0) + n, out);
+    });
+    if(stop) tNew = events.stopTime;
+    if(dense) {
+      while(nextOut < tInterval.size() && tInterval[nextOut] <= tNew) {
+        bool final = ++nextOut == tInterval.size() && !stop;
+        emit(tInterval[nextOut - 1], final ? yNew : interpolate(tInterval[nextOut - 1]), rejected);
+        rejected = 0;
+      }
+    }
+    if(stop) std::copy(events.stopState.begin(), events.stopState.end(), &yNew(0, 0));
+    if(!dense || (stop && tInterval[nextOut - 1] != tNew)) {
+      emit(tNew, yNew, rejected);
+      rejected = 0;
+    }
+    t        = tNew;
+    y        = yNew;
+    f        = fNew;
+    currentJ = false;
+    stats.steps++;
+    if(stop) break;
+    h *= std::min(4.0, 0.9 * std::pow(std::max(error, 1e-10), -0.25));
+  }
+  return { t, y };
+}
+} // namespace rosenbrock
+
+/**
+ * Adaptive Rosenbrock solver with dense iteration matrix
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, Jac (finite differences if not set), events and h
+ * as initial step width (0 chooses automatically)
+ * @param statistics work counters, optional
+ * @returns approximated values and rejected steps per step
+ */
+inline ODEResult ODERosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                               const ODEOption& option, BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, o.Jac, o.parallelJacobian);
+                           ODEEvents events(o.events);
+                           auto result = bdf::collect(y0.columns(), statistics, [&](BDFStatistics& stats, auto&& emit) {
+                             rosenbrock::integrate(f, ti, y0, o, M, stats, events, emit);
+                           });
+                           events.store(result);
+                           return result;
+                         });
+}
+
+/**
+ * Adaptive Rosenbrock solver with banded finite difference jacobian
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, SparseJac (finite differences if not set), events and
+ * h as initial step width
+ * @param kl number of sub-diagonals of the jacobian
+ * @param ku number of super-diagonals of the jacobian
+ * @param statistics work counters, optional
+ * @returns approximated values and rejected steps per step
+ */
+inline ODEResult ODERosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                               const ODEOption& option, size_t kl, size_t ku, BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, y0.columns(), kl, ku, o.SparseJac, o.parallelJacobian);
+                           ODEEvents events(o.events);
+                           auto result = bdf::collect(y0.columns(), statistics, [&](BDFStatistics& stats, auto&& emit) {
+                             rosenbrock::integrate(f, ti, y0, o, M, stats, events, emit);
+                           });
+                           events.store(result);
+                           return result;
+                         });
+}
+
+/**
+ * Adaptive Rosenbrock solver with sparse finite difference jacobian
+ * @param fun ode to approximate, called with column vectors
+ * @param tInterval interval to perform approximation on, or all output times (decreasing to integrate backwards)
+ * @param y0 start value (row vector)
+ * @param option solver options, uses rtol, atol, SparseJac (finite differences if not set), events and
+ * h as initial step width
+ * @param pattern sparsity pattern of the jacobian, the values are ignored
+ * @param statistics work counters, optional
+ * @returns approximated values and rejected steps per step
+ */
+inline ODEResult ODERosenbrock(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                               const ODEOption& option, const CSRMatrix<double>& pattern,
+                               BDFStatistics* statistics = nullptr) {
+  return odeTimeReversal(fun, y0.columns(), tInterval, option,
+                         [&](const ODE& f, const std::vector<double>& ti, const ODEOption& o, double) {
+                           bdf::IterationMatrix M(f, pattern, o.SparseJac, o.parallelJacobian);
+                           ODEEvents events(o.events);
+                           auto result = bdf::collect(y0.columns(), statistics, [&](BDFStatistics& stats, auto&& emit) {
+                             rosenbrock::integrate(f, ti, y0, o, M, stats, events, emit);
+                           });
+                           events.store(result);
+                           return result;
+                         });
+}
+
+/**
+ * \example numerics/ode/TestODERosenbrock.cpp
+ * This is an example on how to use the Rosenbrock solver.
+ */
@@ -16,44 +16,41 @@
 #include "ode.h"
 #include <iostream>
 
+namespace trapez {
 /**
- * Implements trapezoid method to solve odes
- * @param fun ode to approximate
- * @param tInterval interval to perform approximation on
- * @param y0 start value
- * @param option solver options
- * @returns approximated values
+ * Trapezoid method, emit(t, y, iterations) is called with the start value and every step, y is a
+ * column vector
+ * @returns final time and value
  */
-ODEResult
-ODETrapez(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+template<typename Output>
+std::pair<double, Matrix<double>> integrate(const ODE& fun, const std::vector<double>& tInterval,
+                                            const Matrix<double>& y0, const ODEOption& option, Output&& emit) {
   size_t dim       = tInterval.size();
   size_t elem_size = y0.columns();
   auto h           = option.h;
   auto TOL         = option.TOL;
   auto maxIter     = option.maxIter;
-  auto Jac         = option.Jac;
+  auto Jac         = odeJacobian(fun, option.Jac, option.parallelJacobian);
   if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000.0; }
   int n = int((tInterval[dim - 1] - tInterval[0]) / h) + 1;
 
-  auto t    = Matrix<double>(0, n, 1, 1);
-  auto iter = Matrix<int>(0, n, 1);
-  auto y    = zeros(n, elem_size);
-
-  t(0, 0) = tInterval[0];
-  y.SetRow(0, y0);
+  double t   = tInterval[0];
+  auto y_act = y0.Transpose();
+  emit(t, y_act, 0);
   auto E = eye(elem_size);
 
   for(int i = 1; i < n; ++i) {
-    auto y_act    = y(i - 1).Transpose();
-    t(i, 0)       = t(i - 1, 0) + h;
+    auto y_prev   = y_act;
+    double t_prev = t;
+    t             = t + h;
     int k         = 0;
     auto delta    = ones(elem_size);
-    auto prev_fun = fun(t(i - 1, 0), y_act);
+    auto prev_fun = fun(t_prev, y_act);
 
     while(norm(delta) > TOL && k < maxIter) {
-      auto current_fun = fun(t(i, 0), y_act);
-      auto F           = -1.0 * (y(i - 1).Transpose() + h / 2 * (prev_fun + current_fun) - y_act);
-      auto J           = h / 2 * Jac(t(i, 0), y_act) - E;
+      auto current_fun = fun(t, y_act);
+      auto F           = -1.0 * (y_prev + h / 2 * (prev_fun + current_fun) - y_act);
+      auto J           = h / 2 * Jac(t, y_act) - E;
 
       delta = gaussSeidel(J, F);
       y_act += delta;
@@ -62,12 +59,57 @@ ODETrapez(const ODE& fun, const std::vector<double>& tInterval, const Matrix<dou
     if(k == maxIter) {
       // err max iteration reached, did not convert.
     }
-    iter(i, 0) = k;
-    y.SetRow(i, y_act);
+    emit(t, y_act, k);
   }
+  return { t, y_act };
+}
+} // namespace trapez
+
+/**
+ * Implements trapezoid method to solve odes
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options
+ * @returns approximated values
+ */
+ODEResult
+ODETrapez(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0, const ODEOption& option) {
+  size_t dim       = tInterval.size();
+  size_t elem_size = y0.columns();
+  auto h           = option.h;
+  if(h == 0) { h = (tInterval[dim - 1] - tInterval[0]) / 1000.0; }
+  int n = int((tInterval[dim - 1] - tInterval[0]) / h) + 1;
+
+  auto t    = Matrix<double>(0, n, 1, 1);
+  auto iter = Matrix<int>(0, n, 1);
+  auto y    = zeros(n, elem_size);
+
+  int i = 0;
+  trapez::integrate(fun, tInterval, y0, option, [&](double ti, const Matrix<double>& yi, int k) {
+    t(i, 0)    = ti;
+    iter(i, 0) = k;
+    y.SetRow(i++, yi);
+  });
   return { y, t, iter };
 }
 
+/**
+ * Implements trapezoid method to solve odes, streaming every step to an observer
+ * @param fun ode to approximate
+ * @param tInterval interval to perform approximation on
+ * @param y0 start value
+ * @param option solver options
+ * @param observer called with t and y of every step, including the start value
+ * @returns final time and value
+ */
+ODEResult ODETrapez(const ODE& fun, const std::vector<double>& tInterval, const Matrix<double>& y0,
+                    const ODEOption& option, const ODEObserver& observer) {
+  auto [t, y] = trapez::integrate(fun, tInterval, y0, option,
+                                  [&observer](double ti, const Matrix<double>& yi, int) { observer(ti, &yi(0, 0)); });
+  return odeFinalState(t, &y(0, 0), y.rows());
+}
+
 /**
  * \example numerics/ode/TestODETrapez.cpp
  * This is an example on how to use ODETrapez.
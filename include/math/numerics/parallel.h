@@ -0,0 +1,66 @@
+/**
+ * @file parallel.h
+ *
+ * Minimal thread-based loop parallelization used by the numerical kernels.
+ *
+ * Usage:
+ * \code
+ * parallelFor(0, n, [&](size_t begin, size_t end) {
+ *   for(size_t i = begin; i < end; ++i) { y[i] = 2 * x[i]; }
+ * });
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/parallel.h>
+ * \endcode
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/**
+ * Number of threads used by parallelFor().
+ *
+ * Defaults to the hardware concurrency, set to 1 to disable threading.
+ * @returns reference to the global thread count
+ */
+inline size_t& parallelThreads() {
+  static size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  return threads;
+}
+
+/**
+ * Splits the range [begin, end) into contiguous chunks and processes them concurrently.
+ *
+ * The calling thread processes the first chunk. Ranges smaller than 2 * minChunk run sequentially.
+ *
+ * @param begin first index
+ * @param end index behind the last element
+ * @param body callback processing the sub range [chunkBegin, chunkEnd)
+ * @param minChunk minimal number of indices per thread
+ */
+inline void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t minChunk = 1024) {
+  if(end <= begin) return;
+  size_t n       = end - begin;
+  size_t threads = std::min(parallelThreads(), n / std::max<size_t>(minChunk, 1));
+  if(threads <= 1) {
+    body(begin, end);
+    return;
+  }
+
+  size_t chunk = (n + threads - 1) / threads;
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for(size_t t = 1; t < threads; ++t) {
+    size_t b = begin + t * chunk;
+    size_t e = std::min(end, b + chunk);
+    if(b < e) workers.emplace_back(body, b, e);
+  }
+  body(begin, std::min(end, begin + chunk));
+  for(auto& worker : workers) { worker.join(); }
+}
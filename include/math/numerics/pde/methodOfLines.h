@@ -0,0 +1,488 @@
+/**
+ * @file methodOfLines.h
+ *
+ * Method of lines for diffusion-reaction-advection equations on structured 1D and 2D grids
+ * $$\partial_t u_c = \sum_{terms} a \, \partial^{order}_{axis} u_c + r_c(t, x, u)$$
+ * with m components u_c per grid node. The spatial derivatives are replaced by the difference
+ * stencils of analysis/Differentiation.h, which turns the pde into the ode system
+ * $$u' = L u + b + R(t, u)$$
+ * with the sparse matrix L and the constant vector b of the boundary conditions. The unknowns of a
+ * node are stored contiguously, the nodes row by row, so 1D grids yield banded jacobians.
+ *
+ * - The right hand side is evaluated in place without allocations.
+ * - The jacobian L + R'(u) has the same sparsity pattern for every state (pattern()), the reaction
+ *   only adds the m x m blocks of the nodes. It is ready for the banded and sparse iteration
+ *   matrices of ODEBDF() and ODERosenbrock() via ODEOption::SparseJac.
+ * - Boundary conditions per side: Dirichlet (the boundary nodes keep their value), Neumann (given
+ *   outward normal derivative) and periodic. Stencils reaching outside the grid use ghost values
+ *   mirrored at the boundary node, odd for Dirichlet and even for Neumann conditions.
+ *
+ * Usage:
+ * \code
+ * MethodOfLines mol(PDEGrid(0, 1, 1001), 2);
+ * mol.addDiffusion(0, 1e-3);
+ * mol.addDiffusion(1, 1e-3);
+ * mol.setReaction([](double, const double*, const double* u, double* r) { r[0] = ...; r[1] = ...; });
+ *
+ * ODEOption option;
+ * option.SparseJac = mol.sparseJacobian();
+ * auto [kl, ku]    = mol.bandwidth();
+ * auto res         = ODEBDF(mol.ode(), { 0, 10 }, mol.initialValue(u0), option, kl, ku);
+ * \endcode
+ *
+ * Requires:
+ * \code
+ * #include <math/numerics/pde/methodOfLines.h>
+ * \endcode
+ */
+#pragma once
+
+#include "../analysis/Differentiation.h"
+#include "../lin_alg/SparseMatrix.h"
+#include "../ode/ode.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * Type of a boundary condition
+ */
+enum BoundaryType {
+  //! fixed value of u
+  DIRICHLET_BOUNDARY = 0,
+  //! fixed outward normal derivative of u
+  NEUMANN_BOUNDARY = 1,
+  //! the grid is continued on the opposite side, both sides of the axis have to be periodic
+  PERIODIC_BOUNDARY = 2
+};
+
+/**
+ * Boundary condition of one side of the grid, applies to all components
+ */
+struct PDEBoundary {
+  //! type of the condition
+  BoundaryType type = DIRICHLET_BOUNDARY;
+  //! value of u (Dirichlet) or of the outward normal derivative (Neumann)
+  double value = 0;
+};
+
+/**
+ * Equidistant grid of nx x ny nodes, ny = 1 for 1D grids
+ */
+struct PDEGrid {
+  //! number of nodes in x direction
+  size_t nx = 1;
+  //! number of nodes in y direction
+  size_t ny = 1;
+  //! x coordinate of the first node
+  double x0 = 0;
+  //! y coordinate of the first node
+  double y0 = 0;
+  //! node distance in x direction
+  double dx = 1;
+  //! node distance in y direction
+  double dy = 1;
+
+  /**
+   * 1D grid with nodes a, ..., b, a periodic grid continues with a after b + dx
+   * @param a first node
+   * @param b last node
+   * @param n number of nodes
+   */
+  PDEGrid(double a, double b, size_t n)
+    : nx(n)
+    , x0(a)
+    , dx((b - a) / double(n - 1)) {
+    assert(n > 1 && b > a);
+  }
+
+  /**
+   * 2D grid [ax, bx] x [ay, by]
+   * @param ax first node in x direction
+   * @param bx last node in x direction
+   * @param _nx number of nodes in x direction
+   * @param ay first node in y direction
+   * @param by last node in y direction
+   * @param _ny number of nodes in y direction
+   */
+  PDEGrid(double ax, double bx, size_t _nx, double ay, double by, size_t _ny)
+    : nx(_nx)
+    , ny(_ny)
+    , x0(ax)
+    , y0(ay)
+    , dx((bx - ax) / double(_nx - 1))
+    , dy((by - ay) / double(_ny - 1)) {
+    assert(_nx > 1 && _ny > 1 && bx > ax && by > ay);
+  }
+
+  /**
+   * @returns number of nodes
+   */
+  [[nodiscard]] size_t nodes() const { return nx * ny; }
+};
+
+/**
+ * Semi-discretization of a pde by the method of lines
+ */
+class MethodOfLines
+{
+public:
+  //! reaction r(t, x, u, r), x are the coordinates of the node, u and r hold the components of the node
+  using Reaction = std::function<void(double, const double*, const double*, double*)>;
+  //! jacobian J(t, x, u, J) of the reaction with respect to u, components x components row-major
+  using ReactionJacobian = std::function<void(double, const double*, const double*, double*)>;
+
+  /**
+   * Creates the discretization without terms and homogeneous Dirichlet conditions
+   * @param grid grid
+   * @param components number of components per node
+   */
+  explicit MethodOfLines(const PDEGrid& grid, size_t components = 1)
+    : _grid(grid)
+    , _components(components) {
+    assert(components > 0);
+    _assemble();
+  }
+
+  /**
+   * Sets the boundary conditions of an axis
+   * @param axis 0 for x, 1 for y
+   * @param lower condition at the first node
+   * @param upper condition at the last node
+   */
+  void setBoundary(size_t axis, const PDEBoundary& lower, const PDEBoundary& upper) {
+    assert(axis < dimension());
+    assert((lower.type == PERIODIC_BOUNDARY) == (upper.type == PERIODIC_BOUNDARY));
+    _boundaries[2 * axis]     = lower;
+    _boundaries[2 * axis + 1] = upper;
+    _assemble();
+  }
+
+  /**
+   * Adds the term coefficient * d^order u_component / d axis^order
+   * @param component component of u
+   * @param axis 0 for x, 1 for y
+   * @param stencil difference quotient, e.g. centralStencil()
+   * @param coefficient constant factor
+   */
+  void addTerm(size_t component, size_t axis, const DifferenceStencil& stencil, double coefficient) {
+    assert(component < _components && axis < dimension());
+    _terms.push_back({ component, axis, stencil, coefficient });
+    _assemble();
+  }
+
+  /**
+   * Adds the diffusion coefficient * Laplace u_component by secondStencil() in every direction
+   * @param component component of u
+   * @param coefficient diffusion coefficient
+   */
+  void addDiffusion(size_t component, double coefficient) {
+    assert(component < _components);
+    for(size_t axis = 0; axis < dimension(); ++axis) { _terms.push_back({ component, axis, secondStencil(), coefficient }); }
+    _assemble();
+  }
+
+  /**
+   * Sets the local reaction term
+   * @param reaction reaction r(t, x, u, r)
+   * @param jacobian jacobian of the reaction, nullptr for finite differences
+   */
+  void setReaction(const Reaction& reaction, const ReactionJacobian& jacobian = nullptr) {
+    _reaction         = reaction;
+    _reactionJacobian = jacobian;
+    _assemble();
+  }
+
+  /**
+   * @returns spatial dimension of the grid
+   */
+  [[nodiscard]] size_t dimension() const { return _grid.ny > 1 ? 2 : 1; }
+
+  /**
+   * @returns dimension of the ode system
+   */
+  [[nodiscard]] size_t unknowns() const { return _grid.nodes() * _components; }
+
+  /**
+   * @param i node index in x direction
+   * @param j node index in y direction
+   * @param component component of u
+   * @returns index of the unknown in the state vector
+   */
+  [[nodiscard]] size_t index(size_t i, size_t j, size_t component) const {
+    return (j * _grid.nx + i) * _components + component;
+  }
+
+  /**
+   * Samples an initial value, nodes with Dirichlet conditions take the boundary value
+   * @param u0 u0(x, u) writes the components of the node with coordinates x into u
+   * @returns start value (row vector)
+   */
+  [[nodiscard]] Matrix<double> initialValue(const std::function<void(const double*, double*)>& u0) const {
+    Matrix<double> out(0, 1, unknowns());
+    for(size_t p = 0; p < _grid.nodes(); ++p) {
+      double x[2];
+      _coordinates(p, x);
+      u0(x, &out(0, p * _components));
+      if(_dirichlet[p] >= 0) {
+        for(size_t c = 0; c < _components; ++c) { out(0, p * _components + c) = _dirichletValue[p]; }
+      }
+    }
+    return out;
+  }
+
+  /**
+   * Evaluates the semi-discrete right hand side, does not allocate
+   * @param t time
+   * @param u state
+   * @param dudt derivative of the state
+   */
+  void operator()(double t, const double* u, double* dudt) const {
+    size_t m = _components;
+    for(size_t p = 0; p < _grid.nodes(); ++p) {
+      double* out = dudt + p * m;
+      if(_reaction && _dirichlet[p] < 0) {
+        double x[2];
+        _coordinates(p, x);
+        _reaction(t, x, u + p * m, out);
+      } else {
+        std::fill(out, out + m, 0.0);
+      }
+      for(size_t r = p * m; r < (p + 1) * m; ++r) {
+        double v = _offset[r];
+        for(size_t k = _L.indptr[r]; k < _L.indptr[r + 1]; ++k) { v += _L.values[k] * u[_L.indices[k]]; }
+        dudt[r] += v;
+      }
+    }
+  }
+
+  /**
+   * @returns right hand side for the explicit solvers (copies the discretization)
+   */
+  [[nodiscard]] ODEInPlace rhs() const {
+    return [self = *this](double t, const double* u, double* dudt) { self(t, u, dudt); };
+  }
+
+  /**
+   * @returns right hand side for the implicit solvers (copies the discretization), keeps the shape of y
+   */
+  [[nodiscard]] ODE ode() const {
+    return [self = *this](double t, const Matrix<double>& y) {
+      Matrix<double> out(0, y.rows(), y.columns());
+      self(t, &y(0, 0), &out(0, 0));
+      return out;
+    };
+  }
+
+  /**
+   * @returns sparsity pattern of the jacobian, contains the diagonal
+   */
+  [[nodiscard]] const CSRMatrix<double>& pattern() const { return _L; }
+
+  /**
+   * @returns number of sub- and super-diagonals of the jacobian
+   */
+  [[nodiscard]] std::pair<size_t, size_t> bandwidth() const {
+    size_t kl = 0, ku = 0;
+    for(size_t r = 0; r < _L.rows(); ++r) {
+      for(size_t k = _L.indptr[r]; k < _L.indptr[r + 1]; ++k) {
+        size_t c = _L.indices[k];
+        kl       = std::max(kl, r > c ? r - c : 0);
+        ku       = std::max(ku, c > r ? c - r : 0);
+      }
+    }
+    return { kl, ku };
+  }
+
+  /**
+   * Jacobian of the right hand side
+   * @param t time
+   * @param u state
+   * @returns L + R'(u) with the sparsity pattern of pattern()
+   */
+  [[nodiscard]] CSRMatrix<double> jacobian(double t, const double* u) const {
+    CSRMatrix<double> J = _L;
+    if(!_reaction) return J;
+    size_t m = _components;
+    std::vector<double> block(m * m), r0(m), r1(m), v(m);
+    for(size_t p = 0; p < _grid.nodes(); ++p) {
+      if(_dirichlet[p] >= 0) continue;
+      double x[2];
+      _coordinates(p, x);
+      const double* up = u + p * m;
+      if(_reactionJacobian) {
+        _reactionJacobian(t, x, up, block.data());
+      } else {
+        // forward differences of the local reaction
+        _reaction(t, x, up, r0.data());
+        std::copy(up, up + m, v.begin());
+        for(size_t b = 0; b < m; ++b) {
+          double delta = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(1.0, std::abs(up[b]));
+          v[b]         = up[b] + delta;
+          _reaction(t, x, v.data(), r1.data());
+          v[b] = up[b];
+          for(size_t a = 0; a < m; ++a) { block[a * m + b] = (r1[a] - r0[a]) / delta; }
+        }
+      }
+      for(size_t e = 0; e < m * m; ++e) { J.values[_blockPositions[p * m * m + e]] += block[e]; }
+    }
+    return J;
+  }
+
+  /**
+   * @returns jacobian for ODEOption::SparseJac (copies the discretization)
+   */
+  [[nodiscard]] ODESparseJac sparseJacobian() const {
+    return [self = *this](double t, const Matrix<double>& y) { return self.jacobian(t, &y(0, 0)); };
+  }
+
+private:
+  //! term coefficient * d^order u_component / d axis^order
+  struct Term {
+    //! component of u
+    size_t component;
+    //! 0 for x, 1 for y
+    size_t axis;
+    //! difference quotient
+    DifferenceStencil stencil;
+    //! constant factor
+    double coefficient;
+  };
+
+  //! value outside or on the grid as factor * u[node] + constant
+  struct Neighbour {
+    //! node index along the axis
+    size_t node;
+    //! factor of the value of the node
+    double factor;
+    //! constant part
+    double constant;
+  };
+
+  //! grid
+  PDEGrid _grid;
+  //! components per node
+  size_t _components;
+  //! boundary conditions lower x, upper x, lower y, upper y
+  PDEBoundary _boundaries[4];
+  //! linear terms
+  std::vector<Term> _terms;
+  //! reaction, nullptr if none
+  Reaction _reaction = nullptr;
+  //! jacobian of the reaction, nullptr for finite differences
+  ReactionJacobian _reactionJacobian = nullptr;
+  //! matrix of the linear terms with the pattern of the full jacobian
+  CSRMatrix<double> _L;
+  //! constant part of the linear terms from the boundary conditions
+  std::vector<double> _offset;
+  //! side of the Dirichlet condition of the node, -1 for free nodes
+  std::vector<int> _dirichlet;
+  //! value of the Dirichlet condition of the node
+  std::vector<double> _dirichletValue;
+  //! positions of the reaction blocks in the values of _L
+  std::vector<size_t> _blockPositions;
+
+  /**
+   * @param p node
+   * @param x coordinates of the node
+   */
+  void _coordinates(size_t p, double* x) const {
+    x[0] = _grid.x0 + double(p % _grid.nx) * _grid.dx;
+    x[1] = _grid.y0 + double(p / _grid.nx) * _grid.dy;
+  }
+
+  /**
+   * Resolves a node index along an axis, outside of the grid by the boundary conditions
+   * @param axis 0 for x, 1 for y
+   * @param q node index, may be outside of the grid
+   * @returns the value at q as affine function of a grid value
+   */
+  [[nodiscard]] Neighbour _neighbour(size_t axis, long q) const {
+    long n   = long(axis == 0 ? _grid.nx : _grid.ny);
+    double h = axis == 0 ? _grid.dx : _grid.dy;
+    if(q >= 0 && q < n) return { size_t(q), 1.0, 0.0 };
+    const auto& boundary = _boundaries[2 * axis + (q < 0 ? 0 : 1)];
+    if(boundary.type == PERIODIC_BOUNDARY) return { size_t(((q % n) + n) % n), 1.0, 0.0 };
+    // ghost value j nodes beyond the boundary node, mirrored
+    long j      = q < 0 ? -q : q - (n - 1);
+    long mirror = q < 0 ? j : n - 1 - j;
+    assert(mirror >= 0 && mirror < n);
+    if(boundary.type == DIRICHLET_BOUNDARY) return { size_t(mirror), -1.0, 2.0 * boundary.value };
+    return { size_t(mirror), 1.0, 2.0 * double(j) * h * boundary.value };
+  }
+
+  /**
+   * Builds L, the boundary offset and the pattern of the reaction blocks
+   */
+  void _assemble() {
+    size_t m     = _components;
+    size_t nodes = _grid.nodes();
+    _dirichlet.assign(nodes, -1);
+    _dirichletValue.assign(nodes, 0.0);
+    for(size_t p = 0; p < nodes; ++p) {
+      size_t pos[2] = { p % _grid.nx, p / _grid.nx };
+      for(size_t axis = 0; axis < dimension(); ++axis) {
+        size_t n = axis == 0 ? _grid.nx : _grid.ny;
+        for(size_t side = 0; side < 2; ++side) {
+          const auto& boundary = _boundaries[2 * axis + side];
+          if(boundary.type == DIRICHLET_BOUNDARY && pos[axis] == (side == 0 ? 0 : n - 1) && _dirichlet[p] < 0) {
+            _dirichlet[p]      = int(2 * axis + side);
+            _dirichletValue[p] = boundary.value;
+          }
+        }
+      }
+    }
+
+    COOMatrix<double> L(unknowns(), unknowns());
+    _offset.assign(unknowns(), 0.0);
+    for(size_t p = 0; p < nodes; ++p) {
+      // the diagonal, the reaction couples the components of a node
+      bool coupled = _reaction && _dirichlet[p] < 0;
+      for(size_t a = 0; a < m; ++a) {
+        for(size_t b = 0; b < m; ++b) {
+          if(a == b || coupled) L.add(p * m + a, p * m + b, 0.0);
+        }
+      }
+      if(_dirichlet[p] >= 0) continue;
+      size_t pos[2] = { p % _grid.nx, p / _grid.nx };
+      for(const auto& term : _terms) {
+        double h     = term.axis == 0 ? _grid.dx : _grid.dy;
+        double scale = term.coefficient * std::pow(h, -double(term.stencil.order));
+        size_t row   = p * m + term.component;
+        for(size_t k = 0; k < term.stencil.offsets.size(); ++k) {
+          auto q      = _neighbour(term.axis, long(pos[term.axis]) + term.stencil.offsets[k]);
+          size_t i    = term.axis == 0 ? q.node : pos[0];
+          size_t j    = term.axis == 1 ? q.node : pos[1];
+          double w    = scale * term.stencil.weights[k];
+          L.add(row, index(i, j, term.component), w * q.factor);
+          _offset[row] += w * q.constant;
+        }
+      }
+    }
+    _L = CSRMatrix<double>(L);
+
+    _blockPositions.clear();
+    if(!_reaction) return;
+    _blockPositions.assign(nodes * m * m, 0);
+    for(size_t p = 0; p < nodes; ++p) {
+      if(_dirichlet[p] >= 0) continue;
+      for(size_t a = 0; a < m; ++a) {
+        size_t row = p * m + a;
+        auto begin = _L.indices.begin() + long(_L.indptr[row]);
+        auto end   = _L.indices.begin() + long(_L.indptr[row + 1]);
+        for(size_t b = 0; b < m; ++b) {
+          _blockPositions[(p * m + a) * m + b] = size_t(std::lower_bound(begin, end, p * m + b) - _L.indices.begin());
+        }
+      }
+    }
+  }
+};
+
+/**
+ * \example numerics/pde/TestMethodOfLines.cpp
+ * This is an example on how to use the method of lines.
+ */
@@ -1,5 +1,5 @@
 #include "../../include/math/statistics/Probability.h"
-#include "../../include/math/numerics/lin_alg/gaussSeidel.h"
+#include "../../include/math/numerics/lin_alg/cholesky.h"
 #include "../../include/math/numerics/utils.h"
 
 
@@ -115,7 +115,8 @@ Matrix<double> Regression(const Matrix<double>& a) {
   Matrix<double> right = { { (a.Transpose() * u1)(0, 0) }, { (a.Transpose() * u2)(0, 0) } };
   Matrix<double> left  = { { (u1.Transpose() * u1)(0, 0), (u1.Transpose() * u2)(0, 0) },
                            { (u1.Transpose() * u2)(0, 0), (u2.Transpose() * u2)(0, 0) } };
-  auto beta            = gaussSeidel(left, right);
+  // normal equations are symmetric positive definite
+  auto beta            = Cholesky(left).solve(right);
   return beta(1, 0) * ones(size, 1) + u1 * beta(0, 0);
 }
 
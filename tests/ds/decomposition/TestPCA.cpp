@@ -24,11 +24,71 @@ class PCATestCase : public Test
     return true;
   }
 
+  bool TestLanczosBackend() {
+    // data spread mostly along (1, 1, 0) and (1, -1, 0)
+    Matrix<double> X = { { 3, 3, 0 }, { -3, -3, 0 }, { 1, -1, 0 }, { -1, 1, 0 }, { 2, 2, 0.1 }, { -2, -2, -0.1 } };
+    auto clf         = PCA(2, LANCZOS_BACKEND);
+    clf.fit(X, Matrix<double>());
+
+    AssertEqual(clf.PCs.rows(), 3);
+    AssertEqual(clf.PCs.columns(), 2);
+    AssertLessThenEqual(fabs(fabs(clf.PCs(0, 0)) - 1.0 / sqrt(2.0)), 1e-3);
+    AssertLessThenEqual(fabs(fabs(clf.PCs(1, 0)) - 1.0 / sqrt(2.0)), 1e-3);
+    AssertGreater(clf.singular_values(0, 0), clf.singular_values(1, 0));
+
+    auto projected = clf.transform(X);
+    AssertEqual(projected.rows(), X.rows());
+    AssertEqual(projected.columns(), 2);
+    return true;
+  }
+
+  bool TestBackendsAgree() {
+    // both backends fill the same quantities, the axes are unique up to their sign
+    Matrix<double> tall = { { 3, 3, 0 }, { -3, -3, 0 }, { 1, -1, 0 }, { -1, 1, 0 }, { 2, 2, 0.1 }, { -2, -2, -0.1 } };
+    Matrix<double> wide = { { 3, 1, 0, 2, 1 }, { -1, 2, 1, 0, 1 }, { 0, 1, -2, 1, 3 } };
+    for(const auto& X : { tall, wide }) {
+      auto dense = PCA(2, SVD_BACKEND);
+      auto iter  = PCA(2, LANCZOS_BACKEND);
+      dense.fit(X, Matrix<double>());
+      iter.fit(X, Matrix<double>());
+
+      AssertEqual(dense.PCs.rows(), X.columns());
+      AssertEqual(dense.PCs.columns(), 2);
+      AssertEqual(dense.right.rows(), 2);
+      AssertEqual(dense.right.columns(), X.columns());
+      AssertEqual(dense.singular_values.rows(), 2);
+      AssertEqual(iter.PCs.rows(), dense.PCs.rows());
+      AssertEqual(iter.right.rows(), dense.right.rows());
+      AssertEqual(iter.singular_values.rows(), dense.singular_values.rows());
+
+      auto denseProjected = dense.transform(X);
+      auto iterProjected  = iter.transform(X);
+      for(size_t c = 0; c < 2; ++c) {
+        AssertLessThenEqual(fabs(dense.singular_values(c, 0) - iter.singular_values(c, 0)), 1e-3);
+        for(size_t j = 0; j < X.columns(); ++j) {
+          AssertLessThenEqual(fabs(fabs(dense.PCs(j, c)) - fabs(iter.PCs(j, c))), 1e-3);
+          AssertEqual(dense.right(c, j), dense.PCs(j, c));
+        }
+        for(size_t i = 0; i < X.rows(); ++i) {
+          AssertLessThenEqual(fabs(fabs(denseProjected(i, c)) - fabs(iterProjected(i, c))), 1e-2);
+        }
+      }
+    }
+
+    auto clf = PCA(2);
+    clf.fit(tall, Matrix<double>());
+    AssertLessThenEqual(fabs(clf.singular_values(0, 0) - sqrt(52.01)), 1e-3);
+    AssertLessThenEqual(fabs(clf.singular_values(1, 0) - 2.0), 1e-3);
+    return true;
+  }
+
 public:
   virtual void run() {
     TestConstructor();
     TestFit();
     TestTransform();
+    TestLanczosBackend();
+    TestBackendsAgree();
   }
 };
 
@@ -0,0 +1,132 @@
+#include "../Test.h"
+#include <math/numerics/autodiff.h>
+#include <math/numerics/lin_alg/newton.h>
+#include <math/numerics/ode/ODESolver.h>
+#include <atomic>
+#include <thread>
+
+
+class AutodiffTestCase : public Test
+{
+  bool TestDual() {
+    Dual<2> x(0.5, 0), y(2.0, 1);
+    auto f = x * y + sin(x) / y - exp(x * 2.0) + pow(y, 3) + 1.0;
+    AssertEqual(f.value, 0.5 * 2.0 + std::sin(0.5) / 2.0 - std::exp(1.0) + 8.0 + 1.0);
+    AssertEqual(f.grad[0], 2.0 + std::cos(0.5) / 2.0 - 2 * std::exp(1.0));
+    AssertEqual(f.grad[1], 0.5 - std::sin(0.5) / 4.0 + 12.0);
+
+    auto g = sqrt(x) * log(y) - atan(x) + tanh(y) * cosh(x) - 3.0 / y;
+    AssertLessThenEqual(fabs(g.grad[0] - (0.5 / std::sqrt(0.5) * std::log(2.0) - 1 / 1.25 +
+                                          std::tanh(2.0) * std::sinh(0.5))),
+                        1e-14);
+    AssertLessThenEqual(fabs(g.grad[1] - (std::sqrt(0.5) / 2.0 + (1 - std::tanh(2.0) * std::tanh(2.0)) * std::cosh(0.5) +
+                                          3.0 / 4.0)),
+                        1e-14);
+    AssertTrue(x < y);
+    AssertTrue(abs(-x).grad[0] == 1.0);
+    return true;
+  }
+
+  bool TestJacobian() {
+    // chained rows, more columns than derivative directions per evaluation
+    auto f = [](const auto& x) {
+      auto out = x;
+      for(size_t i = 0; i < x.rows(); ++i) {
+        out(i, 0) = x(i, 0) * x(i, 0) * x(i, 0) + 3 * x(i, 0) - 1;
+        if(i > 0) out(i, 0) -= sin(x(i - 1, 0));
+      }
+      return out;
+    };
+    size_t n = 19;
+    auto x   = Matrix<double>::Random(n, 1);
+    auto J   = autodiffJacobian<4>(f, x);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) {
+        double expected = 0;
+        if(i == j) expected = 3 * x(i, 0) * x(i, 0) + 3;
+        if(i == j + 1) expected = -std::cos(x(j, 0));
+        AssertEqual(J(i, j), expected);
+      }
+    }
+    AssertLessThenEqual(norm(autodiffJacobian(f, x) - J), 1e-14);
+
+    auto res = newton(f, autodiffJacobian(f), Matrix<double>(0, n, 1), 1e-12, 50);
+    AssertLessThenEqual(norm(f(res.first)), 1e-10);
+    auto fd = newton(f, nullptr, Matrix<double>(0, n, 1), 1e-12, 50);
+    AssertLessThenEqual(norm(fd.first - res.first), 1e-8);
+    return true;
+  }
+
+  bool TestODEJacobian() {
+    auto pendulum = []([[maybe_unused]] double t, const auto& y) {
+      auto out  = y;
+      out(0, 0) = y(1, 0);
+      out(1, 0) = -sin(y(0, 0));
+      return out;
+    };
+    std::vector<double> tInterval = { 0.0, 5.0 };
+    Matrix<double> y0             = { { 1.0, 0.5 } };
+    ODEOption exact               = { 0.1, 1e-12, 50, []([[maybe_unused]] double t, const Matrix<double>& y) {
+                         return Matrix<double>({ { 0.0, 1.0 }, { -cos(y(0, 0)), 0.0 } });
+                       } };
+    auto expected = ODESolver::odeTrapez(pendulum, tInterval, y0, exact).Y;
+
+    ODEOption automatic = exact;
+    automatic.Jac       = autodiffODEJacobian(pendulum);
+    AssertLessThenEqual(norm(ODESolver::odeTrapez(pendulum, tInterval, y0, automatic).Y - expected), 1e-12);
+
+    // without jacobian the solvers fall back to finite differences
+    ODEOption none = exact;
+    none.Jac       = nullptr;
+    AssertLessThenEqual(norm(ODESolver::odeTrapez(pendulum, tInterval, y0, none).Y - expected), 1e-8);
+    auto bdf = ODESolver::odeBDF2(pendulum, tInterval, y0, exact).Y;
+    AssertLessThenEqual(norm(ODESolver::odeBDF2(pendulum, tInterval, y0, none).Y - bdf), 1e-8);
+    return true;
+  }
+
+  bool TestSerialFallback() {
+    // the finite difference fallback calls a non thread safe callback only from the calling thread
+    size_t saved      = parallelThreads();
+    parallelThreads() = 4;
+    auto caller       = std::this_thread::get_id();
+    bool foreign      = false;
+    size_t n          = 16;
+    auto decay        = [&](double, const Matrix<double>& y) {
+      foreign = foreign || std::this_thread::get_id() != caller;
+      return y * -1.0;
+    };
+    Matrix<double> y0(1.0, 1, n);
+    ODEOption option = { 0.1, 1e-10, 50, nullptr };
+    ODESolver::odeTrapez(decay, { 0.0, 1.0 }, y0, option);
+    ODESolver::odeBDF2(decay, { 0.0, 1.0 }, y0, option);
+    ODEBDF(decay, { 0.0, 1.0 }, y0, option);
+    newton([&](const Matrix<double>& x) { return decay(0, x) + Matrix<double>(1.0, n, 1); }, nullptr, Matrix<double>(0, n, 1), 1e-12, 50);
+    AssertTrue(!foreign);
+
+    // parallel finite differences are an explicit opt-in
+    std::atomic<bool> concurrent = false;
+    option.parallelJacobian      = true;
+    ODESolver::odeTrapez(
+        [&](double, const Matrix<double>& y) {
+          if(std::this_thread::get_id() != caller) concurrent = true;
+          return y * -1.0;
+        },
+        { 0.0, 1.0 }, y0, option);
+    AssertTrue(concurrent);
+    parallelThreads() = saved;
+    return true;
+  }
+
+public:
+  void run() override {
+    TestDual();
+    TestJacobian();
+    TestODEJacobian();
+    TestSerialFallback();
+  }
+};
+
+int main() {
+  AutodiffTestCase().run();
+  return 0;
+}
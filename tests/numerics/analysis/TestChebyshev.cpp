@@ -0,0 +1,81 @@
+#include "../../Test.h"
+#include <math/numerics/analysis/Chebyshev.h>
+#include <math/numerics/utils.h>
+
+
+class ChebyshevTestCase : public Test
+{
+  bool TestApproximation() {
+    size_t calls = 0;
+    ChebyshevApprox cheb(
+        [&calls](double x) {
+          calls++;
+          return std::exp(x) * std::sin(3 * x);
+        },
+        -1,
+        2);
+    AssertTrue(cheb.converged());
+    AssertLess(cheb.degree(), 64);
+    // nested sampling, every point is evaluated once
+    AssertLessThenEqual(calls, 129);
+
+    auto X = linspace(-1, 2, 1001);
+    auto Y = cheb(X);
+    for(size_t j = 0; j < X.columns(); ++j) {
+      double x = X(0, j);
+      AssertLessThenEqual(std::abs(Y(0, j) - std::exp(x) * std::sin(3 * x)), 1e-13);
+      AssertEqual(Y(0, j), cheb(x));
+    }
+    return true;
+  }
+
+  bool TestCalculus() {
+    ChebyshevApprox cheb([](double x) { return std::sin(x); }, 0, M_PI);
+    AssertLessThenEqual(std::abs(cheb.integrate() - 2.0), 1e-14);
+
+    auto d = cheb.derivative();
+    auto F = cheb.integral();
+    for(double x : { 0.0, 0.3, 1.0, 2.5, M_PI }) {
+      AssertLessThenEqual(std::abs(d(x) - std::cos(x)), 1e-12);
+      AssertLessThenEqual(std::abs(F(x) - (1 - std::cos(x))), 1e-14);
+    }
+    // polynomials are represented exactly
+    ChebyshevApprox p([](double x) { return x * x * x - 2 * x; }, -2, 3);
+    AssertEqual(p.degree(), (size_t)3);
+    AssertLessThenEqual(std::abs(p.derivative()(1.5) - (3 * 1.5 * 1.5 - 2)), 1e-12);
+    return true;
+  }
+
+  bool TestRoots() {
+    ChebyshevApprox cheb([](double x) { return std::cos(x); }, 0, 20);
+    auto r = cheb.roots();
+    AssertEqual(r.size(), (size_t)6);
+    for(size_t i = 0; i < r.size(); ++i) { AssertLessThenEqual(std::abs(r[i] - (i + 0.5) * M_PI), 1e-12); }
+
+    ChebyshevApprox bessel([](double x) { return std::cyl_bessel_j(0.0, x); }, 0, 30);
+    auto z = bessel.roots();
+    AssertEqual(z.size(), (size_t)9);
+    AssertLessThenEqual(std::abs(z[0] - 2.404825557695773), 1e-12);
+    return true;
+  }
+
+  bool TestNoConvergence() {
+    ChebyshevApprox cheb([](double x) { return std::abs(x); }, -1, 1, 1e-14, 64);
+    AssertFalse(cheb.converged());
+    AssertLessThenEqual(std::abs(cheb(0.5) - 0.5), 1e-2);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestApproximation();
+    TestCalculus();
+    TestRoots();
+    TestNoConvergence();
+  }
+};
+
+int main() {
+  ChebyshevTestCase().run();
+  return 0;
+}
@@ -126,6 +126,24 @@ class DifferentiationTestCase : public Test
     return true;
   }
 
+  bool TestStencils() {
+    // the stencils reproduce the quotients on the equidistant grid
+    auto f_xk = f(xk);
+    double dx = xk(1, 0) - xk(0, 0);
+    AssertEqual(stencilDiff(dx, f_xk, forwardStencil()), forwardDiff(xk, f_xk));
+    AssertEqual(stencilDiff(dx, f_xk, backwardStencil()), backwardDiff(xk, f_xk));
+    AssertEqual(stencilDiff(dx, f_xk, centralStencil()), centralDiff(xk, f_xk));
+    AssertEqual(stencilDiff(dx, f_xk, backwardStencil2()), backwardDiff2(xk, f_xk));
+    AssertEqual(stencilDiff(dx, f_xk, centralStencil4()), centralDiff4(xk, f_xk));
+
+    // second derivative of cos is -cos
+    auto fine = linspace(a, b, 201).Transpose();
+    auto d2   = stencilDiff(fine(1, 0) - fine(0, 0), f(fine), secondStencil());
+    AssertEqual(d2(0, 0), 0.0);
+    for(size_t i = 1; i < 200; ++i) { AssertLessThenEqual(std::abs(d2(i, 0) + std::cos(fine(i, 0))), 1e-3); }
+    return true;
+  }
+
 public:
   virtual void run() {
 #if USE_VIS
@@ -136,6 +154,7 @@ public:
     TestForwardDiffs();
     TestCentralDiffs();
     TestCentralDiffs4();
+    TestStencils();
   }
 };
 
@@ -7,11 +7,122 @@ class IntegrationTestCase : public Test
   bool TestQuadAdaptive() {
     auto res = quadrature(sin, 0, M_PI, .1, 1.e-50);
     AssertLessThenEqual(fabs(res.first - 2.0), 9.32e-5);
+    AssertEqual(res.second.front(), 0.0);
+    AssertEqual(res.second.back(), M_PI);
+    AssertTrue(std::is_sorted(res.second.begin(), res.second.end()));
+
+    // the minimal step width ends the refinement instead of the program
+    auto coarse = quadrature(sin, 0, M_PI, 1e-14, 0.1);
+    AssertLess(fabs(coarse.first - 2.0), 1e-4);
+    AssertEqual(coarse.second.size(), (size_t)65);
+    return true;
+  }
+
+  bool TestGaussKronrod() {
+    // polynomials of degree up to 22 are integrated exactly by a single interval
+    auto poly = quadGK([](double x) { return std::pow(x, 10); }, 0, 2);
+    AssertLessThenEqual(fabs(poly.value - std::pow(2.0, 11) / 11), 1e-10);
+    AssertEqual(poly.intervals, (size_t)1);
+    AssertEqual(poly.evaluations, (size_t)15);
+    AssertTrue(poly.converged);
+
+    // sharp peak, the error estimate bounds the true error
+    auto peak     = [](double x) { return 1 / (1e-4 + x * x); };
+    double exact  = 2 / 1e-2 * std::atan(1 / 1e-2);
+    auto res      = quadGK(peak, -1, 1);
+    AssertTrue(res.converged);
+    AssertLessThenEqual(fabs(res.value - exact), res.error);
+    AssertLessThenEqual(res.error, 1e-10 * fabs(res.value));
+
+    // one batch per bisection, the bounds may be swapped
+    size_t calls = 0, nodes = 0;
+    auto batch = [&](const double* x, double* y, size_t n) {
+      calls++;
+      nodes += n;
+      for(size_t i = 0; i < n; ++i) { y[i] = std::sin(50 * x[i]); }
+    };
+    QuadratureOption option;
+    option.atol = 1e-12;
+    auto osc    = quadGK(batch, 3, 0, option);
+    AssertLessThenEqual(fabs(osc.value + (1 - std::cos(150.0)) / 50), 1e-11);
+    AssertEqual(calls, osc.intervals);
+    AssertEqual(nodes, osc.evaluations);
+    AssertEqual(nodes, 15 + 30 * (osc.intervals - 1));
+
+    // integrable singularity, resolved by bisection towards 0
+    auto sqrtSingular = quadGK([](double x) { return 1 / std::sqrt(x); }, 0, 1);
+    AssertTrue(sqrtSingular.converged);
+    AssertLessThenEqual(fabs(sqrtSingular.value - 2), 1e-9);
+    return true;
+  }
+
+  bool TestInfinite() {
+    auto gauss = quadGK([](double x) { return std::exp(-x * x); }, -INFINITY, INFINITY);
+    AssertTrue(gauss.converged);
+    AssertLessThenEqual(fabs(gauss.value - std::sqrt(M_PI)), 1e-9);
+
+    auto inverse = quadGK([](double x) { return 1 / (x * x); }, 1, INFINITY);
+    AssertLessThenEqual(fabs(inverse.value - 1), 1e-9);
+
+    auto exponential = quadGK([](double x) { return std::exp(x); }, -INFINITY, 0);
+    AssertLessThenEqual(fabs(exponential.value - 1), 1e-9);
+
+    auto reversed = quadTanhSinh([](double x) { return 1 / (1 + x * x); }, INFINITY, 0);
+    AssertTrue(reversed.converged);
+    AssertLessThenEqual(fabs(reversed.value + M_PI / 2), 1e-9);
+    return true;
+  }
+
+  bool TestTanhSinh() {
+    auto logarithm = quadTanhSinh([](double x) { return std::log(x); }, 0, 1);
+    AssertTrue(logarithm.converged);
+    AssertLessThenEqual(fabs(logarithm.value + 1), 1e-9);
+
+    auto strong = quadTanhSinh([](double x) { return std::pow(x, -0.9); }, 0, 1);
+    AssertLessThenEqual(fabs(strong.value - 10), 1e-6);
+
+    // singular at both ends, the endpoints are never evaluated, the distance to 1 is resolved only up to eps
+    size_t calls = 0;
+    auto arcsine = [&calls](const double* x, double* y, size_t n) {
+      calls++;
+      for(size_t i = 0; i < n; ++i) { y[i] = 1 / std::sqrt(1 - x[i] * x[i]); }
+    };
+    auto res = quadTanhSinh(arcsine, -1, 1);
+    AssertTrue(res.converged);
+    AssertLessThenEqual(fabs(res.value - M_PI), 1e-7);
+    AssertEqual(calls, res.intervals);
+
+    // smooth integrands converge within a few levels
+    auto smooth = quadTanhSinh([](double x) { return std::exp(x); }, 0, 1);
+    AssertLessThenEqual(fabs(smooth.value - (M_E - 1)), 1e-12);
+    AssertLess(smooth.evaluations, (size_t)200);
+    return true;
+  }
+
+  bool TestNotConverged() {
+    // the tolerance can not be met with three intervals, the estimate is returned anyway
+    QuadratureOption option;
+    option.maxIntervals = 3;
+    auto res = quadGK([](double x) { return std::sin(1 / x); }, 1e-3, 1, option);
+    AssertTrue(!res.converged);
+    AssertEqual(res.intervals, (size_t)3);
+    AssertLess(1e-10, res.error);
+
+    option.maxLevels = 2;
+    auto levels      = quadTanhSinh([](double x) { return std::sin(1 / x); }, 1e-3, 1, option);
+    AssertTrue(!levels.converged);
+    AssertEqual(levels.intervals, (size_t)3);
     return true;
   }
 
 public:
-  virtual void run() { TestQuadAdaptive(); }
+  virtual void run() {
+    TestQuadAdaptive();
+    TestGaussKronrod();
+    TestInfinite();
+    TestTanhSinh();
+    TestNotConverged();
+  }
 };
 
 
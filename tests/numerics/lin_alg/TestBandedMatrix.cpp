@@ -0,0 +1,113 @@
+#include "../../Test.h"
+#include <math/numerics/analysis/Spline.h>
+#include <math/numerics/lin_alg/BandedMatrix.h>
+#include <math/numerics/lin_alg/gaussSeidel.h>
+
+
+class BandedMatrixTestCase : public Test
+{
+  /**
+   * creates random banded matrix with dominant diagonal
+   */
+  static BandedMatrix<double> randomBanded(size_t n, size_t kl, size_t ku) {
+    BandedMatrix<double> A(n, kl, ku);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = A.FirstColumn(i); j <= A.LastColumn(i); ++j) { A(i, j) = Random::Get(-1.0, 1.0); }
+    }
+    return A;
+  }
+
+  bool TestStorage() {
+    auto A = BandedMatrix<double>::Tridiag(5, 1, -2, 1);
+    AssertEqual(A.ToDense(), tridiag(5, 5, 1, -2, 1));
+    AssertEqual(static_cast<const BandedMatrix<double>&>(A)(0, 4), 0.0);
+    AssertFalse(A.InBand(0, 2));
+
+    auto B    = Matrix<double>::Random(6, 6);
+    const auto band = BandedMatrix<double>::FromDense(B, 2, 1);
+    for(size_t i = 0; i < 6; ++i) {
+      for(size_t j = 0; j < 6; ++j) { AssertEqual(band(i, j), band.InBand(i, j) ? B(i, j) : 0.0); }
+    }
+    return true;
+  }
+
+  bool TestMultiplication() {
+    auto A = randomBanded(20, 3, 2);
+    auto x = Matrix<double>::Random(20, 3);
+    AssertEqual(A * x, A.ToDense() * x);
+    return true;
+  }
+
+  bool TestThomas() {
+    size_t n = 50;
+    auto A   = BandedMatrix<double>::Tridiag(n, 1, 4, 1);
+    auto b   = Matrix<double>::Random(n, 2);
+    auto x   = thomas(A, b);
+    AssertLessThenEqual(norm(A.ToDense() * x - b), 1e-12);
+
+    // O(n), one million unknowns
+    size_t N = 1000000;
+    auto big = BandedMatrix<double>::Tridiag(N, -1, 3, -1);
+    auto rhs = ones(N, 1);
+    auto y   = thomas(big, rhs);
+    AssertLessThenEqual(norm(big * y - rhs), 1e-8);
+    return true;
+  }
+
+  bool TestBandedLU() {
+    size_t n = 30;
+    // zero diagonal enforces pivoting
+    auto A = randomBanded(n, 2, 1);
+    for(size_t i = 0; i < n; ++i) { A(i, i) = 0.0; }
+    BandedLU lu(A);
+    AssertTrue(lu.isRegular);
+    auto b = Matrix<double>::Random(n, 2);
+    auto x = lu.solve(b);
+    AssertLessThenEqual(norm(A * x - b), 1e-9);
+    auto b0 = b.GetSlice(0, n - 1, 0, 0);
+    AssertLessThenEqual(norm(lu.solve(b0) - gaussSeidel(A.ToDense(), b0)), 1e-8);
+
+    BandedMatrix<double> singular(3, 1, 1);
+    AssertFalse(BandedLU(singular).isRegular);
+    return true;
+  }
+
+  bool TestCyclicThomas() {
+    size_t n     = 12;
+    auto A       = BandedMatrix<double>::Tridiag(n, 1, 4, 1);
+    double alpha = 1.0, beta = 2.0;
+    auto dense   = A.ToDense();
+    dense(n - 1, 0) = alpha;
+    dense(0, n - 1) = beta;
+    auto b          = Matrix<double>::Random(n, 2);
+    auto x          = cyclicThomas(A, alpha, beta, b);
+    AssertLessThenEqual(norm(dense * x - b), 1e-12);
+    return true;
+  }
+
+  bool TestLargeSpline() {
+    size_t n = 200000;
+    auto X   = linspace(0, 10, n).Transpose();
+    auto Y   = X.Apply([](double x) { return sin(x); });
+    auto xi  = linspace(0.05, 9.95, n).Transpose();
+    auto yi  = Spline(X, Y)(xi);
+    auto ref = xi.Apply([](double x) { return sin(x); });
+    AssertLessThenEqual(norm(yi - ref) / sqrt(n), 1e-8);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestStorage();
+    TestMultiplication();
+    TestThomas();
+    TestBandedLU();
+    TestCyclicThomas();
+    TestLargeSpline();
+  }
+};
+
+int main() {
+  BandedMatrixTestCase().run();
+  return 0;
+}
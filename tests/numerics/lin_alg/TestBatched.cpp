@@ -0,0 +1,79 @@
+#include "../../Test.h"
+#include <math/numerics/Fractals.h>
+#include <math/numerics/lin_alg/batched.h>
+#include <math/numerics/lin_alg/gaussSeidel.h>
+
+
+class BatchedTestCase : public Test
+{
+  bool TestGemm() {
+    size_t count = 5000;
+    BatchedMatrix<double> A(count, 3, 4), B(count, 4, 2), C(count, 3, 2, 1.0);
+    std::vector<Matrix<double>> a, b;
+    for(size_t s = 0; s < count; ++s) {
+      a.push_back(Matrix<double>::Random(3, 4));
+      b.push_back(Matrix<double>::Random(4, 2));
+      A.Set(s, a.back());
+      B.Set(s, b.back());
+    }
+    batchedGemm(A, B, C, 2.0, 0.5);
+    for(size_t s = 0; s < count; s += 97) {
+      AssertLessThenEqual(norm(C.Get(s) - (a[s] * b[s] * 2.0 + ones(3, 2) * 0.5)), 1e-12);
+    }
+    return true;
+  }
+
+  bool TestLUSolve() {
+    size_t count = 6000, n = 5;
+    BatchedMatrix<double> A(count, n, n), B(count, n, 2);
+    std::vector<Matrix<double>> a, b;
+    for(size_t s = 0; s < count; ++s) {
+      a.push_back(Matrix<double>::Random(n, n));
+      b.push_back(Matrix<double>::Random(n, 2));
+      A.Set(s, a.back());
+      B.Set(s, b.back());
+    }
+    auto regular = batchedLUSolve(A, B);
+    for(size_t s = 0; s < count; s += 101) {
+      AssertTrue(regular[s]);
+      AssertLessThenEqual(norm(a[s] * B.Get(s) - b[s]), 1e-8);
+      auto x = gaussSeidel(a[s], b[s]);
+      AssertLessThenEqual(norm(x - B.Get(s)), 1e-8);
+    }
+
+    // pivoting is required for a zero leading element, singular systems are flagged
+    BatchedMatrix<double> P(2, 2, 2), q(2, 2, 1);
+    P.Set(0, { { 0, 1 }, { 2, 0 } });
+    P.Set(1, { { 1, 2 }, { 2, 4 } });
+    q.Set(0, { { 3 }, { 4 } });
+    q.Set(1, { { 1 }, { 1 } });
+    regular = batchedLUSolve(P, q);
+    AssertTrue(regular[0]);
+    AssertFalse(regular[1]);
+    AssertEqual(q.Get(0), Matrix<double>({ { 2 }, { 3 } }));
+    return true;
+  }
+
+  bool TestNewtonFractal() {
+    // batched iteration matches the classification of the per pixel newton method
+    NewtonFractal fractal(10);
+    auto M = fractal();
+    AssertEqual(M.rows(), 20);
+    AssertEqual(M(0, 0), 0.0);
+    AssertEqual(M(0, 1), 1.0);
+    AssertEqual(M(19, 19), 3.0);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestGemm();
+    TestLUSolve();
+    TestNewtonFractal();
+  }
+};
+
+int main() {
+  BatchedTestCase().run();
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/cholesky.h>
+#include <math/numerics/utils.h>
+
+
+class CholeskyTestCase : public Test
+{
+  /**
+   * creates random symmetric positive definite matrix B * B^T + n * I
+   */
+  static Matrix<double> spd(size_t n) {
+    auto B = Matrix<double>::Random(n, n);
+    return B * B.Transpose() + (double)n * eye(n);
+  }
+
+  bool TestCholesky() {
+    Matrix<double> A = { { 4, 12, -16 }, { 12, 37, -43 }, { -16, -43, 98 } };
+    Cholesky chol(A);
+
+    AssertTrue(chol.isPositiveDefinite);
+    Matrix<double> L = { { 2, 0, 0 }, { 6, 1, 0 }, { -8, 5, 3 } };
+    AssertEqual(chol.L, L);
+    AssertEqual(chol.logDet(), log(36.0));
+
+    Matrix<double> b = { { 1 }, { 2 }, { 3 } };
+    AssertEqual(A * chol.solve(b), b);
+    return true;
+  }
+
+  bool TestBlocked() {
+    size_t n = 37;
+    auto A   = spd(n);
+    // block sizes smaller, equal and larger than the matrix
+    Cholesky reference(A, 1);
+    for(size_t blockSize : { 4, 8, 37, 64 }) {
+      Cholesky chol(A, blockSize);
+      AssertTrue(chol.isPositiveDefinite);
+      for(size_t i = 0; i < n; ++i) {
+        for(size_t j = 0; j < n; ++j) { AssertLessThenEqual(fabs(chol.L(i, j) - reference.L(i, j)), 1e-10); }
+      }
+    }
+    auto B = Matrix<double>::Random(n, 3);
+    auto X = reference.solve(B);
+    AssertLessThenEqual(norm(A * X - B), 1e-9);
+    return true;
+  }
+
+  bool TestNotPositiveDefinite() {
+    Matrix<double> A = { { 1, 2 }, { 2, 1 } };
+    Cholesky chol(A);
+    AssertFalse(chol.isPositiveDefinite);
+    return true;
+  }
+
+  bool TestUpdateDowndate() {
+    size_t n = 10;
+    auto A   = spd(n);
+    auto x   = Matrix<double>::Random(n, 1);
+    Cholesky chol(A);
+
+    chol.update(x);
+    Cholesky updated(A + x * x.Transpose());
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) { AssertLessThenEqual(fabs(chol.L(i, j) - updated.L(i, j)), 1e-10); }
+    }
+
+    AssertTrue(chol.downdate(x));
+    Cholesky original(A);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) { AssertLessThenEqual(fabs(chol.L(i, j) - original.L(i, j)), 1e-10); }
+    }
+
+    // downdating the identity by a long vector yields an indefinite matrix
+    Cholesky unit(eye(2));
+    Matrix<double> v = { { 2 }, { 0 } };
+    AssertFalse(unit.downdate(v));
+    AssertEqual(unit.L, eye(2));
+    return true;
+  }
+
+  bool TestLDLT() {
+    // requires a 2x2 pivot
+    Matrix<double> A = { { 0, 1, 2 }, { 1, 0, 3 }, { 2, 3, 0 } };
+    LDLT ldlt(A);
+    AssertTrue(ldlt.isRegular);
+
+    Matrix<double> b = { { 1 }, { -1 }, { 2 } };
+    AssertLessThenEqual(norm(A * ldlt.solve(b) - b), 1e-12);
+
+    // det(A) = 12
+    AssertEqual(ldlt.logAbsDet(), log(12.0));
+    AssertEqual(ldlt.detSign(), 1);
+
+    // P A P^T = L D L^T
+    size_t n = 3;
+    auto LDL = ldlt.L * ldlt.D * ldlt.L.Transpose();
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) { AssertEqual(LDL(i, j), A(ldlt.perm[i], ldlt.perm[j])); }
+    }
+    return true;
+  }
+
+  bool TestLDLTRandomIndefinite() {
+    size_t n = 25;
+    auto B   = Matrix<double>::Random(n, n, 1, -1.0, 1.0);
+    auto A   = B + B.Transpose();
+    LDLT ldlt(A);
+    AssertTrue(ldlt.isRegular);
+    auto b = Matrix<double>::Random(n, 2);
+    AssertLessThenEqual(norm(A * ldlt.solve(b) - b), 1e-8);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestCholesky();
+    TestBlocked();
+    TestNotPositiveDefinite();
+    TestUpdateDowndate();
+    TestLDLT();
+    TestLDLTRandomIndefinite();
+  }
+};
+
+int main() {
+  CholeskyTestCase().run();
+  return 0;
+}
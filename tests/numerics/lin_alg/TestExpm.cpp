@@ -0,0 +1,80 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/SparseMatrix.h>
+#include <math/numerics/lin_alg/expm.h>
+
+class ExpmTestCase : public Test
+{
+  bool TestRotation() {
+    // exp([[0, w], [-w, 0]]) is a rotation by w, the norm selects every Padé degree
+    for(double w : { 1e-3, 0.1, 0.5, 2.0, 5.0, 40.0 }) {
+      Matrix<double> A = { { 0, w }, { -w, 0 } };
+      auto E           = expm(A);
+      Matrix<double> R = { { std::cos(w), std::sin(w) }, { -std::sin(w), std::cos(w) } };
+      AssertLessThenEqual(norm(E - R), 1e-12 * std::max(1.0, w));
+    }
+    return true;
+  }
+
+  bool TestNilpotentAndDiagonal() {
+    Matrix<double> N = { { 0, 1, 2 }, { 0, 0, 3 }, { 0, 0, 0 } };
+    // exp(N) = I + N + N^2 / 2
+    Matrix<double> expected = { { 1, 1, 2 + 1.5 }, { 0, 1, 3 }, { 0, 0, 1 } };
+    AssertLessThenEqual(norm(expm(N) - expected), 1e-14);
+
+    Matrix<double> D = { { -50, 0 }, { 0, 3 } };
+    auto E           = expm(D);
+    AssertLessThenEqual(std::abs(E(0, 0) - std::exp(-50.0)), 1e-30);
+    AssertLessThenEqual(std::abs(E(1, 1) - std::exp(3.0)) / std::exp(3.0), 1e-14);
+    AssertLessThenEqual(std::abs(E(0, 1)) + std::abs(E(1, 0)), 1e-14);
+    return true;
+  }
+
+  bool TestPhi() {
+    Matrix<double> A = { { -2, 1 }, { 0, -3 } };
+    auto phis        = phi(A, 2);
+    auto E           = expm(A);
+    auto I           = eye(2);
+    // A phi_1 = phi_0 - I, A phi_2 = phi_1 - I
+    AssertLessThenEqual(norm(phis[0] - E), 1e-14);
+    AssertLessThenEqual(norm(A * phis[1] - (E - I)), 1e-13);
+    AssertLessThenEqual(norm(A * phis[2] - (phis[1] - I)), 1e-13);
+    return true;
+  }
+
+  bool TestExpmv() {
+    size_t n = 100;
+    COOMatrix<double> coo(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      if(i > 0) coo.add(i, i - 1, 1.0);
+      coo.add(i, i, -2.0);
+      if(i + 1 < n) coo.add(i, i + 1, 1.0);
+    }
+    CSRMatrix<double> A(coo);
+    auto v = Matrix<double>::Random(n, 1);
+    for(double t : { 0.1, 1.0, 20.0 }) {
+      auto expected = expm(A.ToDense() * t) * v;
+      auto w        = expmv(asOperator(A), v, t);
+      AssertLessThenEqual(norm(w - expected) / norm(expected), 1e-9);
+    }
+    // skew-symmetric operator, exp(tA) is orthogonal
+    auto S = Matrix<double>::Random(n, n, 1, -1.0, 1.0);
+    S      = S - S.Transpose();
+    auto w = expmv(asOperator(S), v, 2.0);
+    AssertLessThenEqual(std::abs(norm(w) - norm(v)) / norm(v), 1e-9);
+    AssertLessThenEqual(norm(w - expm(S * 2.0) * v) / norm(v), 1e-9);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestRotation();
+    TestNilpotentAndDiagonal();
+    TestPhi();
+    TestExpmv();
+  }
+};
+
+int main() {
+  ExpmTestCase().run();
+  return 0;
+}
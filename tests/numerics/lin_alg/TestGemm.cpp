@@ -0,0 +1,71 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/gemm.h>
+
+
+class GemmTestCase : public Test
+{
+  /**
+   * max norm of the difference
+   */
+  static double maxError(const Matrix<double>& A, const Matrix<double>& B) {
+    double err = 0;
+    for(size_t i = 0; i < A.rows(); ++i) {
+      for(size_t j = 0; j < A.columns(); ++j) { err = std::max(err, fabs(A(i, j) - B(i, j))); }
+    }
+    return err;
+  }
+
+  bool TestBlocked() {
+    auto A = Matrix<double>::Random(70, 300);
+    auto B = Matrix<double>::Random(300, 530);
+    AssertLessThenEqual(maxError(gemm(A, B), A * B), 1e-12);
+
+    // alpha, beta and sub blocks through the leading dimensions
+    auto C        = Matrix<double>::Random(70, 530);
+    auto expected = A * B * 2.0 + C * 0.5;
+    gemm<double>(70, 530, 300, 2.0, &A(0, 0), 300, &B(0, 0), 530, 0.5, &C(0, 0), 530);
+    AssertLessThenEqual(maxError(C, expected), 1e-12);
+
+    Matrix<double> D(0, 10, 10);
+    gemm<double>(5, 5, 5, 1.0, &A(0, 0), 300, &B(0, 0), 530, 0.0, &D(0, 0), 10);
+    AssertLessThenEqual(maxError(D.GetSlice(0, 4, 0, 4), A.GetSlice(0, 4, 0, 4) * B.GetSlice(0, 4, 0, 4)), 1e-14);
+    AssertEqual(D(9, 9), 0.0);
+    return true;
+  }
+
+  bool TestStrassenAccuracy() {
+    // odd dimensions at every level and several recursion levels
+    for(auto dims : { std::vector<size_t>{ 128, 128, 128 }, { 201, 173, 157 }, { 64, 301, 99 } }) {
+      auto A = Matrix<double>::Random(dims[0], dims[1], 1, -1.0, 1.0);
+      auto B = Matrix<double>::Random(dims[1], dims[2], 1, -1.0, 1.0);
+      auto C = gemm(A, B);
+      for(size_t cutoff : { 8, 16, 33 }) {
+        auto S = strassen(A, B, cutoff);
+        AssertEqual(S.rows(), dims[0]);
+        AssertEqual(S.columns(), dims[2]);
+        // normwise error bound grows with the recursion depth
+        AssertLessThenEqual(maxError(S, C), 1e-10 * dims[1]);
+      }
+    }
+
+    // below the cutoff multiply uses the blocked kernel, results are identical
+    auto A = Matrix<double>::Random(40, 40);
+    AssertEqual(maxError(multiply(A, A), gemm(A, A)), 0.0);
+    size_t saved     = strassenCutoff();
+    strassenCutoff() = 16;
+    AssertLessThenEqual(maxError(multiply(A, A), gemm(A, A)), 1e-12);
+    strassenCutoff() = saved;
+    return true;
+  }
+
+public:
+  void run() override {
+    TestBlocked();
+    TestStrassenAccuracy();
+  }
+};
+
+int main() {
+  GemmTestCase().run();
+  return 0;
+}
@@ -0,0 +1,165 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/krylov.h>
+#include <math/numerics/utils.h>
+
+
+class KrylovTestCase : public Test
+{
+  /**
+   * 1D second difference matrix tridiag(-1, 2, -1) + shift * I
+   */
+  static CSRMatrix<double> laplace1D(size_t n, double shift = 0.0) {
+    COOMatrix<double> coo(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      if(i > 0) coo.add(i, i - 1, -1.0);
+      coo.add(i, i, 2.0 + shift);
+      if(i + 1 < n) coo.add(i, i + 1, -1.0);
+    }
+    return CSRMatrix<double>(coo);
+  }
+
+  /**
+   * 2D five point Laplacian on an m x m grid
+   */
+  static CSRMatrix<double> laplace2D(size_t m) {
+    auto T = laplace1D(m);
+    auto I = CSRMatrix<double>::Identity(m);
+    return kron(I, T) + kron(T, I);
+  }
+
+  /**
+   * non-symmetric convection-diffusion operator on an m x m grid
+   */
+  static CSRMatrix<double> convection2D(size_t m, double c) {
+    COOMatrix<double> coo(m, m);
+    for(size_t i = 0; i < m; ++i) {
+      if(i > 0) coo.add(i, i - 1, -1.0 - c);
+      coo.add(i, i, 2.0);
+      if(i + 1 < m) coo.add(i, i + 1, -1.0 + c);
+    }
+    CSRMatrix<double> T(coo);
+    auto I = CSRMatrix<double>::Identity(m);
+    return kron(I, T) + kron(T, I);
+  }
+
+  static double residual(const CSRMatrix<double>& A, const Matrix<double>& x, const Matrix<double>& b) {
+    return norm(A * x - b) / norm(b);
+  }
+
+  bool TestCG() {
+    auto A = laplace2D(40);
+    auto b = ones(A.rows(), 1);
+
+    auto plain = cg(A, b);
+    AssertTrue(plain.converged);
+    AssertLessThenEqual(residual(A, plain.x, b), 1e-9);
+    AssertEqual(plain.residuals.size(), plain.iterations + 1);
+
+    for(const auto& M : { jacobiPreconditioner(A), ssorPreconditioner(A, 1.5), icPreconditioner(A) }) {
+      KrylovOption option;
+      option.preconditioner = M;
+      auto res              = cg(A, b, option);
+      AssertTrue(res.converged);
+      AssertLessThenEqual(residual(A, res.x, b), 1e-9);
+    }
+
+    KrylovOption option;
+    option.preconditioner = icPreconditioner(A);
+    AssertLess(cg(A, b, option).iterations, plain.iterations);
+
+    // starting at the solution requires no iteration
+    auto warm = cg(A, b, plain.x, { 1e-6 });
+    AssertEqual(warm.iterations, size_t(0));
+    AssertTrue(warm.converged);
+    return true;
+  }
+
+  bool TestDenseAndOperator() {
+    Matrix<double> A = { { 4, 1, 0 }, { 1, 3, 1 }, { 0, 1, 2 } };
+    Matrix<double> b = { { 1 }, { 2 }, { 3 } };
+    auto res         = cg(A, b);
+    AssertTrue(res.converged);
+    AssertLessThenEqual(norm(A * res.x - b), 1e-9);
+
+    LinearOperator op = [](const Matrix<double>& x) {
+      auto y = x;
+      for(size_t i = 0; i < x.rows(); ++i) { y(i, 0) = (i + 1.0) * x(i, 0); }
+      return y;
+    };
+    auto diag = gmres(op, ones(10, 1));
+    AssertTrue(diag.converged);
+    AssertLessThenEqual(fabs(diag.x(9, 0) - 0.1), 1e-9);
+    return true;
+  }
+
+  bool TestBiCGSTAB() {
+    auto A = convection2D(30, 0.4);
+    auto b = ones(A.rows(), 1);
+
+    auto plain = bicgstab(A, b);
+    AssertTrue(plain.converged);
+    AssertLessThenEqual(residual(A, plain.x, b), 1e-9);
+
+    KrylovOption option;
+    option.preconditioner = iluPreconditioner(A);
+    auto ilu              = bicgstab(A, b, option);
+    AssertTrue(ilu.converged);
+    AssertLessThenEqual(residual(A, ilu.x, b), 1e-9);
+    AssertLess(ilu.iterations, plain.iterations);
+    return true;
+  }
+
+  bool TestGMRES() {
+    auto A = convection2D(30, 0.4);
+    auto b = ones(A.rows(), 1);
+
+    KrylovOption option;
+    option.restart = 20;
+    auto plain     = gmres(A, b, option);
+    AssertTrue(plain.converged);
+    AssertLessThenEqual(residual(A, plain.x, b), 1e-9);
+
+    for(const auto& M : { iluPreconditioner(A), gaussSeidelPreconditioner(A, 2) }) {
+      option.preconditioner = M;
+      auto res              = gmres(A, b, option);
+      AssertTrue(res.converged);
+      AssertLessThenEqual(residual(A, res.x, b), 1e-9);
+      AssertLess(res.iterations, plain.iterations);
+    }
+
+    // iteration limit
+    KrylovOption limited;
+    limited.maxIter = 3;
+    auto res        = gmres(A, b, limited);
+    AssertFalse(res.converged);
+    AssertEqual(res.iterations, size_t(3));
+    return true;
+  }
+
+  bool TestLarge() {
+    // linear memory, well conditioned
+    size_t n = 200000;
+    auto A   = laplace1D(n, 1.0);
+    auto b   = ones(n, 1);
+    KrylovOption option;
+    option.preconditioner = jacobiPreconditioner(A);
+    auto res              = cg(A, b, option);
+    AssertTrue(res.converged);
+    AssertLessThenEqual(residual(A, res.x, b), 1e-9);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestCG();
+    TestDenseAndOperator();
+    TestBiCGSTAB();
+    TestGMRES();
+    TestLarge();
+  }
+};
+
+int main() {
+  KrylovTestCase().run();
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/lanczos.h>
+#include <math/numerics/utils.h>
+
+
+class LanczosTestCase : public Test
+{
+  bool TestJacobiEigen() {
+    Matrix<double> A = { { 2, 1, 0 }, { 1, 2, 1 }, { 0, 1, 2 } };
+    auto res         = jacobiEigen(A);
+    auto values      = sort(res.first);
+
+    AssertEqual(values(0, 0), 2.0 - sqrt(2.0));
+    AssertEqual(values(1, 0), 2.0);
+    AssertEqual(values(2, 0), 2.0 + sqrt(2.0));
+
+    // A * v = lambda * v
+    for(size_t i = 0; i < 3; ++i) {
+      auto v = res.second.GetSlice(0, 2, i, i);
+      AssertEqual(A * v, res.first(i, 0) * v);
+    }
+    return true;
+  }
+
+  bool TestLargestEigenvalues() {
+    // eigenvalues of tridiag(-1, 2, -1) are 2 - 2 cos(j pi / (n + 1))
+    size_t n = 200;
+    auto A   = tridiag(n, n, -1, 2, -1);
+    auto res = lanczos(A, 4);
+
+    AssertTrue(res.converged);
+    for(size_t j = 0; j < 4; ++j) {
+      double expected = 2.0 - 2.0 * cos(double(n - j) * M_PI / double(n + 1));
+      AssertLessThenEqual(fabs(res.values(j, 0) - expected), 1e-7);
+      auto v = res.vectors.GetSlice(0, n - 1, j, j);
+      AssertLessThenEqual(norm(A * v - res.values(j, 0) * v), 1e-6);
+    }
+    return true;
+  }
+
+  bool TestSmallestEigenvalues() {
+    size_t n = 50;
+    auto A   = tridiag(n, n, -1, 2, -1);
+    LanczosOption option;
+    option.largest = false;
+    auto res       = lanczos(A, 2, option);
+
+    AssertTrue(res.converged);
+    for(size_t j = 0; j < 2; ++j) {
+      double expected = 2.0 - 2.0 * cos(double(j + 1) * M_PI / double(n + 1));
+      AssertLessThenEqual(fabs(res.values(j, 0) - expected), 1e-7);
+    }
+    return true;
+  }
+
+  bool TestGramOperator() {
+    auto X   = Matrix<double>::Random(40, 12);
+    auto XtX = X.Transpose() * X;
+    auto x   = Matrix<double>::Random(12, 1);
+    AssertEqual(gramOperator(X)(x), XtX * x);
+
+    auto implicit = lanczos(gramOperator(X), X.columns(), 3);
+    auto dense    = lanczos(XtX, 3);
+    for(size_t j = 0; j < 3; ++j) { AssertLessThenEqual(fabs(implicit.values(j, 0) - dense.values(j, 0)), 1e-7); }
+
+    // eigenvectors are orthonormal
+    auto VtV = implicit.vectors.Transpose() * implicit.vectors;
+    for(size_t i = 0; i < 3; ++i) {
+      for(size_t j = 0; j < 3; ++j) { AssertLessThenEqual(fabs(VtV(i, j) - (i == j ? 1.0 : 0.0)), 1e-10); }
+    }
+    return true;
+  }
+
+public:
+  void run() override {
+    TestJacobiEigen();
+    TestLargestEigenvalues();
+    TestSmallestEigenvalues();
+    TestGramOperator();
+  }
+};
+
+int main() {
+  LanczosTestCase().run();
+  return 0;
+}
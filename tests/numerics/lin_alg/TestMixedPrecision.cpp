@@ -0,0 +1,99 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/gaussSeidel.h>
+#include <math/numerics/lin_alg/mixedPrecision.h>
+
+
+class MixedPrecisionTestCase : public Test
+{
+  bool TestConversion() {
+    auto A = Matrix<double>::Random(7, 5, 3);
+    Matrix<float> F(A);
+    Matrix<double> D(F);
+    for(size_t i = 0; i < 7; ++i) {
+      for(size_t j = 0; j < 5; ++j) {
+        for(size_t e = 0; e < 3; ++e) {
+          AssertEqual(F(i, j, e), (float)A(i, j, e));
+          AssertEqual(D(i, j, e), (double)(float)A(i, j, e));
+        }
+      }
+    }
+    return true;
+  }
+
+  bool TestFloatKernels() {
+    auto A = Matrix<double>::Random(60, 80, 1, -1.0, 1.0);
+    auto B = Matrix<double>::Random(80, 50, 1, -1.0, 1.0);
+    Matrix<double> C(gemm(Matrix<float>(A), Matrix<float>(B)));
+    AssertLessThenEqual(norm(C - A * B) / norm(A * B), 1e-5);
+
+    auto M = Matrix<double>::Random(40, 40);
+    for(size_t i = 0; i < 40; ++i) { M(i, i) += 40; }
+    auto b = Matrix<double>::Random(40, 2);
+    Matrix<double> x(luSolve(LU(Matrix<float>(M)), Matrix<float>(b)));
+    AssertLessThenEqual(norm(M * x - b) / norm(b), 1e-5);
+    return true;
+  }
+
+  bool TestRefinement() {
+    size_t n = 200;
+    auto A   = Matrix<double>::Random(n, n, 1, -1.0, 1.0);
+    for(size_t i = 0; i < n; ++i) { A(i, i) += 20; }
+    auto b = Matrix<double>::Random(n, 3);
+
+    auto res = mixedPrecisionSolve(A, b);
+    AssertTrue(res.converged);
+    AssertFalse(res.fallback);
+    AssertLess(0, res.iterations);
+    auto x = gaussSeidel(A, b);
+    AssertLessThenEqual(norm(res.x - x) / norm(x), 1e-13);
+    AssertLessThenEqual(norm(A * res.x - b) / norm(b), 1e-13);
+    return true;
+  }
+
+  bool TestFallback() {
+    // Hilbert matrix, cond ~ 1e13 is out of reach of single precision factors
+    size_t n = 10;
+    Matrix<double> H(0, n, n);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = 0; j < n; ++j) { H(i, j) = 1.0 / (i + j + 1); }
+    }
+    auto b   = H * Matrix<double>(1, n, 1);
+    auto res = mixedPrecisionSolve(H, b);
+    AssertTrue(res.fallback);
+    AssertFalse(res.converged);
+    AssertLessThenEqual(norm(res.x - gaussSeidel(H, b)), 1e-12);
+    // the stagnation is detected long before maxIter
+    AssertLess(res.iterations, 10);
+
+    // entries beyond the float range are not refined at all
+    Matrix<double> A = { { 1e39, 1.0 }, { 1.0, 2.0 } };
+    Matrix<double> c = { { 1e39 + 2.0 }, { 5.0 } };
+    auto large       = mixedPrecisionSolve(A, c);
+    AssertTrue(large.fallback);
+    AssertEqual(large.iterations, 0);
+    AssertLessThenEqual(std::abs(large.x(1, 0) - 2.0), 1e-12);
+
+    // singular in single precision (1 + 1e-9 rounds to 1), regular in double precision
+    Matrix<double> S = { { 1.0, 1.0 }, { 1.0, 1.0 + 1e-9 } };
+    Matrix<double> d = { { 2.0 }, { 2.0 + 1e-9 } };
+    auto singular    = mixedPrecisionSolve(S, d);
+    AssertTrue(singular.fallback);
+    AssertEqual(singular.iterations, 0);
+    AssertLessThenEqual(std::abs(singular.x(0, 0) - 1.0), 1e-6);
+    AssertLessThenEqual(std::abs(singular.x(1, 0) - 1.0), 1e-6);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestConversion();
+    TestFloatKernels();
+    TestRefinement();
+    TestFallback();
+  }
+};
+
+int main() {
+  MixedPrecisionTestCase().run();
+  return 0;
+}
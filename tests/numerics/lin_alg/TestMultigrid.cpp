@@ -0,0 +1,109 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/multigrid.h>
+#include <math/numerics/lin_alg/sparseDirect.h>
+#include <math/numerics/utils.h>
+
+
+class MultigridTestCase : public Test
+{
+  /**
+   * right hand side for the exact solution prod_d sin(pi x_d) of -Δu = f
+   */
+  static std::pair<Matrix<double>, Matrix<double>> sineProblem(size_t dimension, size_t n) {
+    size_t N = 1;
+    for(size_t d = 0; d < dimension; ++d) { N *= n; }
+    double h = 1.0 / double(n + 1);
+    Matrix<double> u(0, N, 1), f(0, N, 1);
+    for(size_t idx = 0; idx < N; ++idx) {
+      double value = 1.0;
+      size_t rest  = idx;
+      for(size_t d = 0; d < dimension; ++d, rest /= n) { value *= sin(M_PI * h * double(rest % n + 1)); }
+      u(idx, 0) = value;
+      f(idx, 0) = dimension * M_PI * M_PI * value;
+    }
+    return { u, f };
+  }
+
+  bool TestDimensions() {
+    for(size_t dimension : { 1, 2, 3 }) {
+      size_t n   = dimension == 3 ? 15 : 63;
+      auto [u, f] = sineProblem(dimension, n);
+      Multigrid mg(dimension, n);
+      auto res = mg.solve(f);
+      AssertTrue(res.converged);
+      AssertLessThenEqual(res.iterations, size_t(12));
+      AssertLessThenEqual(norm(mg.apply(res.x) - f) / norm(f), 1e-10);
+      // discretization error O(h^2)
+      AssertLessThenEqual(norm(res.x - u) / norm(u), 1e-2);
+    }
+    return true;
+  }
+
+  bool TestGridIndependence() {
+    MultigridOption option;
+    option.fullMultigrid = false;
+    size_t coarse = 0, fine = 0;
+    for(size_t n : { 31, 255 }) {
+      auto f = sineProblem(2, n).second;
+      Multigrid mg(2, n, 0.0, 0.0, option);
+      auto res = mg.solve(f);
+      AssertTrue(res.converged);
+      (n == 31 ? coarse : fine) = res.iterations;
+    }
+    AssertLessThenEqual(fine, coarse + 2);
+    return true;
+  }
+
+  bool TestVariants() {
+    size_t n = 31;
+    auto f   = sineProblem(2, n).second;
+    MultigridOption option;
+    option.cycle    = W_CYCLE;
+    option.smoother = JACOBI_SMOOTHER;
+    Multigrid mg(2, n, 1.0, 0.0, option);
+    auto res = mg.solve(f);
+    AssertTrue(res.converged);
+
+    // compare with the sparse direct solver
+    auto A = mg.Assemble();
+    auto x = SparseCholesky(A).solve(f);
+    AssertLessThenEqual(norm(res.x - x) / norm(x), 1e-9);
+    AssertLessThenEqual(norm(mg.apply(x) - A * x), 1e-8);
+
+    // full multigrid is accurate to discretization error without further cycles
+    auto [u, g] = sineProblem(2, 127);
+    Multigrid fmg(2, 127);
+    AssertLessThenEqual(norm(fmg.fullMultigrid(g) - u) / norm(u), 1e-3);
+    return true;
+  }
+
+  bool TestPreconditioner() {
+    size_t n = 63;
+    // the sine problem is an eigenvector of A, use a generic right hand side
+    auto f = ones(n * n, 1);
+    Multigrid mg(2, n);
+    auto A = mg.Assemble();
+
+    KrylovOption option;
+    option.preconditioner = mg.preconditioner();
+    auto pcg              = cg(A, f, option);
+    auto plain            = cg(A, f);
+    AssertTrue(pcg.converged);
+    AssertLessThenEqual(pcg.iterations, size_t(12));
+    AssertLess(pcg.iterations, plain.iterations);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestDimensions();
+    TestGridIndependence();
+    TestVariants();
+    TestPreconditioner();
+  }
+};
+
+int main() {
+  MultigridTestCase().run();
+  return 0;
+}
@@ -21,8 +21,58 @@ class NewtonTestCase : public Test
     return true;
   }
 
+  bool TestSparseNewton() {
+    // x_i^3 + 3 x_i - x_{i-1} - x_{i+1} - 1 = 0
+    size_t n = 200;
+    auto f   = [n](const Matrix<double>& x) {
+      auto F = Matrix<double>(0, n, 1);
+      for(size_t i = 0; i < n; ++i) {
+        F(i, 0) = x(i, 0) * x(i, 0) * x(i, 0) + 3 * x(i, 0) - 1;
+        if(i > 0) F(i, 0) -= x(i - 1, 0);
+        if(i + 1 < n) F(i, 0) -= x(i + 1, 0);
+      }
+      return F;
+    };
+    auto Df = [n](const Matrix<double>& x) {
+      COOMatrix<double> J(n, n);
+      for(size_t i = 0; i < n; ++i) {
+        if(i > 0) J.add(i, i - 1, -1.0);
+        J.add(i, i, 3 * x(i, 0) * x(i, 0) + 3);
+        if(i + 1 < n) J.add(i, i + 1, -1.0);
+      }
+      return CSRMatrix<double>(J);
+    };
+    Matrix<double> x0(0, n, 1);
+    auto res = sparseNewton(f, Df, x0, 1e-12, 50);
+    AssertLess(res.second, 50);
+    AssertLessThenEqual(norm(f(res.first)), 1e-10);
+
+    auto dense = newton(f, [&Df](const Matrix<double>& x) { return Df(x).ToDense(); }, x0, 1e-12, 50);
+    AssertLessThenEqual(norm(dense.first - res.first), 1e-10);
+
+    // the stored corner entry moves between the iterations, same number of non zeros, new pattern
+    size_t calls = 0;
+    auto moving  = [&](const Matrix<double>& x) {
+      auto J = Df(x);
+      COOMatrix<double> M(n, n);
+      for(size_t i = 0; i < n; ++i) {
+        for(size_t p = J.indptr[i]; p < J.indptr[i + 1]; ++p) { M.add(i, J.indices[p], J.values[p]); }
+      }
+      M.add(calls % 2 ? 0 : n - 1, calls % 2 ? n - 1 : 0, 1e-3);
+      calls++;
+      return CSRMatrix<double>(M);
+    };
+    auto corner = sparseNewton(f, moving, x0, 1e-12, 50);
+    AssertLess(corner.second, 50);
+    AssertLessThenEqual(norm(f(corner.first)), 1e-10);
+    return true;
+  }
+
 public:
-  void run() override { TestNewton(); }
+  void run() override {
+    TestNewton();
+    TestSparseNewton();
+  }
 };
 
 int main() { NewtonTestCase().run(); }
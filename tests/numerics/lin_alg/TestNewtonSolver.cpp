@@ -0,0 +1,142 @@
+#include "../../Test.h"
+#include <cmath>
+#include <math/numerics/lin_alg/NewtonSolver.h>
+
+
+class NewtonSolverTestCase : public Test
+{
+  // x_i^3 + 3 x_i - x_{i-1} - x_{i+1} - 1 = 0
+  static Matrix<double> tridiagonal(const Matrix<double>& x) {
+    size_t n = x.rows();
+    auto F   = Matrix<double>(0, n, 1);
+    for(size_t i = 0; i < n; ++i) {
+      F(i, 0) = x(i, 0) * x(i, 0) * x(i, 0) + 3 * x(i, 0) - 1;
+      if(i > 0) F(i, 0) -= x(i - 1, 0);
+      if(i + 1 < n) F(i, 0) -= x(i + 1, 0);
+    }
+    return F;
+  }
+
+  static CSRMatrix<double> tridiagonalPattern(size_t n) {
+    COOMatrix<double> P(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      if(i > 0) P.add(i, i - 1, 1.0);
+      P.add(i, i, 1.0);
+      if(i + 1 < n) P.add(i, i + 1, 1.0);
+    }
+    return CSRMatrix<double>(P);
+  }
+
+  bool TestFiniteDifferences() {
+    auto f = [](const Matrix<double>& x) { return Matrix<double>({ { cos(x(0, 0)) - x(0, 0) } }); };
+    NewtonSolver solver(f);
+    auto res = solver.solve(Matrix<double>({ { 1 } }));
+    AssertTrue(res.converged);
+    AssertLessThenEqual(fabs(res.x(0, 0) - 0.73908513321516067), 1e-12);
+
+    // dense jacobian matches the analytic one
+    Matrix<double> x0(0.5, 6, 1);
+    auto J  = finiteDifferenceJacobian(tridiagonal, x0, tridiagonal(x0));
+    auto Js = finiteDifferenceJacobian(tridiagonal, x0, tridiagonal(x0), tridiagonalPattern(6),
+                                       jacobianColoring(tridiagonalPattern(6)));
+    for(size_t i = 0; i < 6; ++i) {
+      AssertLessThenEqual(fabs(J(i, i) - 3.75), 1e-6);
+      if(i > 0) AssertLessThenEqual(fabs(J(i, i - 1) + 1), 1e-6);
+    }
+    AssertLessThenEqual(norm(Js.ToDense() - J), 1e-6);
+    return true;
+  }
+
+  bool TestColoring() {
+    size_t n      = 300;
+    auto colors   = jacobianColoring(tridiagonalPattern(n));
+    auto pattern  = tridiagonalPattern(n);
+    size_t maxCol = 0;
+    for(auto c : colors) { maxCol = std::max(maxCol, c); }
+    AssertEqual(maxCol, 2);
+
+    NewtonSolver solver(tridiagonal, pattern);
+    AssertEqual(solver.colors(), 3);
+    auto res = solver.solve(Matrix<double>(0, n, 1));
+    AssertTrue(res.converged);
+    AssertLessThenEqual(norm(tridiagonal(res.x)), 1e-10);
+    // three evaluations per jacobian instead of n
+    AssertLess(res.functionEvaluations, 1 + res.jacobianEvaluations * 3 + 2 * (size_t)res.iterations);
+    return true;
+  }
+
+  bool TestJacobianReuse() {
+    size_t n = 50;
+    Matrix<double> x0(0, n, 1);
+    NewtonOption option;
+    option.TOL = 1e-12;
+    auto full  = NewtonSolver(tridiagonal, tridiagonalPattern(n), option).solve(x0);
+
+    for(auto update : { CHORD_NEWTON, BROYDEN_NEWTON }) {
+      option.update = update;
+      auto res      = NewtonSolver(tridiagonal, tridiagonalPattern(n), option).solve(x0);
+      AssertTrue(res.converged);
+      AssertLess(res.jacobianEvaluations, (size_t)res.iterations);
+      AssertLessThenEqual(norm(res.x - full.x), 1e-9);
+    }
+
+    // dense path with analytic jacobian
+    option.update = CHORD_NEWTON;
+    auto Df       = [](const Matrix<double>& x) {
+      auto J = tridiagonalPattern(x.rows()).ToDense() * -1.0;
+      for(size_t i = 0; i < x.rows(); ++i) { J(i, i) = 3 * x(i, 0) * x(i, 0) + 3; }
+      return J;
+    };
+    auto dense = NewtonSolver(tridiagonal, Df, option).solve(x0);
+    AssertTrue(dense.converged);
+    AssertEqual(dense.functionEvaluations, (size_t)dense.iterations + 1);
+    AssertLessThenEqual(norm(dense.x - full.x), 1e-9);
+    return true;
+  }
+
+  bool TestLineSearch() {
+    // plain newton diverges for atan starting at 3
+    auto f  = [](const Matrix<double>& x) { return Matrix<double>({ { atan(x(0, 0)) } }); };
+    auto Df = [](const Matrix<double>& x) { return Matrix<double>({ { 1 / (1 + x(0, 0) * x(0, 0)) } }); };
+    auto plain = newton(f, Df, Matrix<double>({ { 3 } }), 1e-12, 50);
+    AssertFalse(fabs(plain.first(0, 0)) < 1e-6);
+
+    NewtonSolver solver(f, Df);
+    auto res = solver.solve(Matrix<double>({ { 3 } }));
+    AssertTrue(res.converged);
+    AssertLessThenEqual(fabs(res.x(0, 0)), 1e-10);
+
+    solver.option.lineSearch = false;
+    AssertFalse(solver.solve(Matrix<double>({ { 3 } })).converged);
+    return true;
+  }
+
+  bool TestLineSearchStalls() {
+    // the wrong sign of the jacobian makes every damped step an ascent step
+    auto f  = [](const Matrix<double>& x) { return Matrix<double>({ { x(0, 0) - 1 } }); };
+    auto Df = []([[maybe_unused]] const Matrix<double>& x) { return Matrix<double>({ { -1 } }); };
+    NewtonOption option;
+    option.TOL = 1e-3;
+    NewtonSolver solver(f, Df, option);
+    auto res = solver.solve(Matrix<double>({ { 1.5 } }));
+    AssertFalse(res.converged);
+    AssertEqual(res.iterations, 0);
+    AssertEqual(res.x(0, 0), 1.5);
+    AssertEqual(res.residual, 0.5);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestFiniteDifferences();
+    TestColoring();
+    TestJacobianReuse();
+    TestLineSearch();
+    TestLineSearchStalls();
+  }
+};
+
+int main() {
+  NewtonSolverTestCase().run();
+  return 0;
+}
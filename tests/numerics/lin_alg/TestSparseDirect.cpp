@@ -0,0 +1,117 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/gaussSeidel.h>
+#include <math/numerics/lin_alg/sparseDirect.h>
+#include <math/numerics/utils.h>
+
+
+class SparseDirectTestCase : public Test
+{
+  /**
+   * 2D five point Laplacian on an m x m grid
+   */
+  static CSRMatrix<double> laplace2D(size_t m) {
+    COOMatrix<double> coo(m * m, m * m);
+    for(size_t i = 0; i < m; ++i) {
+      for(size_t j = 0; j < m; ++j) {
+        size_t k = i * m + j;
+        coo.add(k, k, 4.0);
+        if(i > 0) coo.add(k, k - m, -1.0);
+        if(i + 1 < m) coo.add(k, k + m, -1.0);
+        if(j > 0) coo.add(k, k - 1, -1.0);
+        if(j + 1 < m) coo.add(k, k + 1, -1.0);
+      }
+    }
+    return CSRMatrix<double>(coo);
+  }
+
+  bool TestOrdering() {
+    auto A    = laplace2D(20);
+    auto perm = minimumDegreeOrdering(A);
+    auto sorted = perm;
+    std::sort(sorted.begin(), sorted.end());
+    for(size_t i = 0; i < sorted.size(); ++i) { AssertEqual(sorted[i], i); }
+
+    // fill reduction compared to the natural (banded) ordering
+    auto natural = analyzeCholesky(A, false);
+    auto ordered = analyzeCholesky(A);
+    AssertLess(ordered.columnPointers.back(), natural.columnPointers.back());
+    return true;
+  }
+
+  bool TestCholesky() {
+    auto A = laplace2D(15);
+    auto b = Matrix<double>::Random(A.rows(), 2);
+    SparseCholesky chol(A);
+    AssertTrue(chol.isPositiveDefinite);
+    AssertLessThenEqual(norm(A * chol.solve(b) - b), 1e-10);
+    // symbolic column counts are exact
+    AssertEqual(chol.L.nonZeros(), chol.symbolic.columnPointers.back());
+
+    // numeric refactorization with the same pattern
+    auto B = 2.0 * A + CSRMatrix<double>::Identity(A.rows());
+    AssertTrue(chol.factorize(B));
+    AssertLessThenEqual(norm(B * chol.solve(b) - b), 1e-10);
+
+    Matrix<double> small = { { 4, 1, 0 }, { 1, 3, 1 }, { 0, 1, 2 } };
+    SparseCholesky smallChol(CSRMatrix<double>::FromDense(small));
+    AssertLessThenEqual(fabs(smallChol.logDet() - log(18.0)), 1e-12);
+
+    Matrix<double> indefinite = { { 1, 2 }, { 2, 1 } };
+    AssertFalse(SparseCholesky(CSRMatrix<double>::FromDense(indefinite)).isPositiveDefinite);
+    return true;
+  }
+
+  bool TestLU() {
+    // non-symmetric convection-diffusion operator
+    auto A = laplace2D(12);
+    for(size_t i = 0; i < A.rows(); ++i) {
+      for(size_t k = A.indptr[i]; k < A.indptr[i + 1]; ++k) {
+        if(A.indices[k] == i + 1) A.values[k] += 0.7;
+      }
+    }
+    auto b = Matrix<double>::Random(A.rows(), 3);
+    SparseLU lu(A);
+    AssertTrue(lu.isRegular);
+    AssertLessThenEqual(norm(A * lu.solve(b) - b), 1e-10);
+
+    // refactorization reusing the symbolic analysis
+    auto symbolic = lu.symbolic;
+    auto B        = A + CSRMatrix<double>::Identity(A.rows());
+    SparseLU lu2(B, symbolic);
+    AssertLessThenEqual(norm(B * lu2.solve(b) - b), 1e-10);
+    return true;
+  }
+
+  bool TestLUPivoting() {
+    size_t n = 40;
+    auto D   = Matrix<double>::Random(n, n, 1, -1.0, 1.0);
+    for(size_t i = 0; i < n; ++i) {
+      D(i, i) = 0.0;
+      for(size_t j = 0; j < n; ++j) {
+        if(j != i && j != (i + 1) % n && j != (i + 7) % n && j != (i + n - 3) % n) D(i, j) = 0.0;
+      }
+    }
+    auto A = CSRMatrix<double>::FromDense(D);
+    auto b = Matrix<double>::Random(n, 1);
+    auto x = sparseSolve(A, b);
+    AssertLessThenEqual(norm(D * x - b), 1e-9);
+    AssertLessThenEqual(norm(x - gaussSeidel(D, b)), 1e-8);
+
+    Matrix<double> singular = { { 1, 2 }, { 2, 4 } };
+    AssertFalse(SparseLU(CSRMatrix<double>::FromDense(singular)).isRegular);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestOrdering();
+    TestCholesky();
+    TestLU();
+    TestLUPivoting();
+  }
+};
+
+int main() {
+  SparseDirectTestCase().run();
+  return 0;
+}
@@ -0,0 +1,136 @@
+#include "../../Test.h"
+#include <cstdio>
+#include <math/numerics/lin_alg/SparseMatrix.h>
+#include <math/numerics/utils.h>
+
+
+class SparseMatrixTestCase : public Test
+{
+  /**
+   * random dense matrix with roughly 20% non zero elements
+   */
+  static Matrix<double> randomSparse(size_t rows, size_t columns) {
+    auto A = Matrix<double>::Random(rows, columns);
+    for(size_t i = 0; i < rows; ++i) {
+      for(size_t j = 0; j < columns; ++j) {
+        if(Random::Get(0.0, 1.0) > 0.2) A(i, j) = 0.0;
+      }
+    }
+    return A;
+  }
+
+  bool TestConversion() {
+    COOMatrix<double> coo(3, 4);
+    coo.add(2, 1, 1.0);
+    coo.add(0, 3, 2.0);
+    coo.add(2, 1, 3.0);
+    coo.add(1, 0, -1.0);
+    Matrix<double> expected = { { 0, 0, 0, 2 }, { -1, 0, 0, 0 }, { 0, 4, 0, 0 } };
+    AssertEqual(coo.ToDense(), expected);
+
+    SparseMatrix<double> A(coo);
+    AssertEqual(A.nonZeros(), size_t(3));
+    AssertEqual(A.ToDense(), expected);
+    AssertEqual(A(2, 1), 4.0);
+    AssertEqual(A(2, 2), 0.0);
+
+    auto csc = A.ToCSC();
+    AssertEqual(csc.ToDense(), expected);
+    AssertEqual(csc(1, 0), -1.0);
+    AssertEqual(csc.ToCSR().ToDense(), expected);
+    AssertEqual(CSCMatrix<double>(coo).ToDense(), expected);
+    AssertEqual(A.ToCOO().ToDense(), expected);
+
+    auto B = randomSparse(15, 9);
+    AssertEqual(SparseMatrix<double>::FromDense(B).ToDense(), B);
+    AssertEqual(CSCMatrix<double>::FromDense(B).ToDense(), B);
+    AssertEqual(SparseMatrix<double>::FromDense(B).Transpose().ToDense(), B.Transpose());
+    return true;
+  }
+
+  bool TestMultiplication() {
+    auto A  = randomSparse(40, 30);
+    auto x  = Matrix<double>::Random(30, 1);
+    auto X  = Matrix<double>::Random(30, 4);
+    auto sA = SparseMatrix<double>::FromDense(A);
+    AssertLessThenEqual(norm(sA * x - A * x), 1e-12);
+    AssertLessThenEqual(norm(sA * X - A * X), 1e-12);
+    AssertLessThenEqual(norm(sA.ToCSC() * X - A * X), 1e-12);
+
+    auto B = randomSparse(30, 25);
+    auto C = sA * SparseMatrix<double>::FromDense(B);
+    AssertLessThenEqual(norm(C.ToDense() - A * B), 1e-12);
+
+    // large SpMV, threaded path
+    size_t n  = 200000;
+    COOMatrix<double> coo(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      if(i > 0) coo.add(i, i - 1, -1.0);
+      coo.add(i, i, 2.0);
+      if(i + 1 < n) coo.add(i, i + 1, -1.0);
+    }
+    SparseMatrix<double> L(coo);
+    auto y = L * ones(n, 1);
+    AssertEqual(y(0, 0), 1.0);
+    AssertEqual(y(n / 2, 0), 0.0);
+    AssertEqual(y(n - 1, 0), 1.0);
+    return true;
+  }
+
+  bool TestElementwise() {
+    auto A  = randomSparse(12, 10);
+    auto B  = randomSparse(12, 10);
+    auto sA = SparseMatrix<double>::FromDense(A);
+    auto sB = SparseMatrix<double>::FromDense(B);
+    AssertLessThenEqual(norm((sA + sB).ToDense() - (A + B)), 1e-14);
+    AssertLessThenEqual(norm((sA - sB).ToDense() - (A - B)), 1e-14);
+    AssertLessThenEqual(norm((2.0 * sA).ToDense() - 2.0 * A), 1e-14);
+    auto AB = A;
+    AB.HadamardMulti(B);
+    AssertLessThenEqual(norm(sA.HadamardMulti(sB).ToDense() - AB), 1e-14);
+
+    auto D = sA - sA;
+    D.Prune();
+    AssertEqual(D.nonZeros(), size_t(0));
+    AssertEqual(SparseMatrix<double>::Identity(4).Diagonal(), ones(4, 1));
+    return true;
+  }
+
+  bool TestKron() {
+    auto A = randomSparse(3, 4);
+    auto B = randomSparse(2, 3);
+    auto K = kron(SparseMatrix<double>::FromDense(A), SparseMatrix<double>::FromDense(B)).ToDense();
+    for(size_t i = 0; i < 6; ++i) {
+      for(size_t j = 0; j < 12; ++j) { AssertEqual(K(i, j), A(i / 2, j / 3) * B(i % 2, j % 3)); }
+    }
+    return true;
+  }
+
+  bool TestSaveLoad() {
+    auto A  = randomSparse(20, 17);
+    auto sA = SparseMatrix<double>::FromDense(A);
+    AssertTrue(sA.Save("TestSparseMatrix.csr"));
+    auto loaded = SparseMatrix<double>::Load("TestSparseMatrix.csr");
+    AssertEqual(loaded.ToDense(), A);
+    AssertEqual(loaded.indptr, sA.indptr);
+    std::remove("TestSparseMatrix.csr");
+
+    auto missing = SparseMatrix<double>::Load("TestSparseMatrix.missing");
+    AssertEqual(missing.rows(), size_t(0));
+    return true;
+  }
+
+public:
+  void run() override {
+    TestConversion();
+    TestMultiplication();
+    TestElementwise();
+    TestKron();
+    TestSaveLoad();
+  }
+};
+
+int main() {
+  SparseMatrixTestCase().run();
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include "../../Test.h"
+#include <math/numerics/lin_alg/backwardSub.h>
+#include <math/numerics/lin_alg/forwardSub.h>
+#include <math/numerics/lin_alg/gaussSeidel.h>
+#include <math/numerics/lin_alg/trsm.h>
+
+
+class TrsmTestCase : public Test
+{
+  /**
+   * random well conditioned matrix, both triangles filled
+   */
+  static Matrix<double> randomTriangular(size_t n) {
+    auto T = Matrix<double>::Random(n, n, 1, -1.0 / n, 1.0 / n);
+    for(size_t i = 0; i < n; ++i) { T(i, i) += 2.0; }
+    return T;
+  }
+
+  /**
+   * extracts the referenced triangle of T as dense matrix
+   */
+  static Matrix<double> triangle(const Matrix<double>& T, TriangularPart part, TriangularDiagonal diag) {
+    auto out = T;
+    for(size_t i = 0; i < T.rows(); ++i) {
+      for(size_t j = 0; j < T.columns(); ++j) {
+        if((part == LOWER_TRIANGULAR && j > i) || (part == UPPER_TRIANGULAR && j < i)) out(i, j) = 0.0;
+      }
+      if(diag == UNIT_DIAGONAL) out(i, i) = 1.0;
+    }
+    return out;
+  }
+
+  bool TestAllVariants() {
+    // dimension larger than the block size
+    size_t n = 150, nrhs = 7;
+    auto T   = randomTriangular(n);
+    auto B   = Matrix<double>::Random(n, nrhs);
+    for(auto part : { LOWER_TRIANGULAR, UPPER_TRIANGULAR }) {
+      for(auto diag : { NON_UNIT_DIAGONAL, UNIT_DIAGONAL }) {
+        for(bool transposed : { false, true }) {
+          auto X  = B;
+          trsm(T, X, part, transposed, diag);
+          auto op = triangle(T, part, diag);
+          if(transposed) op = op.Transpose();
+          AssertLessThenEqual(norm(op * X - B), 1e-10);
+        }
+      }
+    }
+    return true;
+  }
+
+  bool TestMultipleColumns() {
+    size_t n = 20;
+    auto T   = randomTriangular(n);
+    auto B   = Matrix<double>::Random(n, 5);
+
+    // every column has to match the single column solve
+    auto X = backwardSub(T, B);
+    auto Y = forwardSub(T, B);
+    for(size_t c = 0; c < 5; ++c) {
+      auto b = B.GetSlice(0, n - 1, c, c);
+      auto x = backwardSub(T, b);
+      auto y = forwardSub(T, b);
+      for(size_t i = 0; i < n; ++i) {
+        AssertLessThenEqual(fabs(X(i, c) - x(i, 0)), 1e-12);
+        AssertLessThenEqual(fabs(Y(i, c) - y(i, 0)), 1e-12);
+      }
+    }
+    AssertLessThenEqual(norm(triangle(T, UPPER_TRIANGULAR, NON_UNIT_DIAGONAL) * X - B), 1e-10);
+
+    auto A = Matrix<double>::Random(n, n);
+    auto Z = gaussSeidel(A, B);
+    AssertLessThenEqual(norm(A * Z - B), 1e-8);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestAllVariants();
+    TestMultipleColumns();
+  }
+};
+
+int main() {
+  TrsmTestCase().run();
+  return 0;
+}
@@ -9,7 +9,7 @@ class ODE45TestCase : public Test
     Matrix<double> y0             = { { 1.0 } };
     double h                      = 0.1;
 
-    auto foo = ODESolver::ode45(ode, tInterval, y0, { h });
+    auto foo = ODESolver::ode45Fixed(ode, tInterval, y0, { h });
 
     auto yResult = foo.Y;
     auto tResult = foo.T;
@@ -91,10 +91,97 @@ class ODE45TestCase : public Test
     return true;
   }
 
+  bool TestOde45Adaptive() {
+    size_t evaluations            = 0;
+    auto ode = [&evaluations]([[maybe_unused]] double t, const Matrix<double>& y) {
+      evaluations++;
+      return y;
+    };
+    std::vector<double> tInterval = { 0.0, 0.5, 1.0, 1.5, 2.0 };
+    Matrix<double> y0             = { { 1.0 } };
+
+    ODEOption option;
+    option.rtol = 1e-8;
+    option.atol = 1e-10;
+    auto res    = ODESolver::ode45(ode, tInterval, y0, option);
+    AssertEqual(res.T.rows(), tInterval.size());
+    for(size_t i = 0; i < tInterval.size(); ++i) {
+      AssertEqual(res.T(i, 0), tInterval[i]);
+      AssertLessThenEqual(std::abs(res.Y(i, 0) - std::exp(tInterval[i])), 1e-7 * std::exp(tInterval[i]));
+    }
+    // FSAL: 6 evaluations per step, far below the 6000 of the fixed step default
+    AssertLess(evaluations, 300);
+
+    // a looser tolerance requires fewer evaluations
+    size_t tight = evaluations;
+    evaluations  = 0;
+    option.rtol  = 1e-4;
+    ODESolver::ode45(ode, tInterval, y0, option);
+    AssertLess(evaluations, tight);
+
+    // option.h is only the initial step width, the tolerances still apply
+    evaluations  = 0;
+    option.rtol  = 1e-8;
+    option.h     = 1e-3;
+    auto initial = ODESolver::ode45(ode, tInterval, y0, option);
+    AssertLessThenEqual(std::abs(initial.Y(4, 0) - std::exp(2.0)), 1e-7 * std::exp(2.0));
+    AssertLess(evaluations, 300);
+    return true;
+  }
+
+  bool TestOde45AdaptiveSteps() {
+    // pulse around t = 2, steps have to be small there only
+    auto ode = [](double t, const Matrix<double>& y) {
+      return Matrix<double>({ { -y(0, 0) + 10.0 * std::exp(-25.0 * (t - 2.0) * (t - 2.0)) } });
+    };
+    std::vector<double> tInterval = { 0.0, 10.0 };
+    Matrix<double> y0             = { { 1.0 } };
+    ODEOption option;
+    option.rtol    = 1e-7;
+    option.atol    = 1e-10;
+    auto res       = ODE45(ode, tInterval, y0, option);
+    auto reference = ODE45(ode, tInterval, y0, 1e-4);
+    size_t last    = res.T.rows() - 1;
+    AssertEqual(res.T(last, 0), 10.0);
+    AssertLessThenEqual(std::abs(res.Y(last, 0) - reference.Y(reference.Y.rows() - 1, 0)), 1e-8);
+
+    double hMin = 10, hMax = 0;
+    for(size_t l = 0; l < last; ++l) {
+      double h = res.T(l + 1, 0) - res.T(l, 0);
+      AssertLess(0.0, h);
+      hMin = std::min(hMin, h);
+      hMax = std::max(hMax, h);
+    }
+    AssertLess(10 * hMin, hMax);
+    return true;
+  }
+
+  bool TestOde45Backward() {
+    // y' = sqrt(2 - t) is only defined up to the start time t = 2
+    double tMax = 0;
+    auto ode    = [&tMax](double t, const double*, double* dydt) {
+      tMax    = std::max(tMax, t);
+      dydt[0] = std::sqrt(2.0 - t);
+    };
+    Matrix<double> y0 = { { 1.0 } };
+    ODEOption option;
+    option.rtol = 1e-8;
+    option.atol = 1e-10;
+    auto res    = ODE45(ODEInPlace(ode), { 2.0, 0.0 }, y0, option);
+    size_t last = res.T.rows() - 1;
+    AssertEqual(res.T(last, 0), 0.0);
+    AssertEqual(tMax, 2.0);
+    AssertLessThenEqual(std::abs(res.Y(last, 0) - (1.0 - 2.0 / 3.0 * std::pow(2.0, 1.5))), 1e-7);
+    return true;
+  }
+
 public:
   void run() override {
     TestOde45();
     TestOde45RB();
+    TestOde45Adaptive();
+    TestOde45AdaptiveSteps();
+    TestOde45Backward();
   }
 };
 
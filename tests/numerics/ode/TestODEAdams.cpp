@@ -0,0 +1,85 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/ode/odeAdams.h>
+
+class ODEAdamsTestCase : public Test
+{
+  bool TestKepler() {
+    // orbit with eccentricity 0.5, the start value is reached after every period 2 pi
+    size_t evaluations = 0;
+    auto kepler        = [&evaluations](double, const double* y, double* dydt) {
+      evaluations++;
+      double r3 = std::pow(y[0] * y[0] + y[1] * y[1], 1.5);
+      dydt[0]   = y[2];
+      dydt[1]   = y[3];
+      dydt[2]   = -y[0] / r3;
+      dydt[3]   = -y[1] / r3;
+    };
+    double e          = 0.5;
+    Matrix<double> y0 = { { 1 - e, 0, 0, std::sqrt((1 + e) / (1 - e)) } };
+    double previous   = 1;
+    for(double tol : { 1e-6, 1e-8, 1e-10 }) {
+      ODEOption option;
+      option.rtol     = tol;
+      option.atol     = tol;
+      evaluations     = 0;
+      auto res        = ODEAdams(ODEInPlace(kepler), { 0.0, 4 * M_PI }, y0, option);
+      size_t adams    = evaluations;
+      size_t last     = res.T.rows() - 1;
+      double error    = std::hypot(res.Y(last, 0) - y0(0, 0), res.Y(last, 1));
+      size_t rejected = 0;
+      for(size_t i = 0; i <= last; ++i) { rejected += size_t(res.Iterations(i, 0)); }
+      evaluations = 0;
+      ODE45(ODEInPlace(kepler), { 0.0, 4 * M_PI }, y0, option);
+      AssertEqual(res.T(last, 0), 4 * M_PI);
+      AssertLess(error, 1e4 * tol);
+      AssertLess(error, previous);
+      previous = error;
+      // two evaluations per step, one per rejected step, the start value, initial step and three Dormand-Prince steps
+      AssertEqual(adams, 2 * (last - 3) + rejected + 2 + 3 * 6);
+      AssertLess(adams, evaluations);
+    }
+    return true;
+  }
+
+  bool TestDenseOutput() {
+    // harmonic oscillator y = (cos t, -sin t)
+    auto oscillator = [](double, const Matrix<double>& y) { return Matrix<double>({ { y(0, 1), -y(0, 0) } }); };
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    ODEOption option;
+    option.rtol = 1e-9;
+    option.atol = 1e-9;
+    std::vector<double> times;
+    for(size_t i = 0; i <= 200; ++i) { times.push_back(0.05 * double(i)); }
+    auto res = ODESolver::odeAdams(oscillator, times, y0, option);
+    AssertEqual(res.T.rows(), (size_t)201);
+    for(size_t i = 0; i < 201; ++i) {
+      AssertEqual(res.T(i, 0), times[i]);
+      AssertLessThenEqual(std::abs(res.Y(i, 0) - std::cos(times[i])), 1e-6);
+      AssertLessThenEqual(std::abs(res.Y(i, 1) + std::sin(times[i])), 1e-6);
+    }
+
+    // observer sees the same output times and the final state is returned
+    size_t calls = 0;
+    auto final   = ODEAdams(oscillator, times, y0, option, [&](double t, const double* y) {
+      AssertEqual(t, times[calls]);
+      AssertEqual(y[0], res.Y(calls, 0));
+      calls++;
+    });
+    AssertEqual(calls, (size_t)201);
+    AssertEqual(final.T(0, 0), 10.0);
+    AssertLessThenEqual(std::abs(final.Y(0, 0) - std::cos(10.0)), 1e-6);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestKepler();
+    TestDenseOutput();
+  }
+};
+
+int main() {
+  ODEAdamsTestCase().run();
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/ode/odeBDF.h>
+
+class ODEBDFTestCase : public Test
+{
+  bool TestRobertson() {
+    // stiff chemical kinetics with time scales from 1e-4 to 1e4
+    auto robertson = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      double a = 0.04 * y(0, 0), b = 1e4 * y(1, 0) * y(2, 0), c = 3e7 * y(1, 0) * y(1, 0);
+      return Matrix<double>({ { -a + b }, { a - b - c }, { c } });
+    };
+    Matrix<double> y0 = { { 1.0, 0.0, 0.0 } };
+    ODEOption option;
+    option.rtol = 1e-6;
+    option.atol = 1e-10;
+    BDFStatistics stats;
+    option.Jac = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      return Matrix<double>({ { -0.04, 1e4 * y(2, 0), 1e4 * y(1, 0) },
+                              { 0.04, -1e4 * y(2, 0) - 6e7 * y(1, 0), -1e4 * y(1, 0) },
+                              { 0, 6e7 * y(1, 0), 0 } });
+    };
+    auto res    = ODEBDF(robertson, { 0.0, 40.0 }, y0, option, &stats);
+    size_t last = res.T.rows() - 1;
+    AssertEqual(res.T(last, 0), 40.0);
+    AssertLessThenEqual(std::abs(res.Y(last, 0) - 0.7158271), 1e-5);
+    AssertLessThenEqual(std::abs(res.Y(last, 1) - 9.185535e-6) / 9.185535e-6, 1e-3);
+    AssertLessThenEqual(std::abs(res.Y(last, 2) - 0.2841637), 1e-5);
+    AssertEqual(stats.steps + 1, res.T.rows());
+    // the iteration matrix is reused over many steps
+    AssertLess(stats.steps, (size_t)1000);
+    AssertLess(5 * stats.factorizations, stats.steps);
+    AssertLess(10 * stats.jacobians, stats.steps);
+
+    // long integration until the steady state
+    auto longRun = ODEBDF(robertson, { 0.0, 4e10 }, y0, option, &stats);
+    AssertLessThenEqual(std::abs(longRun.Y(longRun.T.rows() - 1, 0) + longRun.Y(longRun.T.rows() - 1, 1)
+                                 + longRun.Y(longRun.T.rows() - 1, 2) - 1.0),
+                        1e-6);
+    AssertLess(stats.steps, (size_t)1000);
+    AssertLess(5 * stats.factorizations, stats.steps);
+    return true;
+  }
+
+  bool TestAccuracyAndDenseOutput() {
+    // stiff problem with the smooth solution cos(t)
+    auto fun = [](double t, const Matrix<double>& y) {
+      return Matrix<double>({ { -1000.0 * (y(0, 0) - std::cos(t)) - std::sin(t) } });
+    };
+    Matrix<double> y0 = { { 1.0 } };
+    double previous   = 1;
+    for(double rtol : { 1e-4, 1e-6, 1e-8 }) {
+      ODEOption option;
+      option.rtol  = rtol;
+      option.atol  = rtol;
+      auto res     = ODEBDF(fun, { 0.0, 10.0 }, y0, option);
+      double error = 0;
+      for(size_t i = 0; i < res.T.rows(); ++i) { error = std::max(error, std::abs(res.Y(i, 0) - std::cos(res.T(i, 0)))); }
+      AssertLess(error, 100 * rtol);
+      AssertLess(error, previous);
+      previous = error;
+    }
+
+    // dense output at given times
+    ODEOption option;
+    option.rtol = 1e-8;
+    option.atol = 1e-8;
+    std::vector<double> times;
+    for(size_t i = 0; i <= 100; ++i) { times.push_back(0.1 * double(i)); }
+    auto res = ODEBDF(fun, times, y0, option);
+    AssertEqual(res.T.rows(), (size_t)101);
+    for(size_t i = 0; i < 101; ++i) {
+      AssertEqual(res.T(i, 0), times[i]);
+      AssertLessThenEqual(std::abs(res.Y(i, 0) - std::cos(res.T(i, 0))), 1e-5);
+    }
+
+    // analytic jacobian
+    option.Jac  = [](double, const Matrix<double>&) { return Matrix<double>({ { -1000.0 } }); };
+    auto exact  = ODEBDF(fun, { 0.0, 10.0 }, y0, option);
+    size_t last = exact.T.rows() - 1;
+    AssertLessThenEqual(std::abs(exact.Y(last, 0) - std::cos(10.0)), 1e-6);
+    return true;
+  }
+
+  bool TestBandedAndSparse() {
+    // semi-discrete heat equation with tridiagonal jacobian
+    size_t n  = 60;
+    double dx = 1.0 / double(n + 1);
+    auto heat = [n, dx](double, const Matrix<double>& y) {
+      Matrix<double> out(0, n, 1);
+      for(size_t i = 0; i < n; ++i) {
+        double left  = i > 0 ? y(i - 1, 0) : 0.0;
+        double right = i + 1 < n ? y(i + 1, 0) : 0.0;
+        out(i, 0)    = (left - 2 * y(i, 0) + right) / (dx * dx);
+      }
+      return out;
+    };
+    Matrix<double> y0(0, 1, n);
+    for(size_t i = 0; i < n; ++i) { y0(0, i) = std::sin(M_PI * dx * double(i + 1)); }
+    // eigenvalue of the discrete laplacian belonging to y0
+    double lambda = -4.0 / (dx * dx) * std::pow(std::sin(M_PI * dx / 2), 2);
+
+    ODEOption option;
+    option.rtol = 1e-7;
+    option.atol = 1e-10;
+    COOMatrix<double> pattern(n, n);
+    for(size_t i = 0; i < n; ++i) {
+      for(size_t j = i > 0 ? i - 1 : 0; j <= std::min(n - 1, i + 1); ++j) { pattern.add(i, j, 1.0); }
+    }
+    BDFStatistics denseStats, bandedStats, sparseStats;
+    auto dense  = ODEBDF(heat, { 0.0, 0.5 }, y0, option, &denseStats);
+    auto banded = ODEBDF(heat, { 0.0, 0.5 }, y0, option, 1, 1, &bandedStats);
+    auto sparse = ODEBDF(heat, { 0.0, 0.5 }, y0, option, CSRMatrix<double>(pattern), &sparseStats);
+
+    for(const auto* res : { &dense, &banded, &sparse }) {
+      size_t last = res->T.rows() - 1;
+      for(size_t i = 0; i < n; ++i) {
+        AssertLessThenEqual(std::abs(res->Y(last, i) - std::exp(0.5 * lambda) * y0(0, i)), 1e-6);
+      }
+    }
+    AssertEqual(bandedStats.steps, denseStats.steps);
+    AssertEqual(sparseStats.steps, denseStats.steps);
+    // f(y) and three colors per finite difference jacobian instead of n columns
+    AssertEqual(bandedStats.functionEvaluations - bandedStats.newtonIterations - 1, 4 * bandedStats.jacobians);
+    AssertLess(sparseStats.functionEvaluations, denseStats.functionEvaluations);
+    return true;
+  }
+
+  bool TestBackward() {
+    // y' = -y from t = 1 back to t = 0, y = e^(1 - t)
+    auto decay = [](double, const Matrix<double>& y) { return -1.0 * y; };
+    Matrix<double> y0 = { { 1.0 } };
+    ODEOption option;
+    option.rtol = 1e-8;
+    option.atol = 1e-10;
+    option.Jac  = [](double, const Matrix<double>&) { return Matrix<double>(-1.0, 1, 1); };
+    std::vector<double> times = { 1.0, 0.75, 0.5, 0.25, 0.0 };
+    for(const auto& res : { ODEBDF(decay, times, y0, option), ODEBDF(decay, times, y0, option, 0, 0),
+                            ODERosenbrock(decay, times, y0, option), ODEAdams(decay, times, y0, option),
+                            ODE45(decay, times, y0, option) }) {
+      AssertEqual(res.T.rows(), times.size());
+      for(size_t l = 0; l < times.size(); ++l) {
+        AssertEqual(res.T(l, 0), times[l]);
+        AssertLessThenEqual(std::abs(res.Y(l, 0) - std::exp(1 - times[l])), 1e-5);
+      }
+    }
+
+    // terminal event y = 2 at t = 1 - log 2, crossed upwards in the order of the integration
+    option.events = { { [](double, const double* y) { return y[0] - 2.0; }, EVENT_INCREASING, true } };
+    for(const auto& res : { ODEBDF(decay, { 1.0, 0.0 }, y0, option), ODERosenbrock(decay, { 1.0, 0.0 }, y0, option),
+                            ODEAdams(decay, { 1.0, 0.0 }, y0, option), ODE45(decay, { 1.0, 0.0 }, y0, option) }) {
+      AssertEqual(res.TE.rows(), (size_t)1);
+      AssertLessThenEqual(std::abs(res.TE(0, 0) - (1 - std::log(2.0))), 1e-5);
+      AssertEqual(res.T(res.T.rows() - 1, 0), res.TE(0, 0));
+      for(size_t l = 0; l + 1 < res.T.rows(); ++l) { AssertLess(res.T(l + 1, 0), res.T(l, 0)); }
+    }
+
+    // the observer sees the original time
+    std::vector<double> observed;
+    option.events = {};
+    auto final    = ODEAdams(decay, times, y0, option, [&observed](double t, const double*) { observed.push_back(t); });
+    AssertTrue(observed == times);
+    AssertEqual(final.T(0, 0), 0.0);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestRobertson();
+    TestAccuracyAndDenseOutput();
+    TestBandedAndSparse();
+    TestBackward();
+  }
+};
+
+int main() {
+  ODEBDFTestCase().run();
+  return 0;
+}
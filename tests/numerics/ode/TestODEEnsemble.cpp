@@ -0,0 +1,162 @@
+#include "../../Test.h"
+#include <algorithm>
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/ode/ensemble.h>
+
+class ODEEnsembleTestCase : public Test
+{
+  //! y' = -p y, vectorized over the lanes
+  static void decay(const double*, const double* y, const double* p, double* dydt, size_t lanes) {
+    for(size_t s = 0; s < lanes; ++s) { dydt[s] = -p[s] * y[s]; }
+  }
+
+  bool TestStatistics() {
+    size_t N = 201;
+    Matrix<double> Y0(0, N, 1), P(0, N, 1);
+    for(size_t s = 0; s < N; ++s) {
+      Y0(s, 0) = 1.0 + 0.01 * double(s % 7);
+      P(s, 0)  = 0.5 + 1.5 * double(s) / double(N - 1);
+    }
+    EnsembleOption option;
+    option.rtol      = 1e-10;
+    option.atol      = 1e-12;
+    option.batch     = 16;
+    option.quantiles = { 0.1, 0.5, 0.9 };
+    std::vector<double> tOut = { 0.0, 0.5, 1.0, 2.0 };
+    auto res                 = ODEEnsemble(decay, tOut, Y0, P, option);
+    AssertEqual(res.failed, (size_t)0);
+    AssertEqual(res.mean.rows(), tOut.size());
+    AssertEqual(res.quantiles.size(), (size_t)3);
+
+    for(size_t j = 0; j < tOut.size(); ++j) {
+      std::vector<double> exact(N);
+      for(size_t s = 0; s < N; ++s) { exact[s] = Y0(s, 0) * std::exp(-P(s, 0) * tOut[j]); }
+      double mean = 0, M2 = 0;
+      for(auto v : exact) { mean += v / double(N); }
+      for(auto v : exact) { M2 += (v - mean) * (v - mean); }
+      AssertLessThenEqual(std::abs(res.mean(j, 0) - mean), 1e-8);
+      AssertLessThenEqual(std::abs(res.variance(j, 0) - M2 / double(N - 1)), 1e-8);
+
+      std::sort(exact.begin(), exact.end());
+      for(size_t q = 0; q < 3; ++q) {
+        double pos      = option.quantiles[q] * double(N - 1);
+        size_t lo       = size_t(pos);
+        double quantile = exact[lo] + (pos - double(lo)) * (exact[std::min(lo + 1, N - 1)] - exact[lo]);
+        AssertLessThenEqual(std::abs(res.quantiles[q](j, 0) - quantile), 1e-8);
+      }
+    }
+    for(size_t s = 0; s < N; ++s) {
+      AssertLessThenEqual(std::abs(res.Y(s, 0) - Y0(s, 0) * std::exp(-2.0 * P(s, 0))), 1e-8);
+    }
+    return true;
+  }
+
+  bool TestMatchesSingleTrajectories() {
+    // oscillators with frequency p through the per trajectory adapter
+    auto oscillator = [](double, const double* y, const double* p, double* dydt) {
+      dydt[0] = y[1];
+      dydt[1] = -p[0] * p[0] * y[0];
+    };
+    size_t N = 37;
+    Matrix<double> Y0(0, N, 2), P(0, N, 1);
+    for(size_t s = 0; s < N; ++s) {
+      Y0(s, 0) = 1.0;
+      Y0(s, 1) = 0.1 * double(s);
+      P(s, 0)  = 1.0 + 0.25 * double(s);
+    }
+    EnsembleOption option;
+    option.batch = 8;
+    auto fun     = ensembleFunction(oscillator, 2, 1);
+    auto res     = ODEEnsemble(fun, { 0.0, 3.0 }, Y0, P, option);
+    AssertEqual(res.failed, (size_t)0);
+
+    // every lane follows the step size sequence of a single adaptive run
+    for(size_t s = 0; s < N; ++s) {
+      double p = P(s, 0);
+      ODEOption single;
+      single.rtol   = option.rtol;
+      single.atol   = option.atol;
+      auto rhs      = [p](double, const double* y, double* dydt) {
+        dydt[0] = y[1];
+        dydt[1] = -p * p * y[0];
+      };
+      auto reference = ODE45(rhs, { 0.0, 3.0 }, Y0(s), single);
+      size_t last    = reference.Y.rows() - 1;
+      AssertLessThenEqual(std::abs(res.Y(s, 0) - reference.Y(last, 0)), 1e-10);
+      AssertLessThenEqual(std::abs(res.Y(s, 1) - reference.Y(last, 1)), 1e-10);
+    }
+
+    // the batch size does not change the trajectories
+    option.batch = 1;
+    auto serial  = ODEEnsemble(fun, { 0.0, 3.0 }, Y0, P, option);
+    AssertEqual(serial.Y, res.Y);
+    AssertEqual(serial.steps, res.steps);
+    AssertEqual(serial.mean, res.mean);
+    return true;
+  }
+
+  bool TestFailedQuantiles() {
+    // y' = p y^2, y = 1 / (1 - p t) blows up at t = 1 for p = 1
+    auto blowup = [](double, const double* y, const double* p, double* dydt) { dydt[0] = p[0] * y[0] * y[0]; };
+    std::vector<double> p = { 1.0, 0.1, 0.2, 0.3 };
+    Matrix<double> Y0(1.0, p.size(), 1), P(0, p.size(), 1);
+    for(size_t s = 0; s < p.size(); ++s) { P(s, 0) = p[s]; }
+    EnsembleOption option;
+    option.quantiles = { 0.0, 1.0, 0.5 };
+    option.maxSteps  = 2000;
+    auto res         = ODEEnsemble(ensembleFunction(blowup, 1, 1), { 0.0, 0.5, 2.0 }, Y0, P, option);
+    AssertEqual(res.failed, (size_t)1);
+
+    // all trajectories at t = 0.5, the survivors at t = 2, the order of the quantiles does not matter
+    std::vector<std::vector<double>> sections = { { 1 / 0.95, 1 / 0.9, 1 / 0.85, 2.0 }, { 1.25, 1 / 0.6, 2.5 } };
+    for(size_t j = 0; j < 2; ++j) {
+      const auto& v = sections[j];
+      double median = v.size() % 2 ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+      AssertLessThenEqual(std::abs(res.quantiles[0](j + 1, 0) - v.front()), 1e-5);
+      AssertLessThenEqual(std::abs(res.quantiles[1](j + 1, 0) - v.back()), 1e-5);
+      AssertLessThenEqual(std::abs(res.quantiles[2](j + 1, 0) - median), 1e-5);
+    }
+    return true;
+  }
+
+  bool TestQuantileSketch() {
+    // more trajectories than the summary holds, y' = 0 keeps the uniform start values
+    size_t N = 5000;
+    Matrix<double> Y0(0, N, 1), P(0, N, 1);
+    for(size_t s = 0; s < N; ++s) { Y0((s * 7919) % N, 0) = double(s) / double(N - 1); }
+    EnsembleOption option;
+    option.quantiles        = { 0.0, 0.1, 0.5, 0.9, 1.0 };
+    option.quantileCapacity = 64;
+    auto res                = ODEEnsemble(decay, { 0.0, 1.0 }, Y0, P, option);
+    AssertEqual(res.quantiles[0](1, 0), 0.0);
+    AssertEqual(res.quantiles[4](1, 0), 1.0);
+    for(size_t q = 1; q < 4; ++q) { AssertLessThenEqual(std::abs(res.quantiles[q](1, 0) - option.quantiles[q]), 0.02); }
+
+    // two merged summaries of 0, 0.5, ..., 49.5 are exact at the ends, off by a few ranks in between
+    ensemble::QuantileSketch a(64), b(64);
+    for(size_t s = 0; s < 50; ++s) {
+      a.add(double(s));
+      b.add(double(s) + 0.5);
+    }
+    a.merge(b);
+    AssertEqual(a.count(), (size_t)100);
+    auto merged = a.quantiles(option.quantiles);
+    AssertEqual(merged[0], 0.0);
+    AssertEqual(merged[4], 49.5);
+    for(size_t q = 1; q < 4; ++q) { AssertLessThenEqual(std::abs(merged[q] - 0.5 * 99 * option.quantiles[q]), 1.0); }
+    return true;
+  }
+
+public:
+  void run() override {
+    TestStatistics();
+    TestMatchesSingleTrajectories();
+    TestFailedQuantiles();
+    TestQuantileSketch();
+  }
+};
+
+int main() {
+  ODEEnsembleTestCase().run();
+  return 0;
+}
@@ -0,0 +1,135 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+
+class ODEEventsTestCase : public Test
+{
+  bool TestTerminal() {
+    // free fall from 10 m, stops at the ground
+    double g  = 9.81;
+    auto fall = [g](double, const double* y, double* dydt) {
+      dydt[0] = y[1];
+      dydt[1] = -g;
+    };
+    Matrix<double> y0 = { { 10.0, 0.0 } };
+    ODEOption option;
+    option.rtol   = 1e-8;
+    option.atol   = 1e-10;
+    option.events = { { [](double, const double* y) { return y[0]; }, EVENT_DECREASING, true } };
+    auto res      = ODE45(ODEInPlace(fall), { 0.0, 100.0 }, y0, option);
+    double tHit   = std::sqrt(2 * 10.0 / g);
+    AssertEqual(res.TE.rows(), (size_t)1);
+    AssertEqual(res.IE(0, 0), 0);
+    AssertLessThenEqual(std::abs(res.TE(0, 0) - tHit), 1e-8);
+    AssertLessThenEqual(std::abs(res.YE(0, 0)), 1e-8);
+    AssertLessThenEqual(std::abs(res.YE(0, 1) + g * tHit), 1e-7);
+    // the integration ends at the event
+    size_t last = res.T.rows() - 1;
+    AssertEqual(res.T(last, 0), res.TE(0, 0));
+    AssertEqual(res.Y(last, 0), res.YE(0, 0));
+    for(size_t i = 0; i < last; ++i) { AssertLess(0.0, res.Y(i, 0)); }
+
+    // dense output stops at the event as well
+    std::vector<double> times;
+    for(size_t i = 0; i <= 100; ++i) { times.push_back(0.1 * double(i)); }
+    auto dense = ODE45(ODEInPlace(fall), times, y0, option);
+    last       = dense.T.rows() - 1;
+    AssertEqual(last, size_t(tHit / 0.1) + 1);
+    AssertEqual(dense.T(last - 1, 0), times[last - 1]);
+    AssertEqual(dense.T(last, 0), dense.TE(0, 0));
+
+    // streaming to an observer
+    size_t calls = 0;
+    auto final   = ODE45(ODEInPlace(fall), { 0.0, 100.0 }, y0, option, [&calls](double, const double*) { calls++; });
+    AssertEqual(calls, res.T.rows());
+    AssertEqual(final.T(0, 0), res.TE(0, 0));
+    AssertEqual(final.TE(0, 0), res.TE(0, 0));
+    return true;
+  }
+
+  bool TestDirections() {
+    // y = (cos t, -sin t), zeros of cos t at pi / 2 (decreasing), 3 pi / 2 (increasing) and 5 pi / 2 (decreasing)
+    auto oscillator = [](double, const double* y, double* dydt) {
+      dydt[0] = y[1];
+      dydt[1] = -y[0];
+    };
+    auto cosine       = [](double, const double* y) { return y[0]; };
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    ODEOption option;
+    option.rtol   = 1e-9;
+    option.atol   = 1e-11;
+    option.events = { { cosine, EVENT_INCREASING, false },
+                      { cosine, EVENT_DECREASING, false },
+                      { cosine, EVENT_ANY, false },
+                      { [](double t, const double*) { return t - 1.0; }, EVENT_ANY, false } };
+    auto res      = ODE45(ODEInPlace(oscillator), { 0.0, 10.0 }, y0, option);
+    AssertEqual(res.T(res.T.rows() - 1, 0), 10.0);
+
+    std::vector<double> expectedT = { 1.0, M_PI / 2, M_PI / 2, 3 * M_PI / 2, 3 * M_PI / 2, 5 * M_PI / 2, 5 * M_PI / 2 };
+    std::vector<int> expectedI    = { 3, 1, 2, 0, 2, 1, 2 };
+    AssertEqual(res.TE.rows(), expectedT.size());
+    for(size_t l = 0; l < expectedT.size(); ++l) {
+      AssertLessThenEqual(std::abs(res.TE(l, 0) - expectedT[l]), 1e-8);
+      AssertLessThenEqual(std::abs(res.YE(l, 1) + std::sin(res.TE(l, 0))), 1e-8);
+    }
+    // events of the same step are ordered by time, equal zeros by the index
+    for(size_t l = 0; l < expectedT.size(); ++l) {
+      if(l + 1 < expectedT.size() && std::abs(expectedT[l] - expectedT[l + 1]) < 1e-12) {
+        AssertTrue((res.IE(l, 0) == expectedI[l] && res.IE(l + 1, 0) == expectedI[l + 1])
+                   || (res.IE(l, 0) == expectedI[l + 1] && res.IE(l + 1, 0) == expectedI[l]));
+        ++l;
+      } else {
+        AssertEqual(res.IE(l, 0), expectedI[l]);
+      }
+    }
+    return true;
+  }
+
+  bool TestSolvers() {
+    // y' = -y reaches 1/2 at log 2
+    auto decay = [](double, const Matrix<double>& y) { return -1.0 * y; };
+    Matrix<double> y0 = { { 1.0 } };
+    ODEOption option;
+    option.rtol   = 1e-8;
+    option.atol   = 1e-10;
+    option.events = { { [](double, const double* y) { return y[0] - 0.5; }, EVENT_DECREASING, true } };
+    std::vector<ODEResult> results = { ODESolver::ode45(decay, { 0.0, 10.0 }, y0, option),
+                                       ODESolver::odeAdams(decay, { 0.0, 10.0 }, y0, option),
+                                       ODEBDF(decay, { 0.0, 10.0 }, y0, option),
+                                       ODERosenbrock(decay, { 0.0, 10.0 }, y0, option) };
+    for(const auto& res : results) {
+      AssertEqual(res.TE.rows(), (size_t)1);
+      AssertLessThenEqual(std::abs(res.TE(0, 0) - std::log(2.0)), 1e-5);
+      AssertLessThenEqual(std::abs(res.YE(0, 0) - 0.5), 1e-6);
+      AssertEqual(res.T(res.T.rows() - 1, 0), res.TE(0, 0));
+    }
+
+    // dense output of the stiff solvers
+    std::vector<double> times = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+    for(const auto& res : { ODEBDF(decay, times, y0, option), ODERosenbrock(decay, times, y0, option),
+                            ODEAdams(decay, times, y0, option) }) {
+      AssertEqual(res.T.rows(), (size_t)4);
+      AssertEqual(res.T(2, 0), 0.5);
+      AssertLessThenEqual(std::abs(res.Y(2, 0) - std::exp(-0.5)), 1e-5);
+      AssertLessThenEqual(std::abs(res.T(3, 0) - std::log(2.0)), 1e-5);
+    }
+
+    // event during the start of the Adams method
+    option.events = { { [](double t, const double*) { return t - 1e-3; }, EVENT_INCREASING, true } };
+    auto adams    = ODEAdams(decay, { 0.0, 10.0 }, y0, option);
+    AssertLessThenEqual(std::abs(adams.TE(0, 0) - 1e-3), 1e-12);
+    AssertLessThenEqual(std::abs(adams.YE(0, 0) - std::exp(-1e-3)), 1e-8);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestTerminal();
+    TestDirections();
+    TestSolvers();
+  }
+};
+
+int main() {
+  ODEEventsTestCase().run();
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+
+class ODEExponentialTestCase : public Test
+{
+  bool TestLinearExact() {
+    // stiff linear ode, one huge step is exact
+    Matrix<double> A  = { { -1000, 1 }, { 0, -0.5 } };
+    Matrix<double> y0 = { { 1.0, 2.0 } };
+    auto res          = ODEETD(A, nullptr, { 0.0, 4.0 }, y0, { 2.0 });
+    AssertEqual(res.Y.rows(), (size_t)3);
+    auto expected = expm(A * 4.0) * y0.Transpose();
+    for(size_t i = 0; i < 2; ++i) { AssertLessThenEqual(std::abs(res.Y(2, i) - expected(i, 0)), 1e-12); }
+
+    auto linear    = [&A]([[maybe_unused]] double t, const Matrix<double>& y) { return A * y; };
+    ODEOption opts = { 2.0, 1e-7, 50, [&A](double, const Matrix<double>&) { return A; } };
+    auto ros       = ODESolver::odeExpRosenbrock(linear, { 0.0, 4.0 }, y0, opts);
+    for(size_t i = 0; i < 2; ++i) { AssertLessThenEqual(std::abs(ros.Y(2, i) - expected(i, 0)), 1e-12); }
+    return true;
+  }
+
+  bool TestSemilinearConvergence() {
+    // y' = -50 y + sin(t) - y^2 / 10, reference by a fine step
+    Matrix<double> A = { { -50.0 } };
+    ODE N            = [](double t, const Matrix<double>& y) {
+      return Matrix<double>({ { std::sin(t) - y(0, 0) * y(0, 0) / 10 } });
+    };
+    Matrix<double> y0 = { { 1.0 } };
+    auto reference    = ODEETD(A, N, { 0.0, 1.0 }, y0, { 1e-4 }).Y(10000, 0);
+    double e1         = std::abs(ODEETD(A, N, { 0.0, 1.0 }, y0, { 0.02 }).Y(50, 0) - reference);
+    double e2         = std::abs(ODEETD(A, N, { 0.0, 1.0 }, y0, { 0.01 }).Y(100, 0) - reference);
+    // second order
+    AssertLessThenEqual(e2, e1 / 3);
+    AssertLessThenEqual(e1, 1e-4);
+    return true;
+  }
+
+  bool TestPendulum() {
+    auto ode = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      return Matrix<double>({ { y(1, 0) }, { -sin(y(0, 0)) } });
+    };
+    std::vector<double> tInterval = { 0.0, 5.0 };
+    Matrix<double> y0             = { { 1.0, 0.5 } };
+    auto reference                = ODESolver::odeTrapez(ode, tInterval, y0, { 0.001, 1e-12 });
+    auto res                      = ODESolver::odeExpRosenbrock(ode, tInterval, y0, { 0.01 });
+    size_t last                   = res.Y.rows() - 1;
+    AssertEqual(last, (size_t)500);
+    for(size_t i = 0; i < 2; ++i) { AssertLessThenEqual(std::abs(res.Y(last, i) - reference.Y(5000, i)), 1e-3); }
+    return true;
+  }
+
+public:
+  void run() override {
+    TestLinearExact();
+    TestSemilinearConvergence();
+    TestPendulum();
+  }
+};
+
+int main() {
+  ODEExponentialTestCase().run();
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "../../Test.h"
+#include <atomic>
+#include <cstdlib>
+#include <math/numerics/ode/ODESolver.h>
+#include <new>
+
+//! number of heap allocations of this process
+static std::atomic<size_t> allocations{ 0 };
+
+void* operator new(size_t size) {
+  allocations++;
+  if(void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+//! number of right hand side evaluations
+static size_t evaluations = 0;
+
+class ODEInPlaceTestCase : public Test
+{
+  //! harmonic oscillator
+  static void oscillator([[maybe_unused]] double t, const double* y, double* dydt) {
+    evaluations++;
+    dydt[0] = y[1];
+    dydt[1] = -y[0];
+  }
+
+  bool TestAdapterMatchesInPlace() {
+    auto ode = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      return Matrix<double>({ { y(0, 1), -y(0, 0) } });
+    };
+    Matrix<double> y0             = { { 1.0, 0.0 } };
+    std::vector<double> tInterval = { 0.0, 3.0 };
+
+    AssertEqual(ODEExpEuler(ode, tInterval, y0, 0.01).Y, ODEExpEuler(oscillator, tInterval, y0, 0.01).Y);
+    AssertEqual(ODE45(ode, tInterval, y0, 0.01).Y, ODE45(oscillator, tInterval, y0, 0.01).Y);
+    ODEOption option;
+    option.rtol  = 1e-9;
+    option.atol  = 1e-12;
+    auto adapted = ODE45(ode, { 0.0, 1.0, 2.0, 3.0 }, y0, option);
+    auto direct  = ODE45(oscillator, { 0.0, 1.0, 2.0, 3.0 }, y0, option);
+    AssertEqual(adapted.Y, direct.Y);
+    AssertLessThenEqual(std::abs(direct.Y(3, 0) - std::cos(3.0)), 1e-8);
+    return true;
+  }
+
+  bool TestNoAllocationsPerStep() {
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    // the allocations of a call must not depend on the number of steps
+    auto count = [&y0](double h, bool rk) {
+      size_t before = allocations;
+      if(rk) {
+        ODE45(oscillator, { 0.0, 10.0 }, y0, h);
+      } else {
+        ODEExpEuler(oscillator, { 0.0, 10.0 }, y0, h);
+      }
+      return allocations - before;
+    };
+    AssertEqual(count(1e-2, false), count(1e-5, false));
+    AssertEqual(count(1e-2, true), count(1e-5, true));
+
+    // dense output at given times, the result is allocated up front
+    std::vector<double> times(101);
+    for(size_t i = 0; i < times.size(); ++i) { times[i] = 0.1 * double(i); }
+    ODEOption loose, tight;
+    loose.rtol     = 1e-4;
+    tight.rtol     = 1e-12;
+    tight.atol     = 1e-14;
+    size_t before  = allocations;
+    evaluations    = 0;
+    auto coarse    = ODE45(oscillator, times, y0, loose);
+    size_t first   = allocations - before;
+    size_t steps   = evaluations;
+    before         = allocations;
+    evaluations    = 0;
+    auto fine      = ODE45(oscillator, times, y0, tight);
+    size_t second  = allocations - before;
+    // the tight tolerance takes many more steps without allocating more
+    AssertLess(10 * steps, evaluations);
+    AssertEqual(first, second);
+    AssertLessThenEqual(std::abs(coarse.Y(100, 0) - std::cos(10.0)), 1e-2);
+    AssertLessThenEqual(std::abs(fine.Y(100, 0) - std::cos(10.0)), 1e-10);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestAdapterMatchesInPlace();
+    TestNoAllocationsPerStep();
+  }
+};
+
+int main() {
+  ODEInPlaceTestCase().run();
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include "../../Test.h"
+#include <cstdio>
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/ode/observers.h>
+
+class ODEObserverTestCase : public Test
+{
+  //! harmonic oscillator
+  static void oscillator([[maybe_unused]] double t, const double* y, double* dydt) {
+    dydt[0] = y[1];
+    dydt[1] = -y[0];
+  }
+
+  bool TestStreamingMatchesTrajectory() {
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    auto full         = ODE45(oscillator, { 0.0, 2.0 }, y0, 0.01);
+    size_t steps      = 0;
+    auto last         = ODE45(oscillator, { 0.0, 2.0 }, y0, 0.01, [&](double t, const double* y) {
+      AssertEqual(t, full.T(steps, 0));
+      AssertEqual(y[0], full.Y(steps, 0));
+      AssertEqual(y[1], full.Y(steps, 1));
+      steps++;
+    });
+    AssertEqual(steps, full.T.rows());
+    AssertEqual(last.Y.rows(), (size_t)1);
+    AssertEqual(last.T(0, 0), full.T(steps - 1, 0));
+    AssertEqual(last.Y(0, 1), full.Y(steps - 1, 1));
+
+    // implicit solvers, column vectors
+    auto pendulum = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      return Matrix<double>({ { y(1, 0) }, { -sin(y(0, 0)) } });
+    };
+    ODEOption option = { 0.1 };
+    using Full       = ODEResult (*)(const ODE&, const std::vector<double>&, const Matrix<double>&, const ODEOption&);
+    using Streaming  = ODEResult (*)(const ODE&, const std::vector<double>&, const Matrix<double>&, const ODEOption&,
+                                    const ODEObserver&);
+    std::vector<std::pair<Full, Streaming>> solvers = { { ODETrapez, ODETrapez }, { ODEBDF2, ODEBDF2 } };
+    for(auto [full, streaming] : solvers) {
+      auto reference = full(pendulum, { 0.0, 3.0 }, y0, option);
+      size_t i       = 0;
+      streaming(pendulum, { 0.0, 3.0 }, y0, option, [&](double t, const double* y) {
+        AssertEqual(t, reference.T(i, 0));
+        AssertEqual(y[0], reference.Y(i, 0));
+        AssertEqual(y[1], reference.Y(i, 1));
+        i++;
+      });
+      AssertEqual(i, reference.T.rows());
+    }
+    return true;
+  }
+
+  bool TestDecimationAndTimes() {
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    std::vector<double> times;
+    ODEExpEuler(oscillator, { 0.0, 1.0 }, y0, 0.001, everyKSteps(100, [&times](double t, const double*) {
+                  times.push_back(t);
+                }));
+    AssertEqual(times.size(), (size_t)11);
+    AssertLessThenEqual(std::abs(times[10] - 1.0), 1e-12);
+
+    std::vector<double> values;
+    ODE45(oscillator, { 0.0, 3.0 }, y0, 0.001, atTimes({ 0.0, 0.25, 1.0, 2.5 }, 2, [&](double t, const double* y) {
+            times.push_back(t);
+            values.push_back(y[0]);
+          }));
+    AssertEqual(values.size(), (size_t)4);
+    for(size_t i = 0; i < 4; ++i) {
+      double t = times[11 + i];
+      AssertLessThenEqual(std::abs(values[i] - std::cos(t)), 1e-6);
+    }
+
+    // adaptive solver with output times streams its dense output
+    ODEOption option;
+    option.rtol  = 1e-9;
+    option.atol  = 1e-12;
+    size_t count = 0;
+    ODE45(oscillator, { 0.0, 0.5, 1.0 }, y0, option, [&](double t, const double* y) {
+      count++;
+      AssertLessThenEqual(std::abs(y[0] - std::cos(t)), 1e-8);
+    });
+    AssertEqual(count, (size_t)3);
+    return true;
+  }
+
+  bool TestBinarySink() {
+    const char* path  = "ode_observer_test.bin";
+    Matrix<double> y0 = { { 1.0, 0.0 } };
+    {
+      ODEBinarySink sink(path, 2, 16);
+      ODEExpEuler(oscillator, { 0.0, 1.0 }, y0, 0.01, std::ref(sink));
+      AssertEqual(sink.steps(), (size_t)101);
+    }
+    auto data = readODEBinary(path, 2);
+    auto full = ODEExpEuler(oscillator, { 0.0, 1.0 }, y0, 0.01);
+    AssertEqual(data.rows(), (size_t)101);
+    for(size_t i = 0; i < data.rows(); ++i) {
+      AssertEqual(data(i, 0), full.T(i, 0));
+      AssertEqual(data(i, 1), full.Y(i, 0));
+      AssertEqual(data(i, 2), full.Y(i, 1));
+    }
+    std::remove(path);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestStreamingMatchesTrajectory();
+    TestDecimationAndTimes();
+    TestBinarySink();
+  }
+};
+
+int main() {
+  ODEObserverTestCase().run();
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/ode/odeRosenbrock.h>
+
+class ODERosenbrockTestCase : public Test
+{
+  bool TestRobertson() {
+    auto robertson = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      double a = 0.04 * y(0, 0), b = 1e4 * y(1, 0) * y(2, 0), c = 3e7 * y(1, 0) * y(1, 0);
+      return Matrix<double>({ { -a + b }, { a - b - c }, { c } });
+    };
+    Matrix<double> y0 = { { 1.0, 0.0, 0.0 } };
+    ODEOption option;
+    option.rtol = 1e-6;
+    option.atol = 1e-10;
+    option.Jac  = []([[maybe_unused]] double t, const Matrix<double>& y) {
+      return Matrix<double>({ { -0.04, 1e4 * y(2, 0), 1e4 * y(1, 0) },
+                              { 0.04, -1e4 * y(2, 0) - 6e7 * y(1, 0), -1e4 * y(1, 0) },
+                              { 0, 6e7 * y(1, 0), 0 } });
+    };
+    BDFStatistics stats;
+    auto res    = ODERosenbrock(robertson, { 0.0, 40.0 }, y0, option, &stats);
+    size_t last = res.T.rows() - 1;
+    AssertEqual(res.T(last, 0), 40.0);
+    AssertLessThenEqual(std::abs(res.Y(last, 0) - 0.7158271), 1e-5);
+    AssertLessThenEqual(std::abs(res.Y(last, 1) - 9.185535e-6) / 9.185535e-6, 1e-3);
+    AssertLessThenEqual(std::abs(res.Y(last, 2) - 0.2841637), 1e-5);
+
+    // one jacobian per accepted step and one factorization per attempted step, no newton iterations
+    AssertEqual(stats.steps + 1, res.T.rows());
+    AssertEqual(stats.jacobians, stats.steps);
+    AssertEqual(stats.factorizations, stats.steps + stats.rejected);
+    AssertEqual(stats.newtonIterations, (size_t)0);
+    AssertEqual(stats.functionEvaluations, 1 + 3 * (stats.steps + stats.rejected) + stats.steps);
+    AssertLess(stats.steps, (size_t)500);
+    return true;
+  }
+
+  bool TestAccuracyAndDenseOutput() {
+    auto fun = [](double t, const Matrix<double>& y) {
+      return Matrix<double>({ { -1000.0 * (y(0, 0) - std::cos(t)) - std::sin(t) } });
+    };
+    Matrix<double> y0 = { { 1.0 } };
+    double previous   = 1;
+    for(double rtol : { 1e-4, 1e-6, 1e-8 }) {
+      ODEOption option;
+      option.rtol  = rtol;
+      option.atol  = rtol;
+      auto res     = ODERosenbrock(fun, { 0.0, 10.0 }, y0, option);
+      double error = 0;
+      for(size_t i = 0; i < res.T.rows(); ++i) {
+        error = std::max(error, std::abs(res.Y(i, 0) - std::cos(res.T(i, 0))));
+      }
+      AssertLess(error, 100 * rtol);
+      AssertLess(error, previous);
+      previous = error;
+    }
+
+    // local error O(h^5) of a single step, the loose tolerance accepts the initial step
+    auto decay = [](double, const Matrix<double>& y) { return -1.0 * y; };
+    std::vector<double> errors;
+    for(double h : { 0.1, 0.05 }) {
+      ODEOption option;
+      option.h    = h;
+      option.rtol = 1e3;
+      auto res    = ODERosenbrock(decay, { 0.0, 0.0 + h }, y0, option);
+      errors.push_back(std::abs(res.Y(1, 0) - std::exp(-h)));
+    }
+    AssertLess(std::abs(std::log2(errors[0] / errors[1]) - 5.0), 0.3);
+
+    ODEOption option;
+    option.rtol = 1e-8;
+    option.atol = 1e-8;
+    std::vector<double> times;
+    for(size_t i = 0; i <= 100; ++i) { times.push_back(0.1 * double(i)); }
+    auto res = ODERosenbrock(fun, times, y0, option);
+    AssertEqual(res.T.rows(), (size_t)101);
+    for(size_t i = 0; i < 101; ++i) {
+      AssertEqual(res.T(i, 0), times[i]);
+      AssertLessThenEqual(std::abs(res.Y(i, 0) - std::cos(res.T(i, 0))), 1e-5);
+    }
+    return true;
+  }
+
+  bool TestBanded() {
+    size_t n  = 60;
+    double dx = 1.0 / double(n + 1);
+    auto heat = [n, dx](double, const Matrix<double>& y) {
+      Matrix<double> out(0, n, 1);
+      for(size_t i = 0; i < n; ++i) {
+        double left  = i > 0 ? y(i - 1, 0) : 0.0;
+        double right = i + 1 < n ? y(i + 1, 0) : 0.0;
+        out(i, 0)    = (left - 2 * y(i, 0) + right) / (dx * dx);
+      }
+      return out;
+    };
+    Matrix<double> y0(0, 1, n);
+    for(size_t i = 0; i < n; ++i) { y0(0, i) = std::sin(M_PI * dx * double(i + 1)); }
+    double lambda = -4.0 / (dx * dx) * std::pow(std::sin(M_PI * dx / 2), 2);
+
+    ODEOption option;
+    option.rtol = 1e-7;
+    option.atol = 1e-10;
+    BDFStatistics denseStats, bandedStats;
+    auto dense  = ODERosenbrock(heat, { 0.0, 0.5 }, y0, option, &denseStats);
+    auto banded = ODERosenbrock(heat, { 0.0, 0.5 }, y0, option, 1, 1, &bandedStats);
+    for(const auto* res : { &dense, &banded }) {
+      size_t last = res->T.rows() - 1;
+      for(size_t i = 0; i < n; ++i) {
+        AssertLessThenEqual(std::abs(res->Y(last, i) - std::exp(0.5 * lambda) * y0(0, i)), 1e-6);
+      }
+    }
+    AssertEqual(bandedStats.steps, denseStats.steps);
+    AssertLess(bandedStats.functionEvaluations, denseStats.functionEvaluations);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestRobertson();
+    TestAccuracyAndDenseOutput();
+    TestBanded();
+  }
+};
+
+int main() {
+  ODERosenbrockTestCase().run();
+  return 0;
+}
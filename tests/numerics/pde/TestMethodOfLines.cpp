@@ -0,0 +1,152 @@
+#include "../../Test.h"
+#include <math/numerics/ode/ODESolver.h>
+#include <math/numerics/pde/methodOfLines.h>
+
+class MethodOfLinesTestCase : public Test
+{
+  bool TestHeatDirichlet() {
+    // u_t = u_xx on [0, 1] with u = 0 at both ends, sin(pi x) decays with the discrete eigenvalue
+    size_t n = 201;
+    MethodOfLines mol(PDEGrid(0.0, 1.0, n));
+    mol.addDiffusion(0, 1.0);
+    AssertEqual(mol.unknowns(), n);
+    AssertEqual(mol.bandwidth().first, (size_t)1);
+    AssertEqual(mol.bandwidth().second, (size_t)1);
+    // three entries per inner node, the diagonal of the boundary nodes
+    AssertEqual(mol.pattern().nonZeros(), 3 * (n - 2) + 2);
+
+    auto y0       = mol.initialValue([](const double* x, double* u) { u[0] = std::sin(M_PI * x[0]); });
+    double dx     = 1.0 / double(n - 1);
+    double lambda = -4.0 / (dx * dx) * std::pow(std::sin(M_PI * dx / 2), 2);
+    ODEOption option;
+    option.rtol      = 1e-8;
+    option.atol      = 1e-10;
+    option.SparseJac = mol.sparseJacobian();
+    BDFStatistics stats;
+    auto res    = ODEBDF(mol.ode(), { 0.0, 0.1 }, y0, option, 1, 1, &stats);
+    size_t last = res.T.rows() - 1;
+    for(size_t i = 0; i < n; ++i) {
+      AssertLessThenEqual(std::abs(res.Y(last, i) - std::exp(0.1 * lambda) * y0(0, i)), 1e-6);
+    }
+    // the jacobian is not approximated by finite differences
+    AssertEqual(stats.functionEvaluations, stats.newtonIterations + 1);
+    return true;
+  }
+
+  bool TestJacobian() {
+    // Brusselator on a 2D grid with periodic, Neumann and Dirichlet sides
+    auto reaction = [](double, const double* x, const double* u, double* r) {
+      r[0] = 1 + x[0] + u[0] * u[0] * u[1] - 4 * u[0];
+      r[1] = 3 * u[0] - u[0] * u[0] * u[1];
+    };
+    auto reactionJacobian = [](double, const double*, const double* u, double* J) {
+      J[0] = 2 * u[0] * u[1] - 4;
+      J[1] = u[0] * u[0];
+      J[2] = 3 - 2 * u[0] * u[1];
+      J[3] = -u[0] * u[0];
+    };
+    MethodOfLines mol(PDEGrid(0.0, 1.0, 7, 0.0, 2.0, 5), 2);
+    mol.setBoundary(0, { PERIODIC_BOUNDARY, 0 }, { PERIODIC_BOUNDARY, 0 });
+    mol.setBoundary(1, { NEUMANN_BOUNDARY, 0.3 }, { DIRICHLET_BOUNDARY, 1.0 });
+    mol.addDiffusion(0, 0.02);
+    mol.addDiffusion(1, 0.01);
+    mol.addTerm(0, 0, centralStencil4(), -0.5);
+    mol.addTerm(1, 1, backwardStencil(), 0.25);
+    mol.setReaction(reaction);
+
+    auto y0 = mol.initialValue([](const double* x, double* u) {
+      u[0] = 1 + 0.5 * std::sin(2 * M_PI * x[0]) * x[1];
+      u[1] = 2 + x[0] * x[1];
+    });
+    // nodes on the Dirichlet side take the boundary value and do not change
+    AssertEqual(y0(0, mol.index(3, 4, 1)), 1.0);
+    Matrix<double> dydt(0, 1, mol.unknowns());
+    mol(0.0, &y0(0, 0), &dydt(0, 0));
+    AssertEqual(dydt(0, mol.index(3, 4, 0)), 0.0);
+
+    auto ode   = mol.ode();
+    auto J     = mol.jacobian(0.0, &y0(0, 0));
+    auto exact = finiteDifferenceJacobian([&ode](const Matrix<double>& y) { return ode(0.0, y); }, y0.Transpose(),
+                                          ode(0.0, y0.Transpose()));
+    auto dense = J.ToDense();
+    for(size_t i = 0; i < mol.unknowns(); ++i) {
+      for(size_t j = 0; j < mol.unknowns(); ++j) { AssertLessThenEqual(std::abs(dense(i, j) - exact(i, j)), 1e-5); }
+    }
+
+    // analytic reaction jacobian with the same pattern
+    mol.setReaction(reaction, reactionJacobian);
+    auto analytic = mol.jacobian(0.0, &y0(0, 0));
+    AssertEqual(analytic.indices.size(), J.indices.size());
+    for(size_t k = 0; k < J.values.size(); ++k) {
+      AssertEqual(analytic.indices[k], J.indices[k]);
+      AssertLessThenEqual(std::abs(analytic.values[k] - J.values[k]), 1e-5);
+    }
+    return true;
+  }
+
+  bool TestNeumannReaction2D() {
+    // u_t = D laplace u - k u with zero flux, cos(pi x) cos(pi y) is an eigenvector of the discrete laplacian
+    size_t n = 31;
+    double D = 0.1, k = 2.0;
+    MethodOfLines mol(PDEGrid(0.0, 1.0, n, 0.0, 1.0, n));
+    mol.setBoundary(0, { NEUMANN_BOUNDARY, 0 }, { NEUMANN_BOUNDARY, 0 });
+    mol.setBoundary(1, { NEUMANN_BOUNDARY, 0 }, { NEUMANN_BOUNDARY, 0 });
+    mol.addDiffusion(0, D);
+    mol.setReaction([k](double, const double*, const double* u, double* r) { r[0] = -k * u[0]; },
+                    [k](double, const double*, const double*, double* J) { J[0] = -k; });
+    auto y0 = mol.initialValue([](const double* x, double* u) { u[0] = std::cos(M_PI * x[0]) * std::cos(M_PI * x[1]); });
+    double dx     = 1.0 / double(n - 1);
+    double lambda = -8.0 * D / (dx * dx) * std::pow(std::sin(M_PI * dx / 2), 2) - k;
+
+    ODEOption option;
+    option.rtol      = 1e-7;
+    option.atol      = 1e-9;
+    option.SparseJac = mol.sparseJacobian();
+    BDFStatistics stats;
+    auto res    = ODERosenbrock(mol.ode(), { 0.0, 0.5 }, y0, option, mol.pattern(), &stats);
+    size_t last = res.T.rows() - 1;
+    for(size_t i = 0; i < mol.unknowns(); ++i) {
+      AssertLessThenEqual(std::abs(res.Y(last, i) - std::exp(0.5 * lambda) * y0(0, i)), 1e-6);
+    }
+    // three stages and f_t per attempt, f per step and no finite difference jacobians
+    AssertEqual(stats.functionEvaluations, 1 + 3 * (stats.steps + stats.rejected) + stats.steps);
+    return true;
+  }
+
+  bool TestPeriodicAdvection() {
+    // u_t = -u_x on a periodic grid, the profile returns after one period and the mass is conserved
+    size_t n      = 200;
+    double period = 1.0;
+    MethodOfLines mol(PDEGrid(0.0, period * double(n - 1) / double(n), n));
+    mol.setBoundary(0, { PERIODIC_BOUNDARY, 0 }, { PERIODIC_BOUNDARY, 0 });
+    mol.addTerm(0, 0, centralStencil4(), -1.0);
+    auto y0 = mol.initialValue([](const double* x, double* u) { u[0] = std::exp(-50 * std::pow(x[0] - 0.5, 2)); });
+
+    ODEOption option;
+    option.rtol = 1e-9;
+    option.atol = 1e-9;
+    auto res    = ODE45(mol.rhs(), { 0.0, period }, y0, option);
+    size_t last = res.T.rows() - 1;
+    double mass = 0, mass0 = 0;
+    for(size_t i = 0; i < n; ++i) {
+      AssertLessThenEqual(std::abs(res.Y(last, i) - y0(0, i)), 1e-3);
+      mass += res.Y(last, i);
+      mass0 += y0(0, i);
+    }
+    AssertLessThenEqual(std::abs(mass - mass0), 1e-8);
+    return true;
+  }
+
+public:
+  void run() override {
+    TestHeatDirichlet();
+    TestJacobian();
+    TestNeumannReaction2D();
+    TestPeriodicAdvection();
+  }
+};
+
+int main() {
+  MethodOfLinesTestCase().run();
+  return 0;
+}